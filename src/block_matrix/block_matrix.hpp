@@ -1,7 +1,24 @@
 #pragma once
 
 #include "../matrix/matrix.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "../parallel/task_graph.hpp"
+#include "../parallel/task_pool.hpp"
+#include "tile_arena.hpp"
+#include "tile_autotuner.hpp"
+#include "tile_factorization.hpp"
+#include "tile_formats.hpp"
+#include "tile_kernel.hpp"
+#include "tile_strassen.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #define MIN_COUNT_BLOCK 2
 
@@ -11,12 +28,57 @@
 
 namespace matrix_lib {
 
+/**
+ * @brief Вид блока блочной матрицы.
+ */
+enum class TileKind : unsigned char {
+    Zero,      ///< Нулевой блок (память не выделена).
+    Identity,  ///< Единичный блок (память не выделена).
+    Dense,     ///< Плотный блок в TileArena.
+    Sparse,    ///< Разреженный блок в формате CSR.
+    LowRank,   ///< Малоранговый блок U * V^T.
+    Shared     ///< Плотный блок в TileArena другой матрицы (копируется при первой записи).
+};
+
+/**
+ * @brief Порядок хранения блоков блочной матрицы.
+ */
+enum class TileLayout : unsigned char {
+    RowMajor,  ///< Блоки по строкам сетки.
+    Morton     ///< Блоки в порядке Z-кривой: каждый квадрант сетки занимает непрерывный участок.
+};
+
 /**
  * @brief Класс для работы с блочными матрицами.
- * 
+ *
  * Класс `BlockMatrix` предназначен для представления и управления матрицами,
  * разбитыми на блоки, что позволяет эффективно выполнять операции над большими матрицами.
- * 
+ *
+ * Каждый блок (плитка) помечен видом TileKind. Нулевые и единичные блоки памяти не занимают,
+ * разреженные и малоранговые блоки хранятся в своих форматах (CSR и U * V^T), а плотные —
+ * в одной выровненной области TileArena: плитка — непрерывная панель
+ * getBlockRows() x getBlockCols() по строкам, начинающаяся на границе кэш-линии. Плитки на
+ * правом и нижнем краях дополнены нулями до полного размера, поэтому ядра над плитками
+ * работают с сырыми указателями без проверок границ. Операции пропускают нулевые блоки и
+ * упрощают действия с единичными, поэтому для блочно-разреженных матриц стоимость зависит
+ * от количества ненулевых блоков; умножение выбирает ядро по паре видов блоков.
+ *
+ * concat() и assembleBlockMatrix() не копируют плотные блоки: результат ссылается на
+ * плитки исходных матриц (вид Shared) через общее владение их TileArena. Копирование при
+ * записи выполняется поблочно в обе стороны: блок Shared копируется в собственную память
+ * при первой записи в него, а исходная матрица при первой записи отдает свою область
+ * ссылающимся на нее матрицам и сама ссылается на нее блоками Shared, поэтому копируются
+ * только изменяемые блоки. Область освобождается, когда все ссылающиеся на нее блоки
+ * перезаписаны или удалены.
+ *
+ * Без копирования с плоскими данными обмениваются только отдельные плитки: getBlockView()
+ * дает представление плитки арены, MatrixView::tile() — плитки Matrix, а setBlock()
+ * принимает представление. Вся матрица при переходе между Matrix и BlockMatrix копируется
+ * (конструктор из Matrix или MatrixView, toMatrix(), copyToView()) за один параллельный
+ * проход: плотные плитки лежат в слотах арены с шагом getBlockCols() и дополнены нулями,
+ * а блоки других видов хранятся в своих форматах, поэтому сетка не может ссылаться на
+ * плоский буфер.
+ *
  * @tparam MatrixType Тип данных, используемый для элементов матрицы.
  */
 template<typename MatrixType>
@@ -27,32 +89,281 @@ private:
     size_t cols_;                      ///< Общее количество столбцов в матрице.
     size_t blockRows_;                 ///< Количество строк в одном блоке.
     size_t blockCols_;                 ///< Количество столбцов в одном блоке.
-    std::unique_ptr<std::unique_ptr<Matrix<MatrixType>[]>[]> data_; ///< Указатель на блоки матриц.
+    size_t numBlocksRow_;              ///< Количество блоков по вертикали.
+    size_t numBlocksCol_;              ///< Количество блоков по горизонтали.
+    std::shared_ptr<TileArena<MatrixType>> arena_;  ///< Непрерывная память плотных блоков.
+    std::vector<TileKind> kinds_;      ///< Вид каждого блока.
+    std::vector<size_t> slots_;        ///< Номер плитки arena_ для плотных блоков.
+    std::vector<size_t> freeSlots_;    ///< Освобожденные (обнуленные) плитки arena().
+    size_t usedSlots_;                 ///< Количество выданных плиток arena().
+    std::unordered_map<size_t, CompressedRows<MatrixType>> sparseTiles_;  ///< Разреженные блоки по номеру.
+    std::unordered_map<size_t, LowRankTile<MatrixType>> lowRankTiles_;    ///< Малоранговые блоки по номеру.
+    std::unordered_map<size_t, SharedTile<MatrixType>> sharedTiles_;      ///< Блоки в памяти других матриц по номеру.
+    TileLayout layout_ = TileLayout::RowMajor;  ///< Порядок блоков.
+    std::vector<size_t> mortonIndex_;           ///< Номер блока по позиции i * getNumBlocksCol() + j (для Morton).
+    std::vector<size_t> mortonPosition_;        ///< Позиция блока по его номеру (для Morton).
 
     /**
      * @brief Инициализация памяти для хранения блоков матрицы.
-     * 
-     * Метод выделяет необходимую память для хранения блоков матрицы, 
-     * устанавливая размерность блоков в соответствии с заданными параметрами.
+     *
+     * Метод вычисляет сетку блоков; все блоки нулевые, память под плитки не выделяется.
+     *
+     * @throw std::invalid_argument Если размер блока равен нулю.
      */
     void initMemory();
 
     /**
      * @brief Освобождение памяти, занятой блоками матрицы.
-     * 
-     * Метод освобождает память, ранее выделенную для хранения блоков матрицы, 
+     *
+     * Метод освобождает память, ранее выделенную для хранения блоков матрицы,
      * предотвращая утечки памяти.
      */
     void freeMemory();
 
     /**
-     * @brief Копирование данных из другой блочной матрицы.
-     * @param other Блочная матрица для копирования.
-     * 
-     * Метод копирует данные из указанной блочной матрицы в текущую матрицу,
-     * сохраняя размеры и элементы.
+     * @brief Область плотных блоков для чтения.
+     * @return Область (пустая у перемещенной матрицы).
+     */
+    const TileArena<MatrixType>& arena() const noexcept;
+
+    /**
+     * @brief Область плотных блоков для записи.
+     *
+     * Если на область ссылаются блоки других матриц, матрица сначала отделяется от нее
+     * (unshareArena()), поэтому вызов должен предшествовать чтению видов и слотов блоков.
+     * Первый вызов в изменяющем методе выполняется до запуска параллельных задач.
+     *
+     * @return Собственная область матрицы.
+     */
+    TileArena<MatrixType>& arena();
+
+    /**
+     * @brief Отделиться от области, на которую ссылаются блоки других матриц.
+     *
+     * Данные не копируются: матрица получает новую пустую область, а ее плотные блоки
+     * становятся блоками вида Shared в прежней области. Каждый блок копируется отдельно при
+     * первой записи в него (materializeTile()), а прежняя область освобождается, когда на нее
+     * не остается ссылок ни у одной матрицы.
+     */
+    void unshareArena();
+
+    /**
+     * @brief Номер блока в области памяти.
+     *
+     * Все массивы блоков (виды, плитки, форматы) индексируются этим номером; при размещении
+     * Morton он равен месту блока на Z-кривой сетки.
+     *
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Номер плитки в TileArena.
+     */
+    size_t tileIndex(const size_t blockRow, const size_t blockCol) const noexcept;
+
+    /**
+     * @brief Позиция блока в сетке по его номеру (обратное к tileIndex()).
+     * @param index Номер блока.
+     * @return blockRow * getNumBlocksCol() + blockCol.
+     */
+    size_t tilePosition(size_t index) const noexcept;
+
+    /**
+     * @brief Ключ Z-кривой: биты blockCol и blockRow чередуются, начиная с младшего бита столбца.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Ключ.
+     */
+    static uint64_t mortonCode(size_t blockRow, size_t blockCol) noexcept;
+
+    /**
+     * @brief Построить таблицы номеров блоков для текущих сетки и порядка.
+     *
+     * Сетка не обязана быть квадратной степени двойки: блоки нумеруются подряд в порядке
+     * возрастания ключа mortonCode(), поэтому номера плотные, а квадранты остаются непрерывными.
+     */
+    void buildLayout();
+
+    /**
+     * @brief Количество заполненных строк блока (меньше getBlockRows() на нижнем краю).
+     * @param blockRow Индекс строки блока.
+     * @return Количество строк.
+     */
+    size_t validRows(const size_t blockRow) const noexcept;
+
+    /**
+     * @brief Количество заполненных столбцов блока (меньше getBlockCols() на правом краю).
+     * @param blockCol Индекс столбца блока.
+     * @return Количество столбцов.
+     */
+    size_t validCols(const size_t blockCol) const noexcept;
+
+    /**
+     * @brief Совпадают ли размеры матриц и сетки блоков.
+     * @param other Другая блочная матрица.
+     * @return true, если плитки двух матриц соответствуют друг другу.
+     */
+    bool sameLayout(const BlockMatrix& other) const noexcept;
+
+    /**
+     * @brief Копия другой матрицы с разбиением и порядком блоков этой матрицы.
+     * @param other Матрица тех же размеров.
+     * @return Копия.
+     */
+    BlockMatrix conformed(const BlockMatrix& other) const;
+
+    /**
+     * @brief Порядок единичного блока (размер его заполненной квадратной части).
+     * @param index Номер блока.
+     * @return Количество строк заполненной части блока.
+     */
+    size_t identitySize(size_t index) const noexcept;
+
+    /**
+     * @brief Выдать обнуленную плитку arena_ (при нехватке область удваивается).
+     * @return Номер плитки.
+     */
+    size_t acquireSlot();
+
+    /**
+     * @brief Сделать блок нулевым и вернуть его плитку в список свободных.
+     * @param index Номер блока.
+     */
+    void releaseTile(size_t index);
+
+    /**
+     * @brief dst += factor * (содержимое блока) для блока любого вида.
+     * @param index Номер блока.
+     * @param factor Множитель.
+     * @param dst Плитка getBlockRows() x getBlockCols() (по строкам, шаг ld).
+     * @param ld Шаг строк dst.
+     */
+    void expandTile(size_t index, MatrixType factor, MatrixType* dst, size_t ld) const;
+
+    /**
+     * @brief Обойти ненулевые элементы строки блока вида Dense, Sparse или Identity.
+     * @tparam Visit Тип вызываемого объекта `void(size_t col, MatrixType value)`.
+     * @param index Номер блока.
+     * @param row Строка внутри блока.
+     * @param width Количество заполненных столбцов блока.
+     * @param visit Обработчик элемента.
+     */
+    template <typename Visit>
+    void forEachRowEntry(size_t index, size_t row, size_t width, Visit visit) const;
+
+    /**
+     * @brief Произведение блоков в малоранговом виде (хотя бы один множитель малоранговый).
+     * @param a Левая матрица.
+     * @param left Номер блока в a.
+     * @param b Правая матрица.
+     * @param right Номер блока в b.
+     * @param height Количество заполненных строк блока a.
+     * @param depth Количество заполненных столбцов блока a (строк блока b).
+     * @param width Количество заполненных столбцов блока b.
+     * @return Произведение U * W^T ранга малорангового множителя.
      */
-    void copy(const BlockMatrix& other) noexcept;
+    static LowRankTile<MatrixType> multiplyLowRankTile(const BlockMatrix& a, size_t left, const BlockMatrix& b, size_t right,
+                                                       size_t height, size_t depth, size_t width);
+
+    /**
+     * @brief y += factor * (блок) * x для блока любого вида.
+     * @param index Номер блока.
+     * @param factor Множитель.
+     * @param x Часть вектора длины width.
+     * @param y Часть результата длины height.
+     * @param height Количество заполненных строк блока.
+     * @param width Количество заполненных столбцов блока.
+     */
+    void multiplyAddVectorTile(size_t index, MatrixType factor, const MatrixType* x, MatrixType* y,
+                               size_t height, size_t width) const;
+
+    /**
+     * @brief C += A_left * B_right для блоков любых видов.
+     *
+     * Плотная пара умножается упакованным микроядром, разреженные и единичные блоки обходятся
+     * по ненулевым элементам, малоранговый множитель сначала сворачивается с другим блоком
+     * до матрицы ширины rank, после чего результат добавляется как U * W^T.
+     *
+     * @param a Левая матрица.
+     * @param left Номер блока в a.
+     * @param b Правая матрица.
+     * @param right Номер блока в b.
+     * @param height Количество заполненных строк блока a.
+     * @param depth Количество заполненных столбцов блока a (строк блока b).
+     * @param width Количество заполненных столбцов блока b.
+     * @param c Плитка результата.
+     * @param scratch Рабочий буфер задачи.
+     */
+    void multiplyAddTile(const BlockMatrix& a, size_t left, const BlockMatrix& b, size_t right,
+                         size_t height, size_t depth, size_t width, MatrixType* c, std::vector<MatrixType>& scratch) const;
+
+    /**
+     * @brief Сделать блок плотным (единичный блок заполняется диагональю).
+     *
+     * Может перераспределить arena_: ранее полученные указатели на плитки становятся недействительными.
+     *
+     * @param index Номер блока.
+     * @return Указатель на плитку.
+     */
+    MatrixType* materializeTile(size_t index);
+
+    /**
+     * @brief Плитка плотного блока (своего или общего с другой матрицей).
+     * @param index Номер блока.
+     * @return Указатель на плитку или nullptr для блоков остальных видов.
+     */
+    const MatrixType* tileData(size_t index) const noexcept;
+
+    /**
+     * @brief Элемент блока с учетом его вида.
+     * @param index Номер блока.
+     * @param row Строка внутри блока.
+     * @param col Столбец внутри блока.
+     * @return Значение элемента.
+     */
+    MatrixType elementAt(size_t index, size_t row, size_t col) const noexcept;
+
+    /**
+     * @brief Определить вид области по ее элементам.
+     * @tparam Value Тип вызываемого объекта `MatrixType(size_t row, size_t col)`.
+     * @param height Количество строк области.
+     * @param width Количество столбцов области.
+     * @param value Доступ к элементам области.
+     * @return Zero, Identity (только для квадратной области) или Dense.
+     */
+    template <typename Value>
+    static TileKind classifyRegion(size_t height, size_t width, Value value);
+
+    /**
+     * @brief Экстремальный элемент заполненной части блока.
+     * @tparam Better Тип сравнения `bool(MatrixType candidate, MatrixType best)`.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @param better Сравнение.
+     * @return Лучший элемент блока.
+     */
+    template <typename Better>
+    MatrixType tileExtreme(size_t blockRow, size_t blockCol, Better better) const noexcept;
+
+    /**
+     * @brief this += factor * other для матриц с одинаковым разбиением.
+     * @param other Другая блочная матрица.
+     * @param factor Множитель (1 или -1).
+     */
+    void addScaledBlockMatrix(const BlockMatrix& other, MatrixType factor);
+
+    /**
+     * @brief Размер плитки, подобранный TileAutotuner для умножения, с ограничением по размеру матрицы.
+     * @param rows Количество строк матрицы.
+     * @param cols Количество столбцов матрицы.
+     * @return Размер плитки (не меньше 1 x 1).
+     */
+    static TileShape tunedShape(size_t rows, size_t cols);
+
+    /**
+     * @brief Разбиение обычной матрицы на блоки заданного размера.
+     * @param matrix Исходная матрица.
+     * @param shape Размер блока.
+     */
+    BlockMatrix(const Matrix<MatrixType>& matrix, TileShape shape);
 
 public:
     /**
@@ -80,17 +391,174 @@ public:
     inline size_t getBlockCols() const noexcept { return blockCols_; }
 
     /**
-     * @brief Получение указанного блока матрицы.
+     * @brief Возвращает количество блоков по вертикали.
+     * @return Количество строк сетки блоков.
+     */
+    inline size_t getNumBlocksRow() const noexcept { return numBlocksRow_; }
+
+    /**
+     * @brief Возвращает количество блоков по горизонтали.
+     * @return Количество столбцов сетки блоков.
+     */
+    inline size_t getNumBlocksCol() const noexcept { return numBlocksCol_; }
+
+    /**
+     * @brief Получение копии указанного блока матрицы.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Матрица с содержимым блока (без дополнения нулями на краях).
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    Matrix<MatrixType> getBlock(const size_t blockRow, const size_t blockCol) const;
+
+    /**
+     * @brief Запись содержимого блока (нулевой и единичный блок сохраняются без памяти).
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @param block Матрица размера блока (на краях — размера заполненной части).
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если размер матрицы не совпадает с размером блока.
+     */
+    void setBlock(const size_t blockRow, const size_t blockCol, const Matrix<MatrixType>& block);
+
+    /**
+     * @brief Запись содержимого блока из области чужого буфера без промежуточной матрицы.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @param block Представление размера блока (на краях — размера заполненной части).
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если размер представления не совпадает с размером блока.
+     */
+    void setBlock(const size_t blockRow, const size_t blockCol, const MatrixView<const MatrixType>& block);
+
+    /**
+     * @brief Сырой указатель на панель блока.
+     *
+     * Панель хранится по строкам с шагом getBlockCols() и выровнена по кэш-линии. Нулевой или
+     * единичный блок при этом становится плотным; выделение памяти может переместить другие
+     * плитки, поэтому ранее полученные указатели становятся недействительными.
+     *
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Указатель на первый элемент блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    MatrixType* getBlockData(const size_t blockRow, const size_t blockCol);
+
+    /**
+     * @brief Сырой указатель на панель плотного блока.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Указатель на первый элемент блока или nullptr, если блок нулевой или единичный.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    const MatrixType* getBlockData(const size_t blockRow, const size_t blockCol) const;
+
+    /**
+     * @brief Представление блока поверх памяти арены без копирования.
+     *
+     * Блок становится плотным, как в getBlockData(); запись через представление изменяет
+     * матрицу. Представление имеет размер заполненной части блока и шаг getBlockCols() и
+     * действительно до следующего выделения или освобождения плиток.
+     *
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Изменяемое представление блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    MatrixView<MatrixType> getBlockView(const size_t blockRow, const size_t blockCol);
+
+    /**
+     * @brief Представление плотного блока поверх памяти арены без копирования.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Представление только для чтения.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если блок хранится не плотно.
+     */
+    MatrixView<const MatrixType> getBlockView(const size_t blockRow, const size_t blockCol) const;
+
+    /**
+     * @brief Вид блока.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Вид блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    TileKind getTileKind(const size_t blockRow, const size_t blockCol) const;
+
+    /**
+     * @brief Количество плотных блоков (блоков, занимающих память).
+     * @return Количество плотных блоков.
+     */
+    size_t getDenseTileCount() const noexcept { return usedSlots_ - freeSlots_.size(); }
+
+    /**
+     * @brief Сделать блок нулевым и освободить его память.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    void clearBlock(const size_t blockRow, const size_t blockCol);
+
+    /**
+     * @brief Пометить плотные блоки, ставшие нулевыми или единичными, и освободить их память.
+     *
+     * Арифметика не проверяет результат на нули, поэтому после вычислений, обнуляющих блоки,
+     * этот метод возвращает матрице блочно-разреженное представление. Плотные блоки с долей
+     * ненулевых элементов не больше TILE_SPARSE_MAX_FILL переводятся в разреженный формат.
+     */
+    void compressBlockMatrix();
+
+    /**
+     * @brief Записать блок в разреженном формате.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @param block Разреженная матрица размера заполненной части блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если размер матрицы не совпадает с размером блока.
+     */
+    void setSparseBlock(const size_t blockRow, const size_t blockCol, const SparseMatrix<MatrixType>& block);
+
+    /**
+     * @brief Записать блок в малоранговом виде U * V^T.
      * @param blockRow Индекс строки блока.
      * @param blockCol Индекс столбца блока.
-     * @return Ссылка на матрицу, представляющую указанный блок.
+     * @param u Множитель U (строки блока x ранг).
+     * @param v Множитель V (столбцы блока x ранг).
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если размеры множителей не согласованы с блоком.
+     */
+    void setLowRankBlock(const size_t blockRow, const size_t blockCol, const Matrix<MatrixType>& u, const Matrix<MatrixType>& v);
+
+    /**
+     * @brief Количество хранимых элементов (плотные блоки, ненулевые разреженных блоков и множители малоранговых).
+     * @return Количество элементов.
+     */
+    size_t getStoredElementCount() const noexcept;
+
+    /**
+     * @brief Получение элемента по глобальному индексу.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return Значение элемента.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
      */
-    Matrix<MatrixType>& getBlock(const size_t blockRow, const size_t blockCol) const;
+    MatrixType getValue(const size_t row, const size_t col) const;
+
+    /**
+     * @brief Запись элемента по глобальному индексу.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @param value Новое значение.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    void setValue(const size_t row, const size_t col, const MatrixType value);
 
     /**
      * @brief Конструктор по умолчанию.
-     * 
-     * Создает пустую блочную матрицу с нулевыми размерами.
+     *
+     * Создает блочную матрицу MIN_SIZE_MATRIX x MIN_SIZE_MATRIX с блоками MIN_COUNT_BLOCK x MIN_COUNT_BLOCK.
      */
     BlockMatrix();
 
@@ -98,9 +566,15 @@ public:
      * @brief Конструктор для создания блочной матрицы с заданным количеством строк и столбцов.
      * @param rows Количество строк.
      * @param cols Количество столбцов.
-     * 
-     * Создает блочную матрицу с указанным количеством строк и столбцов, 
-     * устанавливая размеры блоков по умолчанию.
+     *
+     * Создает блочную матрицу с указанным количеством строк и столбцов. Размер блоков
+     * выбирается TileAutotuner и может быть прямоугольным.
+     *
+     * Побочный эффект: если в профиле нет записи для MatrixType, первый такой вызов в процессе
+     * замеряет кандидатов (доли секунды, около 0.7 с в сборке без оптимизации) и записывает файл
+     * профиля — по умолчанию TILE_PROFILE_DEFAULT_PATH в текущем каталоге, иначе путь из
+     * TILE_PROFILE_ENV или TileAutotuner::setProfilePath(). Чтобы избежать замера, задайте
+     * размер через TileAutotuner::setTileShape() или используйте конструктор с размером блока.
      */
     BlockMatrix(size_t rows, size_t cols);
 
@@ -110,8 +584,10 @@ public:
      * @param cols Количество столбцов.
      * @param blockRows Количество строк в блоке.
      * @param blockCols Количество столбцов в блоке.
-     * 
+     *
      * Создает блочную матрицу с указанным количеством строк, столбцов и размерами блоков.
+     *
+     * @throw std::invalid_argument Если размер блока равен нулю.
      */
     BlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols);
 
@@ -119,32 +595,85 @@ public:
      * @brief Конструктор для создания блочной матрицы на основе существующей матрицы.
      * @param rows Количество строк.
      * @param cols Количество столбцов.
-     * @param matrix Исходная матрица для инициализации блочной матрицы.
-     * 
-     * Создает блочную матрицу, используя данные из заданной матрицы.
+     * @param matrix Матрица-образец: задает размер блока и копируется в каждый блок.
+     *
+     * Создает блочную матрицу, каждый блок которой равен заданной матрице (на краях — ее левая верхняя часть).
      */
     BlockMatrix(size_t rows, size_t cols, const Matrix<MatrixType>& matrix);
 
+    /**
+     * @brief Конструктор разбиения обычной матрицы на блоки.
+     * @param matrix Исходная матрица.
+     * @param blockRows Количество строк в блоке.
+     * @param blockCols Количество столбцов в блоке.
+     * @throw std::invalid_argument Если размер блока равен нулю.
+     */
+    BlockMatrix(const Matrix<MatrixType>& matrix, size_t blockRows, size_t blockCols);
+
+    /**
+     * @brief Конструктор разбиения области чужого буфера на блоки.
+     *
+     * Все элементы копируются в плитки арены (построчно, за один параллельный проход, без
+     * промежуточной матрицы); так можно разбить на блоки подматрицу Matrix::view().subView().
+     *
+     * @param view Исходная область.
+     * @param blockRows Количество строк в блоке.
+     * @param blockCols Количество столбцов в блоке.
+     * @throw std::invalid_argument Если размер блока равен нулю.
+     */
+    BlockMatrix(const MatrixView<const MatrixType>& view, size_t blockRows, size_t blockCols);
+
+    /**
+     * @brief Конструктор иерархически сжатой матрицы по функции элементов.
+     *
+     * Допустимые блоки (отстоящие от диагонали сетки хотя бы на admissibleDistance блоков)
+     * приближаются крестовой аппроксимацией approximateCrossTile() с относительной точностью
+     * tolerance и хранятся в виде U * V^T; остальные блоки, а также блоки, для которых ранг
+     * не дает выигрыша по памяти, вычисляются плотными. Матрица целиком не строится, поэтому
+     * для ядер с малоранговыми внедиагональными блоками (BEM, гауссовские процессы) память и
+     * количество вызовов entry растут почти линейно. Блоки обрабатываются параллельно.
+     *
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param blockRows Количество строк в блоке.
+     * @param blockCols Количество столбцов в блоке.
+     * @param entry Элемент (row, col); вызывается из нескольких потоков.
+     * @param tolerance Относительная точность приближения блоков.
+     * @param admissibleDistance Наименьшее расстояние |i - j| между индексами допустимого блока.
+     * @throw std::invalid_argument Если размер блока равен нулю или точность отрицательна.
+     */
+    BlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols,
+                const std::function<MatrixType(size_t, size_t)>& entry, double tolerance, size_t admissibleDistance = 1);
+
+    /**
+     * @brief Конструктор разбиения обычной матрицы на блоки размера, выбранного TileAutotuner.
+     * @param matrix Исходная матрица.
+     *
+     * Как и BlockMatrix(size_t, size_t), при первом вызове без записи в профиле замеряет
+     * кандидатов и записывает файл профиля.
+     */
+    explicit BlockMatrix(const Matrix<MatrixType>& matrix);
+
     /**
      * @brief Конструктор копирования.
      * @param other Другая блочная матрица для копирования.
-     * 
-     * Создает новую блочную матрицу, копируя данные из указанной матрицы.
+     *
+     * Создает новую блочную матрицу, копируя всю область блоков одним memcpy.
      */
     BlockMatrix(const BlockMatrix& other);
 
     /**
      * @brief Конструктор перемещения.
      * @param other Другая блочная матрица для перемещения.
-     * 
+     *
      * Перемещает данные из указанной матрицы в новую блочную матрицу.
      */
     BlockMatrix(BlockMatrix&& other) noexcept;
 
     /**
      * @brief Деструктор класса BlockMatrix.
-     * 
-     * Освобождает память, выделенную под блочную матрицу, 
+     *
+     * Освобождает память, выделенную под блочную матрицу,
      * гарантируя корректное удаление всех данных.
      */
     ~BlockMatrix() noexcept = default;
@@ -153,7 +682,7 @@ public:
      * @brief Оператор присваивания.
      * @param other Другая блочная матрица для присваивания.
      * @return Ссылка на текущий объект.
-     * 
+     *
      * Присваивает значения другой блочной матрицы текущему объекту,
      * освобождая предыдущие данные при необходимости.
      */
@@ -163,7 +692,7 @@ public:
      * @brief Оператор перемещения.
      * @param other Другая блочная матрица для перемещения.
      * @return Ссылка на текущий объект.
-     * 
+     *
      * Перемещает данные из указанной блочной матрицы в текущий объект,
      * освобождая память, занимаемую старым объектом.
      */
@@ -174,16 +703,36 @@ public:
      * @param blockRow Индекс строки блока.
      * @param blockCol Индекс столбца блока.
      * @return Блок матрицы по заданным индексам.
-     * 
+     *
      * Возвращает блок матрицы, соответствующий заданным индексам.
      */
     Matrix<MatrixType> operator()(const size_t blockRow, const size_t blockCol) const;
 
+    /**
+     * @brief Преобразование в обычную матрицу.
+     *
+     * Копирует все элементы в новую Matrix (см. copyToView()).
+     *
+     * @return Матрица getRowsBlockMatrix() x getColsBlockMatrix().
+     */
+    Matrix<MatrixType> toMatrix() const;
+
+    /**
+     * @brief Запись матрицы в область существующего буфера.
+     *
+     * В отличие от toMatrix() не выделяет память, но копирует все элементы: результат можно
+     * записать прямо в подматрицу другой Matrix через Matrix::view().subView().
+     *
+     * @param target Область getRowsBlockMatrix() x getColsBlockMatrix().
+     * @throw std::invalid_argument Если размер области не совпадает с размером матрицы.
+     */
+    void copyToView(const MatrixView<MatrixType>& target) const;
+
     /**
      * @brief Оператор сложения блочных матриц.
      * @param other Другая блочная матрица для сложения.
      * @return Результирующая блочная матрица, полученная в результате сложения.
-     * 
+     *
      * Складывает текущую блочную матрицу с указанной и возвращает новую блочную матрицу.
      */
     BlockMatrix operator+(const BlockMatrix& other) const;
@@ -192,7 +741,7 @@ public:
      * @brief Оператор вычитания блочных матриц.
      * @param other Другая блочная матрица для вычитания.
      * @return Результирующая блочная матрица, полученная в результате вычитания.
-     * 
+     *
      * Вычитает указанную блочную матрицу из текущей и возвращает новую блочную матрицу.
      */
     BlockMatrix operator-(const BlockMatrix& other) const;
@@ -201,16 +750,64 @@ public:
      * @brief Оператор умножения блочных матриц.
      * @param other Другая блочная матрица для умножения.
      * @return Результирующая блочная матрица, полученная в результате умножения.
-     * 
+     *
      * Умножает текущую блочную матрицу на указанную и возвращает новую блочную матрицу.
+     * Если количество строк блока правого множителя не равно количеству столбцов блока левого
+     * (например, у матриц с прямоугольными блоками по умолчанию), правый множитель
+     * копируется в блоки getBlockCols() x other.getBlockCols().
      */
     BlockMatrix operator*(const BlockMatrix& other) const;
 
+    /**
+     * @brief Накопление произведения: this += a * b.
+     *
+     * Для каждой плитки результата ставится отдельная задача в sharedTaskPool(); задача
+     * выполняет C_ij += A_ik * B_kj по всем k прямо в памяти плитки C, упаковывая A_ik
+     * для микроядра, без промежуточных матриц.
+     *
+     * @param a Левый множитель.
+     * @param b Правый множитель.
+     * @throw std::invalid_argument Если размеры или разбиения на блоки несовместимы.
+     */
+    void multiplyAddBlockMatrix(const BlockMatrix& a, const BlockMatrix& b);
+
+    /**
+     * @brief Накопление произведения с транспонированными множителями: this += op(a) * op(b).
+     *
+     * op(x) = x^T, если установлен соответствующий флаг. Множитель целиком не транспонируется:
+     * задача читает плитку (k, i) вместо (i, k) и транспонирует ее в свой буфер перед
+     * упаковкой, поэтому A^T участвует в умножении без перемещения данных матрицы.
+     *
+     * @param a Левый множитель.
+     * @param b Правый множитель.
+     * @param transposeA Использовать a^T.
+     * @param transposeB Использовать b^T.
+     * @throw std::invalid_argument Если размеры или разбиения на блоки op(a) и op(b) несовместимы.
+     */
+    void multiplyAddBlockMatrix(const BlockMatrix& a, const BlockMatrix& b, bool transposeA, bool transposeB = false);
+
+    /**
+     * @brief Произведение по Штрассену — Винограду на уровне сетки плиток: this * other.
+     *
+     * Сетки плиток дополняются нулевыми плитками до квадратной стороны leaf * 2^L, где leaf
+     * не больше crossover, и на каждом из L уровней выполняется 7 умножений подсеток вместо 8;
+     * сетки стороны leaf умножаются обычным плиточным алгоритмом. Семь произведений верхнего
+     * уровня считаются параллельно, рабочая память нижних уровней выделяется один раз на
+     * задачу. Если сетка не больше crossover плиток, вызывается operator*. Результат отличается
+     * от operator* ошибками округления: алгоритм менее устойчив, чем классическое умножение.
+     *
+     * @param other Правый множитель.
+     * @param crossover Наибольшая сторона сетки, умножаемой обычным алгоритмом.
+     * @return Произведение.
+     * @throw std::invalid_argument Если размеры или разбиения несовместимы либо crossover равен нулю.
+     */
+    BlockMatrix multiplyStrassenBlockMatrix(const BlockMatrix& other, size_t crossover = STRASSEN_CROSSOVER_BLOCKS) const;
+
     /**
      * @brief Оператор умножения блочной матрицы на скаляр.
      * @param scalar Скалярное значение для умножения.
      * @return Результирующая блочная матрица, полученная в результате умножения.
-     * 
+     *
      * Умножает текущую блочную матрицу на указанное скалярное значение и возвращает новую блочную матрицу.
      */
     BlockMatrix operator*(const MatrixType& scalar) const;
@@ -219,7 +816,7 @@ public:
      * @brief Оператор сложения с присваиванием.
      * @param other Другая блочная матрица для сложения.
      * @return Ссылка на текущий объект.
-     * 
+     *
      * Складывает указанную блочную матрицу с текущей и обновляет текущий объект.
      */
     BlockMatrix& operator+=(const BlockMatrix& other);
@@ -228,7 +825,7 @@ public:
      * @brief Оператор вычитания с присваиванием.
      * @param other Другая блочная матрица для вычитания.
      * @return Ссылка на текущий объект.
-     * 
+     *
      * Вычитает указанную блочную матрицу из текущей и обновляет текущий объект.
      */
     BlockMatrix& operator-=(const BlockMatrix& other);
@@ -237,7 +834,7 @@ public:
      * @brief Оператор умножения с присваиванием.
      * @param other Другая блочная матрица для умножения.
      * @return Ссылка на текущий объект.
-     * 
+     *
      * Умножает текущую блочную матрицу на указанную и обновляет текущий объект.
      */
     BlockMatrix& operator*=(const BlockMatrix& other);
@@ -246,7 +843,7 @@ public:
      * @brief Оператор умножения с присваиванием на скаляр.
      * @param scalar Скалярное значение для умножения.
      * @return Ссылка на текущий объект.
-     * 
+     *
      * Умножает текущую блочную матрицу на указанное скалярное значение и обновляет текущий объект.
      */
     BlockMatrix& operator*=(const MatrixType& scalar);
@@ -255,7 +852,7 @@ public:
      * @brief Оператор сравнения блочных матриц на равенство.
      * @param other Другая блочная матрица для сравнения.
      * @return true, если матрицы равны, иначе false.
-     * 
+     *
      * Сравнивает текущую блочную матрицу с указанной на предмет равенства.
      */
     bool operator==(const BlockMatrix& other) const;
@@ -264,15 +861,15 @@ public:
      * @brief Оператор сравнения блочных матриц на неравенство.
      * @param other Другая блочная матрица для сравнения.
      * @return true, если матрицы не равны, иначе false.
-     * 
+     *
      * Сравнивает текущую блочную матрицу с указанной на предмет неравенства.
      */
     bool operator!=(const BlockMatrix& other) const;
 
     /**
      * @brief Печать блочной матрицы в стандартный поток.
-     * 
-     * Выводит содержимое блочной матрицы на экран, форматируя данные 
+     *
+     * Выводит содержимое блочной матрицы на экран, форматируя данные
      * для удобного восприятия.
      */
     void printBlockMatrix() const;
@@ -280,7 +877,7 @@ public:
     /**
      * @brief Сложение с другой блочной матрицей.
      * @param other Блочная матрица для сложения.
-     * 
+     *
      * Метод выполняет сложение текущей блочной матрицы с указанной.
      */
     void sumBlockMatrix(const BlockMatrix& other);
@@ -288,7 +885,7 @@ public:
     /**
      * @brief Вычитание другой блочной матрицы.
      * @param other Блочная матрица для вычитания.
-     * 
+     *
      * Метод выполняет вычитание указанной блочной матрицы из текущей.
      */
     void subBlockMatrix(const BlockMatrix& other);
@@ -296,7 +893,7 @@ public:
     /**
      * @brief Умножение на другую блочную матрицу.
      * @param other Блочная матрица для умножения.
-     * 
+     *
      * Метод выполняет умножение текущей блочной матрицы на указанную.
      */
     void mulBlockMatrix(const BlockMatrix& other);
@@ -304,8 +901,8 @@ public:
     /**
      * @brief Умножение на скаляр.
      * @param scalar Скалярное значение для умножения.
-     * 
-     * Метод выполняет умножение текущей блочной матрицы на заданное 
+     *
+     * Метод выполняет умножение текущей блочной матрицы на заданное
      * скалярное значение.
      */
     void mulBlockScalar(const MatrixType& scalar);
@@ -315,7 +912,7 @@ public:
      * @param mat1 Первая блочная матрица.
      * @param mat2 Вторая блочная матрица.
      * @return Результирующая блочная матрица, полученная в результате сложения.
-     * 
+     *
      * Метод выполняет сложение двух указанных блочных матриц.
      */
     BlockMatrix sumBlockMatrix(const BlockMatrix& mat1, const BlockMatrix& mat2) const;
@@ -325,7 +922,7 @@ public:
      * @param mat1 Первая блочная матрица.
      * @param mat2 Вторая блочная матрица.
      * @return Результирующая блочная матрица, полученная в результате вычитания.
-     * 
+     *
      * Метод выполняет вычитание второй блочной матрицы из первой.
      */
     BlockMatrix subBlockMatrix(const BlockMatrix& mat1, const BlockMatrix& mat2) const;
@@ -335,7 +932,7 @@ public:
      * @param mat1 Первая блочная матрица.
      * @param mat2 Вторая блочная матрица.
      * @return Результирующая блочная матрица, полученная в результате умножения.
-     * 
+     *
      * Метод выполняет умножение двух указанных блочных матриц.
      */
     BlockMatrix mulBlockMatrix(const BlockMatrix& mat1, const BlockMatrix& mat2) const;
@@ -345,23 +942,36 @@ public:
      * @param mat Блочная матрица для умножения.
      * @param scalar Скалярное значение для умножения.
      * @return Результирующая блочная матрица, полученная в результате умножения.
-     * 
-     * Метод выполняет умножение указанной блочной матрицы на заданное 
+     *
+     * Метод выполняет умножение указанной блочной матрицы на заданное
      * скалярное значение.
      */
     BlockMatrix mulBlockScalar(const BlockMatrix& mat, const MatrixType& scalar) const;
 
     /**
-     * @brief Транспонирование блочной матрицы.
-     * 
-     * Метод выполняет транспонирование текущей блочной матрицы.
+     * @brief Транспонирование блочной матрицы на месте.
+     *
+     * Плитка (i, j) становится плиткой (j, i) сетки getNumBlocksCol() x getNumBlocksRow() с
+     * блоками getBlockCols() x getBlockRows(): переставляются только описатели плиток, а
+     * содержимое каждой плотной плитки транспонируется в своей же памяти (квадратная плитка —
+     * без буфера) параллельно по плиткам. Форма матрицы и блоков может быть любой.
      */
     void transposeBlockMatrix();
 
+    /**
+     * @brief Транспонированная копия блочной матрицы.
+     *
+     * Каждая плотная плитка за один проход переносится из исходной памяти в память
+     * результата ядром transposeTile(); плитки обрабатываются параллельно.
+     *
+     * @return Матрица getColsBlockMatrix() x getRowsBlockMatrix() с блоками getBlockCols() x getBlockRows().
+     */
+    BlockMatrix transposedBlockMatrix() const;
+
     /**
      * @brief Проверка на симметричность блочной матрицы.
      * @return true, если матрица симметрична, иначе false.
-     * 
+     *
      * Метод проверяет, является ли текущая блочная матрица симметричной.
      */
     bool isSymmetric() const;
@@ -369,7 +979,7 @@ public:
     /**
      * @brief Проверка, является ли блочная матрица квадратной.
      * @return true, если матрица квадратная, иначе false.
-     * 
+     *
      * Метод проверяет, является ли текущая блочная матрица квадратной.
      */
     bool isSquareBlockMatrix() const;
@@ -377,7 +987,7 @@ public:
     /**
      * @brief Вычисление нормы Фробениуса блочной матрицы.
      * @return Значение нормы Фробениуса.
-     * 
+     *
      * Метод вычисляет норму Фробениуса текущей блочной матрицы.
      */
     double frobeniusNorm() const;
@@ -385,7 +995,7 @@ public:
     /**
      * @brief Получение количества блоков в блочной матрице.
      * @return Количество блоков.
-     * 
+     *
      * Метод возвращает количество блоков в текущей блочной матрице.
      */
     size_t getBlockCount() const;
@@ -395,17 +1005,56 @@ public:
      * @param other Другая блочная матрица для конкатенации.
      * @param horizontal Если true, конкатенирует горизонтально, иначе вертикально.
      * @return Результирующая блочная матрица после конкатенации.
-     * 
-     * Метод выполняет конкатенацию текущей блочной матрицы с указанной 
+     *
+     * Метод выполняет конкатенацию текущей блочной матрицы с указанной
      * матрицей в зависимости от значения параметра horizontal.
      */
     BlockMatrix concat(const BlockMatrix& other, bool horizontal = true) const;
 
+    /**
+     * @brief Сборка блочной матрицы из сетки частей, например [[A, B], [C, D]].
+     *
+     * Если у всех частей одинаковый размер блока и границы частей (кроме правой и нижней)
+     * совпадают с границами блоков, результат собирается из плиток частей без копирования
+     * плотных данных (блоки вида Shared). Иначе элементы копируются в сетку блоков
+     * первой части.
+     *
+     * @param grid Части по строкам сетки; в строке сетки у частей одинаковое количество
+     *             строк, в столбце сетки — одинаковое количество столбцов.
+     * @return Собранная матрица.
+     * @throw std::invalid_argument Если сетка пуста или размеры частей не согласованы.
+     */
+    static BlockMatrix assembleBlockMatrix(const std::vector<std::vector<std::reference_wrapper<const BlockMatrix>>>& grid);
+
+    /**
+     * @brief Количество блоков, ссылающихся на память других матриц.
+     * @return Количество блоков вида Shared.
+     */
+    size_t getSharedTileCount() const noexcept { return sharedTiles_.size(); }
+
+    /**
+     * @brief Порядок хранения блоков.
+     * @return Порядок.
+     */
+    TileLayout getTileLayout() const noexcept { return layout_; }
+
+    /**
+     * @brief Сменить порядок хранения блоков.
+     *
+     * Блоки перенумеровываются, а плотные плитки переупаковываются в новую область TileArena
+     * в новом порядке (свободные плитки при этом отбрасываются). При порядке Morton четверть
+     * сетки, ее четверть и т. д. лежат в памяти подряд, что уменьшает промахи кэша и TLB у
+     * рекурсивных алгоритмов. Индексы блоков в интерфейсе (getBlock() и др.) не меняются.
+     *
+     * @param layout Новый порядок.
+     */
+    void setTileLayout(TileLayout layout);
+
     /**
      * @brief Нахождение максимального элемента в блочной матрице.
      * @return Максимальный элемент.
-     * 
-     * Метод находит максимальный элемент среди всех блоков текущей 
+     *
+     * Метод находит максимальный элемент среди всех блоков текущей
      * блочной матрицы.
      */
     MatrixType findMaxElementBlockMatrix() const noexcept;
@@ -413,8 +1062,8 @@ public:
     /**
      * @brief Нахождение максимального элемента в указанном блоке блочной матрицы.
      * @return Блок матрицы, содержащий максимальный элемент.
-     * 
-     * Метод находит максимальный элемент в указанном блоке текущей 
+     *
+     * Метод находит максимальный элемент в указанном блоке текущей
      * блочной матрицы.
      */
     Matrix<MatrixType> findMaxElementBlockMatrixBlock() const noexcept;
@@ -422,8 +1071,8 @@ public:
     /**
      * @brief Нахождение минимального элемента в блочной матрице.
      * @return Минимальный элемент.
-     * 
-     * Метод находит минимальный элемент среди всех блоков текущей 
+     *
+     * Метод находит минимальный элемент среди всех блоков текущей
      * блочной матрицы.
      */
     MatrixType findMinElementBlockMatrix() const noexcept;
@@ -431,8 +1080,8 @@ public:
     /**
      * @brief Нахождение минимального элемента в указанном блоке блочной матрицы.
      * @return Блок матрицы, содержащий минимальный элемент.
-     * 
-     * Метод находит минимальный элемент в указанном блоке текущей 
+     *
+     * Метод находит минимальный элемент в указанном блоке текущей
      * блочной матрицы.
      */
     Matrix<MatrixType> findMinElementBlockMatrixBlock() const noexcept;
@@ -440,9 +1089,10 @@ public:
     /**
      * @brief Вычисление скалярного произведения с другой блочной матрицей.
      * @param other Другая блочная матрица для скалярного произведения.
-     * @return Значение скалярного произведения.
-     * 
-     * Метод вычисляет скалярное произведение текущей блочной матрицы 
+     * @return Значение скалярного произведения (сумма произведений соответствующих элементов).
+     * @throw std::invalid_argument Если размеры матриц не совпадают.
+     *
+     * Метод вычисляет скалярное произведение текущей блочной матрицы
      * с указанной матрицей.
      */
     MatrixType dotProduct(const BlockMatrix& other) const;
@@ -451,125 +1101,949 @@ public:
      * @brief Возведение блочной матрицы в степень.
      * @param exp Показатель степени.
      * @return Результирующая блочная матрица после возведения в степень.
-     * 
-     * Метод возводит текущую блочную матрицу в указанную степень 
+     * @throw std::invalid_argument Если матрица не квадратная или показатель отрицательный.
+     *
+     * Метод возводит текущую блочную матрицу в указанную степень
      * и возвращает новую матрицу.
      */
     BlockMatrix powBlockMatrix(int exp) const;
+
+    /**
+     * @brief LU-разложение без выбора ведущего элемента на месте (A = L * U).
+     *
+     * Шаги getrf, trsm и gemm над плитками образуют граф задач TaskGraph; задача запускается,
+     * как только готовы ее входные плитки, поэтому обновления шага k перекрываются со
+     * следующими шагами. Подходит для матриц с диагональным преобладанием.
+     * После разложения ниже диагонали хранится L (с единичной диагональю), на диагонали и выше — U.
+     *
+     * @throw std::invalid_argument Если матрица или блоки не квадратные.
+     * @throw std::domain_error Если встретился нулевой ведущий элемент.
+     */
+    void factorizeLUBlockMatrix();
+
+    /**
+     * @brief Разложение Холецкого на месте (A = L * L^T).
+     *
+     * Шаги potrf, trsm, syrk и gemm над плитками нижнего треугольника выполняются как граф
+     * задач TaskGraph. После разложения матрица содержит L, выше диагонали — нули.
+     *
+     * @throw std::invalid_argument Если матрица или блоки не квадратные.
+     * @throw std::domain_error Если матрица не положительно определена.
+     */
+    void factorizeCholeskyBlockMatrix();
+
+    /**
+     * @brief Приближенное LU-разложение на месте с сохранением малоранговых блоков.
+     *
+     * Граф задач тот же, что у factorizeLUBlockMatrix(), но малоранговые блоки остаются
+     * малоранговыми: треугольные решения применяются к одному из множителей, а обновление
+     * A_ij -= A_ik * A_kj для малорангового A_ij заново сжимается approximateCrossTile()
+     * с точностью tolerance. Заполнение, порожденное малоранговым множителем, тоже хранится
+     * малоранговым. Диагональные блоки плотные; разреженные и единичные блоки перед
+     * разложением становятся плотными.
+     *
+     * @param tolerance Относительная точность пересжатия блоков.
+     * @throw std::invalid_argument Если матрица или блоки не квадратные.
+     * @throw std::domain_error Если встречен нулевой ведущий элемент.
+     */
+    void factorizeApproximateLUBlockMatrix(double tolerance);
+
+    /**
+     * @brief Умножение на вектор с учетом вида блоков.
+     *
+     * Малоранговый блок умножается как U * (V^T * x), поэтому для иерархически сжатой
+     * матрицы стоимость почти линейна. Блочные строки обрабатываются параллельно.
+     *
+     * @param vector Вектор длины getColsBlockMatrix().
+     * @return Произведение.
+     * @throw std::invalid_argument Если длина вектора не совпадает с количеством столбцов.
+     */
+    std::vector<MatrixType> multiplyVectorBlockMatrix(const std::vector<MatrixType>& vector) const;
+
+    /**
+     * @brief Решить A * x = b по хранимому LU-разложению (после factorizeLUBlockMatrix()
+     * или factorizeApproximateLUBlockMatrix()).
+     * @param rhs Правая часть b.
+     * @return Решение x.
+     * @throw std::invalid_argument Если матрица или блоки не квадратные либо длина b не совпадает.
+     */
+    std::vector<MatrixType> solveLUBlockMatrix(const std::vector<MatrixType>& rhs) const;
 };
 
 template<typename MatrixType>
 void BlockMatrix<MatrixType>::initMemory() {
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
-
-    data_ = std::make_unique<std::unique_ptr<Matrix<MatrixType>[]>[]>(numBlocksRow);
-
-    for (size_t i = 0; i < numBlocksRow; ++i) {
-        data_[i] = std::make_unique<Matrix<MatrixType>[]>(numBlocksCol);
-        for (size_t j = 0; j < numBlocksCol; ++j) 
-            data_[i][j] = Matrix<MatrixType>(blockRows_, blockCols_);     
-    }
+    if (blockRows_ == 0 || blockCols_ == 0)
+        throw std::invalid_argument("Block size must be positive");
+
+    numBlocksRow_ = (rows_ + blockRows_ - 1) / blockRows_;
+    numBlocksCol_ = (cols_ + blockCols_ - 1) / blockCols_;
+
+    arena_ = std::make_shared<TileArena<MatrixType>>(0, blockRows_ * blockCols_);
+    buildLayout();
+    kinds_.assign(numBlocksRow_ * numBlocksCol_, TileKind::Zero);
+    slots_.assign(numBlocksRow_ * numBlocksCol_, 0);
+    freeSlots_.clear();
+    usedSlots_ = 0;
+    sparseTiles_.clear();
+    lowRankTiles_.clear();
+    sharedTiles_.clear();
 }
 
 template<typename MatrixType>
-inline void BlockMatrix<MatrixType>::freeMemory() { 
-    data_.reset(); 
+inline void BlockMatrix<MatrixType>::freeMemory() {
+    arena_.reset();
+    kinds_.clear();
+    slots_.clear();
+    freeSlots_.clear();
+    usedSlots_ = 0;
+    sparseTiles_.clear();
+    lowRankTiles_.clear();
+    sharedTiles_.clear();
+    mortonIndex_.clear();
+    mortonPosition_.clear();
     rows_ = 0;
     cols_ = 0;
     blockRows_ = 0;
     blockCols_ = 0;
+    numBlocksRow_ = 0;
+    numBlocksCol_ = 0;
+}
+
+template<typename MatrixType>
+inline const TileArena<MatrixType>& BlockMatrix<MatrixType>::arena() const noexcept {
+    static const TileArena<MatrixType> empty;
+    return arena_ ? *arena_ : empty;
 }
 
 template<typename MatrixType>
-inline Matrix<MatrixType>& BlockMatrix<MatrixType>::getBlock(const size_t blockRow, const size_t blockCol) const {
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
+TileArena<MatrixType>& BlockMatrix<MatrixType>::arena() {
+    if (!arena_) arena_ = std::make_shared<TileArena<MatrixType>>(0, blockRows_ * blockCols_);
+    else if (arena_.use_count() > 1) unshareArena();
 
-    if (blockRow >= numBlocksRow || blockCol >= numBlocksCol || blockRow < MIN_COUNT_BLOCK || blockCol < MIN_COUNT_BLOCK)
-        throw std::out_of_range("Block index out of range");
-        
-    return data_[blockRow][blockCol];
+    return *arena_;
 }
 
 template<typename MatrixType>
-void BlockMatrix<MatrixType>::copy(const BlockMatrix<MatrixType>& other) noexcept {
-    if (this != &other) {
-        freeMemory();
-        
-        rows_ = other.rows_;
-        cols_ = other.cols_;
-        blockRows_ = other.blockRows_;
-        blockCols_ = other.blockCols_;
-        
-        initMemory();
-        
-        size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-        size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
+void BlockMatrix<MatrixType>::unshareArena() {
+    if (!arena_ || arena_.use_count() == 1) return;
+
+    const std::shared_ptr<const TileArena<MatrixType>> previous = arena_;
+    for (size_t index = 0; index < kinds_.size(); ++index) {
+        if (kinds_[index] != TileKind::Dense) continue;
 
-        for (size_t i = 0; i < numBlocksRow; ++i) 
-            for (size_t j = 0; j < numBlocksCol; ++j) 
-                data_[i][j] = other.data_[i][j];
+        sharedTiles_.emplace(index, SharedTile<MatrixType>{ previous, slots_[index] });
+        kinds_[index] = TileKind::Shared;
     }
+
+    arena_ = std::make_shared<TileArena<MatrixType>>(0, blockRows_ * blockCols_);
+    freeSlots_.clear();
+    usedSlots_ = 0;
 }
 
 template<typename MatrixType>
-inline BlockMatrix<MatrixType>::BlockMatrix() 
-    : rows_(MIN_SIZE_MATRIX), cols_(MIN_SIZE_MATRIX),
-      blockRows_(MIN_COUNT_BLOCK), blockCols_(MIN_COUNT_BLOCK) {
-    initMemory();
+inline size_t BlockMatrix<MatrixType>::tileIndex(const size_t blockRow, const size_t blockCol) const noexcept {
+    const size_t position = blockRow * numBlocksCol_ + blockCol;
+    return layout_ == TileLayout::RowMajor ? position : mortonIndex_[position];
 }
 
 template<typename MatrixType>
-inline BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols) 
-    : rows_(rows), cols_(cols),
-      blockRows_(MIN_COUNT_BLOCK), blockCols_(MIN_COUNT_BLOCK) {
-    initMemory();
+inline size_t BlockMatrix<MatrixType>::tilePosition(size_t index) const noexcept {
+    return layout_ == TileLayout::RowMajor ? index : mortonPosition_[index];
 }
 
 template<typename MatrixType>
-inline BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols) 
-    : rows_(rows), cols_(cols),
-      blockRows_(blockRows), blockCols_(blockCols) {
-    initMemory();
+inline uint64_t BlockMatrix<MatrixType>::mortonCode(size_t blockRow, size_t blockCol) noexcept {
+    uint64_t code = 0;
+    for (unsigned bit = 0; bit < 32; ++bit) {
+        code |= static_cast<uint64_t>((blockCol >> bit) & 1) << (2 * bit);
+        code |= static_cast<uint64_t>((blockRow >> bit) & 1) << (2 * bit + 1);
+    }
+
+    return code;
 }
 
 template<typename MatrixType>
-inline BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols, const Matrix<MatrixType>& matrix) 
-    : rows_(rows), cols_(cols),
-      blockRows_(MIN_COUNT_BLOCK), blockCols_(MIN_COUNT_BLOCK) {
+void BlockMatrix<MatrixType>::buildLayout() {
+    mortonIndex_.clear();
+    mortonPosition_.clear();
+    if (layout_ == TileLayout::RowMajor) return;
+
+    const size_t count = numBlocksRow_ * numBlocksCol_;
+    mortonPosition_.resize(count);
+    for (size_t t = 0; t < count; ++t) mortonPosition_[t] = t;
+
+    std::sort(mortonPosition_.begin(), mortonPosition_.end(), [this](size_t left, size_t right) {
+        return mortonCode(left / numBlocksCol_, left % numBlocksCol_) < mortonCode(right / numBlocksCol_, right % numBlocksCol_);
+    });
+
+    mortonIndex_.resize(count);
+    for (size_t index = 0; index < count; ++index) mortonIndex_[mortonPosition_[index]] = index;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::setTileLayout(TileLayout layout) {
+    if (layout == layout_) return;
+
+    std::vector<size_t> previous(kinds_.size());
+    for (size_t t = 0; t < previous.size(); ++t) previous[t] = tileIndex(t / numBlocksCol_, t % numBlocksCol_);
+
+    layout_ = layout;
+    buildLayout();
+
+    std::vector<TileKind> kinds(kinds_.size());
+    std::vector<size_t> slots(slots_.size(), 0);
+    std::unordered_map<size_t, CompressedRows<MatrixType>> sparse;
+    std::unordered_map<size_t, LowRankTile<MatrixType>> lowRank;
+    std::unordered_map<size_t, SharedTile<MatrixType>> shared;
+    std::vector<size_t> order;
+
+    for (size_t t = 0; t < previous.size(); ++t) {
+        const size_t from = previous[t];
+        const size_t to = tileIndex(t / numBlocksCol_, t % numBlocksCol_);
+        kinds[to] = kinds_[from];
+        slots[to] = slots_[from];
+
+        if (kinds_[from] == TileKind::Sparse) sparse.emplace(to, std::move(sparseTiles_.at(from)));
+        else if (kinds_[from] == TileKind::LowRank) lowRank.emplace(to, std::move(lowRankTiles_.at(from)));
+        else if (kinds_[from] == TileKind::Shared) shared.emplace(to, std::move(sharedTiles_.at(from)));
+    }
+
+    for (size_t index = 0; index < kinds.size(); ++index)
+        if (kinds[index] == TileKind::Dense) order.push_back(index);
+
+    const TileArena<MatrixType>& source = std::as_const(*this).arena();
+    auto packed = std::make_shared<TileArena<MatrixType>>(order.size(), blockRows_ * blockCols_);
+    parallelFor(0, order.size(), [&](size_t k) {
+        std::memcpy(packed->tile(k), source.tile(slots[order[k]]), source.getTileStride() * sizeof(MatrixType));
+    }, 1);
+    for (size_t k = 0; k < order.size(); ++k) slots[order[k]] = k;
+
+    arena_ = std::move(packed);
+    kinds_ = std::move(kinds);
+    slots_ = std::move(slots);
+    freeSlots_.clear();
+    usedSlots_ = order.size();
+    sparseTiles_ = std::move(sparse);
+    lowRankTiles_ = std::move(lowRank);
+    sharedTiles_ = std::move(shared);
+}
+
+template<typename MatrixType>
+inline size_t BlockMatrix<MatrixType>::validRows(const size_t blockRow) const noexcept {
+    return std::min(blockRows_, rows_ - blockRow * blockRows_);
+}
+
+template<typename MatrixType>
+inline size_t BlockMatrix<MatrixType>::validCols(const size_t blockCol) const noexcept {
+    return std::min(blockCols_, cols_ - blockCol * blockCols_);
+}
+
+template<typename MatrixType>
+inline bool BlockMatrix<MatrixType>::sameLayout(const BlockMatrix<MatrixType>& other) const noexcept {
+    return rows_ == other.rows_ && cols_ == other.cols_ &&
+           blockRows_ == other.blockRows_ && blockCols_ == other.blockCols_ && layout_ == other.layout_;
+}
+
+template<typename MatrixType>
+inline size_t BlockMatrix<MatrixType>::identitySize(size_t index) const noexcept {
+    return validRows(tilePosition(index) / numBlocksCol_);
+}
+
+template<typename MatrixType>
+BlockMatrix<MatrixType> BlockMatrix<MatrixType>::conformed(const BlockMatrix<MatrixType>& other) const {
+    if (other.blockRows_ == blockRows_ && other.blockCols_ == blockCols_) {
+        BlockMatrix result(other);
+        result.setTileLayout(layout_);
+        return result;
+    }
+
+    BlockMatrix result(other.toMatrix(), blockRows_, blockCols_);
+    result.setTileLayout(layout_);
+    return result;
+}
+
+template<typename MatrixType>
+size_t BlockMatrix<MatrixType>::acquireSlot() {
+    if (!freeSlots_.empty()) {
+        const size_t slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        return slot;
+    }
+
+    if (usedSlots_ == arena().getTileCount())
+        arena().resizeTiles(std::min(kinds_.size(), std::max<size_t>(4, 2 * arena().getTileCount())));
+
+    return usedSlots_++;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::releaseTile(size_t index) {
+    unshareArena();
+    if (kinds_[index] == TileKind::Dense) {
+        std::memset(arena().tile(slots_[index]), 0, arena().getTileStride() * sizeof(MatrixType));
+        freeSlots_.push_back(slots_[index]);
+    } else if (kinds_[index] == TileKind::Sparse) {
+        sparseTiles_.erase(index);
+    } else if (kinds_[index] == TileKind::LowRank) {
+        lowRankTiles_.erase(index);
+    } else if (kinds_[index] == TileKind::Shared) {
+        sharedTiles_.erase(index);
+    }
+
+    kinds_[index] = TileKind::Zero;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::expandTile(size_t index, MatrixType factor, MatrixType* dst, size_t ld) const {
+    switch (kinds_[index]) {
+        case TileKind::Zero:
+            return;
+        case TileKind::Identity:
+            for (size_t r = 0; r < identitySize(index); ++r) dst[r * ld + r] += factor;
+            return;
+        case TileKind::Dense:
+        case TileKind::Shared: {
+            const MatrixType* tile = tileData(index);
+            for (size_t r = 0; r < blockRows_; ++r)
+                for (size_t c = 0; c < blockCols_; ++c) dst[r * ld + c] += factor * tile[r * blockCols_ + c];
+            return;
+        }
+        case TileKind::Sparse: {
+            const CompressedRows<MatrixType>& csr = sparseTiles_.at(index);
+            for (size_t r = 0; r + 1 < csr.rowPtr.size(); ++r)
+                for (size_t p = csr.rowPtr[r]; p < csr.rowPtr[r + 1]; ++p) dst[r * ld + csr.colIdx[p]] += factor * csr.values[p];
+            return;
+        }
+        case TileKind::LowRank: {
+            const LowRankTile<MatrixType>& tile = lowRankTiles_.at(index);
+            addLowRankProductTile(tile.u.data(), tile.v.data(), tile.rank, tile.height, tile.width, factor, dst, ld);
+            return;
+        }
+    }
+}
+
+template<typename MatrixType>
+template<typename Visit>
+void BlockMatrix<MatrixType>::forEachRowEntry(size_t index, size_t row, size_t width, Visit visit) const {
+    switch (kinds_[index]) {
+        case TileKind::Identity:
+            visit(row, static_cast<MatrixType>(1));
+            return;
+        case TileKind::Dense:
+        case TileKind::Shared: {
+            const MatrixType* tile = tileData(index) + row * blockCols_;
+            for (size_t c = 0; c < width; ++c)
+                if (tile[c] != static_cast<MatrixType>(0)) visit(c, tile[c]);
+            return;
+        }
+        case TileKind::Sparse: {
+            const CompressedRows<MatrixType>& csr = sparseTiles_.at(index);
+            for (size_t p = csr.rowPtr[row]; p < csr.rowPtr[row + 1]; ++p) visit(csr.colIdx[p], csr.values[p]);
+            return;
+        }
+        case TileKind::LowRank: {
+            const LowRankTile<MatrixType>& tile = lowRankTiles_.at(index);
+            for (size_t c = 0; c < width; ++c) visit(c, lowRankElement(tile, row, c));
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+template<typename MatrixType>
+LowRankTile<MatrixType> BlockMatrix<MatrixType>::multiplyLowRankTile(const BlockMatrix<MatrixType>& a, size_t left,
+                                                                     const BlockMatrix<MatrixType>& b, size_t right,
+                                                                     size_t height, size_t depth, size_t width) {
+    if (a.kinds_[left] == TileKind::LowRank) {
+        const LowRankTile<MatrixType>& lowRank = a.lowRankTiles_.at(left);
+        const size_t rank = lowRank.rank;
+        LowRankTile<MatrixType> product{ height, width, rank, lowRank.u, std::vector<MatrixType>(width * rank) };
+
+        for (size_t p = 0; p < depth; ++p) {
+            const MatrixType* vp = lowRank.v.data() + p * rank;
+            b.forEachRowEntry(right, p, width, [&](size_t q, MatrixType value) {
+                for (size_t s = 0; s < rank; ++s) product.v[q * rank + s] += value * vp[s];
+            });
+        }
+
+        return product;
+    }
+
+    const LowRankTile<MatrixType>& lowRank = b.lowRankTiles_.at(right);
+    const size_t rank = lowRank.rank;
+    LowRankTile<MatrixType> product{ height, width, rank, std::vector<MatrixType>(height * rank), lowRank.v };
+
+    for (size_t r = 0; r < height; ++r)
+        a.forEachRowEntry(left, r, depth, [&](size_t p, MatrixType value) {
+            for (size_t s = 0; s < rank; ++s) product.u[r * rank + s] += value * lowRank.u[p * rank + s];
+        });
+
+    return product;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::multiplyAddVectorTile(size_t index, MatrixType factor, const MatrixType* x, MatrixType* y,
+                                                    size_t height, size_t width) const {
+    switch (kinds_[index]) {
+        case TileKind::Zero:
+            return;
+        case TileKind::Identity:
+            for (size_t r = 0; r < std::min(height, width); ++r) y[r] += factor * x[r];
+            return;
+        case TileKind::Dense:
+        case TileKind::Shared: {
+            const MatrixType* tile = tileData(index);
+            for (size_t r = 0; r < height; ++r) {
+                MatrixType sum = static_cast<MatrixType>(0);
+                for (size_t c = 0; c < width; ++c) sum += tile[r * blockCols_ + c] * x[c];
+                y[r] += factor * sum;
+            }
+            return;
+        }
+        case TileKind::Sparse: {
+            const CompressedRows<MatrixType>& csr = sparseTiles_.at(index);
+            for (size_t r = 0; r < height; ++r) {
+                MatrixType sum = static_cast<MatrixType>(0);
+                for (size_t p = csr.rowPtr[r]; p < csr.rowPtr[r + 1]; ++p) sum += csr.values[p] * x[csr.colIdx[p]];
+                y[r] += factor * sum;
+            }
+            return;
+        }
+        case TileKind::LowRank: {
+            const LowRankTile<MatrixType>& tile = lowRankTiles_.at(index);
+            std::vector<MatrixType> projected(tile.rank, static_cast<MatrixType>(0));
+            for (size_t c = 0; c < width; ++c)
+                for (size_t s = 0; s < tile.rank; ++s) projected[s] += tile.v[c * tile.rank + s] * x[c];
+
+            for (size_t r = 0; r < height; ++r) {
+                MatrixType sum = static_cast<MatrixType>(0);
+                for (size_t s = 0; s < tile.rank; ++s) sum += tile.u[r * tile.rank + s] * projected[s];
+                y[r] += factor * sum;
+            }
+            return;
+        }
+    }
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::multiplyAddTile(const BlockMatrix<MatrixType>& a, size_t left, const BlockMatrix<MatrixType>& b,
+                                              size_t right, size_t height, size_t depth, size_t width, MatrixType* c,
+                                              std::vector<MatrixType>& scratch) const {
+    const TileKind leftKind = a.kinds_[left];
+    const TileKind rightKind = b.kinds_[right];
+    const MatrixType* leftTile = a.tileData(left);
+    const MatrixType* rightTile = b.tileData(right);
+
+    if (leftTile != nullptr && rightTile != nullptr) {
+        packTilePanel(leftTile, blockRows_, a.blockCols_, a.blockCols_, scratch);
+        multiplyAddPackedTile(scratch.data(), rightTile, c, blockRows_, a.blockCols_, blockCols_, blockCols_, blockCols_);
+        return;
+    }
+
+    if (leftKind == TileKind::LowRank || rightKind == TileKind::LowRank) {
+        const LowRankTile<MatrixType> product = multiplyLowRankTile(a, left, b, right, height, depth, width);
+        addLowRankProductTile(product.u.data(), product.v.data(), product.rank, height, width,
+                              static_cast<MatrixType>(1), c, blockCols_);
+        return;
+    }
+
+    for (size_t r = 0; r < height; ++r) {
+        MatrixType* cr = c + r * blockCols_;
+        a.forEachRowEntry(left, r, depth, [&](size_t p, MatrixType factor) {
+            if (rightTile != nullptr) {
+                const MatrixType* bp = rightTile + p * blockCols_;
+                for (size_t q = 0; q < width; ++q) cr[q] += factor * bp[q];
+            } else {
+                b.forEachRowEntry(right, p, width, [&](size_t q, MatrixType value) { cr[q] += factor * value; });
+            }
+        });
+    }
+}
+
+template<typename MatrixType>
+MatrixType* BlockMatrix<MatrixType>::materializeTile(size_t index) {
+    unshareArena();
+    if (kinds_[index] == TileKind::Dense) return arena().tile(slots_[index]);
+
+    const size_t slot = acquireSlot();
+    MatrixType* tile = arena().tile(slot);
+
+    expandTile(index, static_cast<MatrixType>(1), tile, blockCols_);
+    sparseTiles_.erase(index);
+    lowRankTiles_.erase(index);
+    sharedTiles_.erase(index);
+
+    slots_[index] = slot;
+    kinds_[index] = TileKind::Dense;
+    return tile;
+}
+
+template<typename MatrixType>
+inline const MatrixType* BlockMatrix<MatrixType>::tileData(size_t index) const noexcept {
+    if (kinds_[index] == TileKind::Dense) return arena().tile(slots_[index]);
+    if (kinds_[index] == TileKind::Shared) return sharedTiles_.at(index).data();
+
+    return nullptr;
+}
+
+template<typename MatrixType>
+inline MatrixType BlockMatrix<MatrixType>::elementAt(size_t index, size_t row, size_t col) const noexcept {
+    switch (kinds_[index]) {
+        case TileKind::Zero: return static_cast<MatrixType>(0);
+        case TileKind::Identity: return static_cast<MatrixType>(row == col ? 1 : 0);
+        case TileKind::Dense:
+        case TileKind::Shared: return tileData(index)[row * blockCols_ + col];
+        case TileKind::LowRank: return lowRankElement(lowRankTiles_.at(index), row, col);
+        default: break;
+    }
+
+    const CompressedRows<MatrixType>& csr = sparseTiles_.at(index);
+    auto first = csr.colIdx.begin() + csr.rowPtr[row];
+    auto last = csr.colIdx.begin() + csr.rowPtr[row + 1];
+    auto it = std::lower_bound(first, last, col);
+
+    return (it != last && *it == col) ? csr.values[it - csr.colIdx.begin()] : static_cast<MatrixType>(0);
+}
+
+template<typename MatrixType>
+template<typename Value>
+TileKind BlockMatrix<MatrixType>::classifyRegion(size_t height, size_t width, Value value) {
+    bool zero = true;
+    bool identity = height == width;
+
+    for (size_t r = 0; r < height && (zero || identity); ++r)
+        for (size_t c = 0; c < width; ++c) {
+            const MatrixType element = value(r, c);
+            if (element != static_cast<MatrixType>(0)) zero = false;
+            if (element != static_cast<MatrixType>(r == c ? 1 : 0)) identity = false;
+        }
+
+    return zero ? TileKind::Zero : (identity ? TileKind::Identity : TileKind::Dense);
+}
+
+template<typename MatrixType>
+template<typename Better>
+MatrixType BlockMatrix<MatrixType>::tileExtreme(size_t blockRow, size_t blockCol, Better better) const noexcept {
+    const size_t index = tileIndex(blockRow, blockCol);
+    const size_t height = validRows(blockRow);
+    const size_t width = validCols(blockCol);
+
+    if (kinds_[index] == TileKind::Zero) return static_cast<MatrixType>(0);
+
+    if (kinds_[index] == TileKind::Identity) {
+        const MatrixType one = static_cast<MatrixType>(1);
+        return height * width == 1 || better(one, static_cast<MatrixType>(0)) ? one : static_cast<MatrixType>(0);
+    }
+
+    if (kinds_[index] == TileKind::Sparse) {
+        const CompressedRows<MatrixType>& csr = sparseTiles_.at(index);
+        MatrixType best = csr.values.size() < height * width || csr.values.empty() ? static_cast<MatrixType>(0) : csr.values[0];
+        for (MatrixType value : csr.values)
+            if (better(value, best)) best = value;
+
+        return best;
+    }
+
+    MatrixType best = elementAt(index, 0, 0);
+    for (size_t r = 0; r < height; ++r)
+        for (size_t c = 0; c < width; ++c) {
+            const MatrixType value = elementAt(index, r, c);
+            if (better(value, best)) best = value;
+        }
+
+    return best;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::addScaledBlockMatrix(const BlockMatrix<MatrixType>& other, MatrixType factor) {
+    const size_t stride = arena().getTileStride();
+
+    for (size_t t = 0; t < kinds_.size(); ++t) {
+        const TileKind kind = other.kinds_[t];
+        if (kind == TileKind::Zero) continue;
+
+        if (kinds_[t] == TileKind::Zero && factor == static_cast<MatrixType>(1)) {
+            if (kind == TileKind::Dense) {
+                std::memcpy(materializeTile(t), other.arena().tile(other.slots_[t]), stride * sizeof(MatrixType));
+            } else {
+                if (kind == TileKind::Sparse) sparseTiles_[t] = other.sparseTiles_.at(t);
+                if (kind == TileKind::LowRank) lowRankTiles_[t] = other.lowRankTiles_.at(t);
+                if (kind == TileKind::Shared) sharedTiles_[t] = other.sharedTiles_.at(t);
+                kinds_[t] = kind;
+            }
+            continue;
+        }
+
+        MatrixType* tile = materializeTile(t);
+        if (const MatrixType* source = other.tileData(t)) {
+            for (size_t k = 0; k < stride; ++k) tile[k] += factor * source[k];
+        } else {
+            other.expandTile(t, factor, tile, blockCols_);
+        }
+    }
+}
+
+template<typename MatrixType>
+inline MatrixType* BlockMatrix<MatrixType>::getBlockData(const size_t blockRow, const size_t blockCol) {
+    if (blockRow >= numBlocksRow_ || blockCol >= numBlocksCol_)
+        throw std::out_of_range("Block index out of range");
+
+    return materializeTile(tileIndex(blockRow, blockCol));
+}
+
+template<typename MatrixType>
+inline const MatrixType* BlockMatrix<MatrixType>::getBlockData(const size_t blockRow, const size_t blockCol) const {
+    if (blockRow >= numBlocksRow_ || blockCol >= numBlocksCol_)
+        throw std::out_of_range("Block index out of range");
+
+    return tileData(tileIndex(blockRow, blockCol));
+}
+
+template<typename MatrixType>
+inline MatrixView<MatrixType> BlockMatrix<MatrixType>::getBlockView(const size_t blockRow, const size_t blockCol) {
+    MatrixType* tile = getBlockData(blockRow, blockCol);
+    return MatrixView<MatrixType>(tile, validRows(blockRow), validCols(blockCol), blockCols_);
+}
+
+template<typename MatrixType>
+inline MatrixView<const MatrixType> BlockMatrix<MatrixType>::getBlockView(const size_t blockRow, const size_t blockCol) const {
+    const MatrixType* tile = getBlockData(blockRow, blockCol);
+    if (tile == nullptr) throw std::invalid_argument("Block is not stored densely");
+
+    return MatrixView<const MatrixType>(tile, validRows(blockRow), validCols(blockCol), blockCols_);
+}
+
+template<typename MatrixType>
+inline TileKind BlockMatrix<MatrixType>::getTileKind(const size_t blockRow, const size_t blockCol) const {
+    if (blockRow >= numBlocksRow_ || blockCol >= numBlocksCol_)
+        throw std::out_of_range("Block index out of range");
+
+    return kinds_[tileIndex(blockRow, blockCol)];
+}
+
+template<typename MatrixType>
+inline void BlockMatrix<MatrixType>::clearBlock(const size_t blockRow, const size_t blockCol) {
+    if (blockRow >= numBlocksRow_ || blockCol >= numBlocksCol_)
+        throw std::out_of_range("Block index out of range");
+
+    releaseTile(tileIndex(blockRow, blockCol));
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::compressBlockMatrix() {
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const size_t index = tileIndex(i, j);
+            if (kinds_[index] != TileKind::Dense && kinds_[index] != TileKind::Shared) continue;
+
+            const MatrixType* tile = tileData(index);
+            const TileKind kind = classifyRegion(validRows(i), validCols(j),
+                                                 [&](size_t r, size_t c) { return tile[r * blockCols_ + c]; });
+            if (kind != TileKind::Dense) {
+                releaseTile(index);
+                kinds_[index] = kind;
+                continue;
+            }
+
+            CompressedRows<MatrixType> csr{ std::vector<size_t>(validRows(i) + 1, 0), {}, {} };
+            for (size_t r = 0; r < validRows(i); ++r) {
+                for (size_t c = 0; c < validCols(j); ++c)
+                    if (tile[r * blockCols_ + c] != static_cast<MatrixType>(0)) {
+                        csr.colIdx.push_back(c);
+                        csr.values.push_back(tile[r * blockCols_ + c]);
+                    }
+                csr.rowPtr[r + 1] = csr.colIdx.size();
+            }
+
+            if (static_cast<double>(csr.values.size()) > TILE_SPARSE_MAX_FILL * static_cast<double>(validRows(i) * validCols(j)))
+                continue;
+
+            releaseTile(index);
+            sparseTiles_[index] = std::move(csr);
+            kinds_[index] = TileKind::Sparse;
+        }
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::setSparseBlock(const size_t blockRow, const size_t blockCol, const SparseMatrix<MatrixType>& block) {
+    getTileKind(blockRow, blockCol);
+    const size_t index = tileIndex(blockRow, blockCol);
+
+    if (block.getRowsSparseMatrix() != validRows(blockRow) || block.getColsSparseMatrix() != validCols(blockCol))
+        throw std::invalid_argument("Block has incompatible dimensions");
+
+    CompressedRows<MatrixType> csr = block.toCompressedRows();
+    releaseTile(index);
+    if (csr.values.empty()) return;
+
+    sparseTiles_[index] = std::move(csr);
+    kinds_[index] = TileKind::Sparse;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::setLowRankBlock(const size_t blockRow, const size_t blockCol,
+                                              const Matrix<MatrixType>& u, const Matrix<MatrixType>& v) {
+    getTileKind(blockRow, blockCol);
+    const size_t index = tileIndex(blockRow, blockCol);
+
+    if (u.getRows() != validRows(blockRow) || v.getRows() != validCols(blockCol) || u.getCols() != v.getCols())
+        throw std::invalid_argument("Low-rank factors have incompatible dimensions");
+
+    LowRankTile<MatrixType> tile{ u.getRows(), v.getRows(), u.getCols(), {}, {} };
+    for (size_t r = 0; r < u.getRows(); ++r) tile.u.insert(tile.u.end(), u.getRowData(r), u.getRowData(r) + tile.rank);
+    for (size_t r = 0; r < v.getRows(); ++r) tile.v.insert(tile.v.end(), v.getRowData(r), v.getRowData(r) + tile.rank);
+
+    releaseTile(index);
+    lowRankTiles_[index] = std::move(tile);
+    kinds_[index] = TileKind::LowRank;
+}
+
+template<typename MatrixType>
+size_t BlockMatrix<MatrixType>::getStoredElementCount() const noexcept {
+    size_t count = getDenseTileCount() * blockRows_ * blockCols_;
+
+    for (const auto& entry : sparseTiles_) count += entry.second.values.size();
+    for (const auto& entry : lowRankTiles_) count += (entry.second.height + entry.second.width) * entry.second.rank;
+
+    return count;
+}
+
+template<typename MatrixType>
+Matrix<MatrixType> BlockMatrix<MatrixType>::getBlock(const size_t blockRow, const size_t blockCol) const {
+    const TileKind kind = getTileKind(blockRow, blockCol);
+    const size_t index = tileIndex(blockRow, blockCol);
+    const size_t height = validRows(blockRow);
+    const size_t width = validCols(blockCol);
+
+    Matrix<MatrixType> block(height, width);
+    if (const MatrixType* tile = tileData(index)) {
+        for (size_t r = 0; r < height; ++r)
+            std::copy(tile + r * blockCols_, tile + r * blockCols_ + width, block.getRowData(r));
+    } else if (kind != TileKind::Zero) {
+        for (size_t r = 0; r < height; ++r)
+            for (size_t c = 0; c < width; ++c) block(r, c) = elementAt(index, r, c);
+    }
+
+    return block;
+}
+
+template<typename MatrixType>
+inline void BlockMatrix<MatrixType>::setBlock(const size_t blockRow, const size_t blockCol, const Matrix<MatrixType>& block) {
+    setBlock(blockRow, blockCol, block.view());
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::setBlock(const size_t blockRow, const size_t blockCol, const MatrixView<const MatrixType>& block) {
+    getTileKind(blockRow, blockCol);
+    const size_t index = tileIndex(blockRow, blockCol);
+    const size_t height = validRows(blockRow);
+    const size_t width = validCols(blockCol);
+
+    if (block.getRows() != height || block.getCols() != width)
+        throw std::invalid_argument("Block has incompatible dimensions");
+
+    const TileKind kind = classifyRegion(height, width, [&](size_t r, size_t c) { return block.getRowData(r)[c]; });
+    if (kind != TileKind::Dense) {
+        releaseTile(index);
+        kinds_[index] = kind;
+        return;
+    }
+
+    MatrixType* tile = materializeTile(index);
+    for (size_t r = 0; r < height; ++r)
+        std::copy(block.getRowData(r), block.getRowData(r) + width, tile + r * blockCols_);
+}
+
+template<typename MatrixType>
+inline MatrixType BlockMatrix<MatrixType>::getValue(const size_t row, const size_t col) const {
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of range");
+
+    return elementAt(tileIndex(row / blockRows_, col / blockCols_), row % blockRows_, col % blockCols_);
+}
+
+template<typename MatrixType>
+inline void BlockMatrix<MatrixType>::setValue(const size_t row, const size_t col, const MatrixType value) {
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of range");
+
+    const size_t index = tileIndex(row / blockRows_, col / blockCols_);
+    if (kinds_[index] != TileKind::Dense && elementAt(index, row % blockRows_, col % blockCols_) == value) return;
+
+    materializeTile(index)[(row % blockRows_) * blockCols_ + col % blockCols_] = value;
+}
+
+template<typename MatrixType>
+inline BlockMatrix<MatrixType>::BlockMatrix()
+    : rows_(MIN_SIZE_MATRIX), cols_(MIN_SIZE_MATRIX),
+      blockRows_(MIN_COUNT_BLOCK), blockCols_(MIN_COUNT_BLOCK) {
     initMemory();
+}
 
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
+template<typename MatrixType>
+inline TileShape BlockMatrix<MatrixType>::tunedShape(size_t rows, size_t cols) {
+    const TileShape shape = TileAutotuner::instance().getTileShape<MatrixType>(TileOperation::Multiply);
+    return TileShape{ std::max<size_t>(1, std::min(shape.rows, rows)), std::max<size_t>(1, std::min(shape.cols, cols)) };
+}
 
-    for (size_t i = 0; i < numBlocksRow; ++i) 
-        for (size_t j = 0; j < numBlocksCol; ++j) 
-            data_[i][j] = matrix;
+template<typename MatrixType>
+inline BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols)
+    : rows_(rows), cols_(cols) {
+    const TileShape shape = tunedShape(rows, cols);
+    blockRows_ = shape.rows;
+    blockCols_ = shape.cols;
+    initMemory();
 }
 
 template<typename MatrixType>
-inline BlockMatrix<MatrixType>::BlockMatrix(const BlockMatrix<MatrixType>& other) 
-    : rows_(other.rows_), cols_(other.cols_), 
-      blockRows_(other.blockRows_), blockCols_(other.blockCols_) {
-    copy(other);
+inline BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols)
+    : rows_(rows), cols_(cols),
+      blockRows_(blockRows), blockCols_(blockCols) {
+    initMemory();
+}
+
+template<typename MatrixType>
+BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols, const Matrix<MatrixType>& matrix)
+    : rows_(rows), cols_(cols),
+      blockRows_(matrix.getRows()), blockCols_(matrix.getCols()) {
+    initMemory();
+
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) setBlock(i, j, matrix.view().subView(0, 0, validRows(i), validCols(j)));
+}
+
+template<typename MatrixType>
+inline BlockMatrix<MatrixType>::BlockMatrix(const Matrix<MatrixType>& matrix, size_t blockRows, size_t blockCols)
+    : BlockMatrix(matrix.view(), blockRows, blockCols) {}
+
+template<typename MatrixType>
+BlockMatrix<MatrixType>::BlockMatrix(const MatrixView<const MatrixType>& matrix, size_t blockRows, size_t blockCols)
+    : rows_(matrix.getRows()), cols_(matrix.getCols()),
+      blockRows_(blockRows), blockCols_(blockCols) {
+    initMemory();
+
+    parallelFor(0, kinds_.size(), [&](size_t t) {
+        const size_t i = t / numBlocksCol_;
+        const size_t j = t % numBlocksCol_;
+        kinds_[tileIndex(i, j)] = classifyRegion(validRows(i), validCols(j), [&](size_t r, size_t c) {
+            return matrix.getRowData(i * blockRows_ + r)[j * blockCols_ + c];
+        });
+    }, 1);
+
+    size_t dense = 0;
+    for (size_t t = 0; t < kinds_.size(); ++t)
+        if (kinds_[t] == TileKind::Dense) slots_[t] = dense++;
+
+    arena().resizeTiles(dense);
+    usedSlots_ = dense;
+
+    parallelFor(0, kinds_.size(), [&](size_t t) {
+        const size_t i = t / numBlocksCol_;
+        const size_t j = t % numBlocksCol_;
+        const size_t index = tileIndex(i, j);
+        if (kinds_[index] != TileKind::Dense) return;
+
+        MatrixType* tile = arena().tile(slots_[index]);
+        for (size_t r = 0; r < validRows(i); ++r) {
+            const MatrixType* source = matrix.getRowData(i * blockRows_ + r) + j * blockCols_;
+            std::copy(source, source + validCols(j), tile + r * blockCols_);
+        }
+    }, 1);
+}
+
+template<typename MatrixType>
+BlockMatrix<MatrixType>::BlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols,
+                                     const std::function<MatrixType(size_t, size_t)>& entry, double tolerance,
+                                     size_t admissibleDistance)
+    : rows_(rows), cols_(cols),
+      blockRows_(blockRows), blockCols_(blockCols) {
+    if (tolerance < 0.0) throw std::invalid_argument("Tolerance must be non-negative");
+
+    initMemory();
+    std::vector<LowRankTile<MatrixType>> approximations(kinds_.size());
+
+    parallelFor(0, kinds_.size(), [&](size_t t) {
+        const size_t i = t / numBlocksCol_;
+        const size_t j = t % numBlocksCol_;
+        const size_t index = tileIndex(i, j);
+        const size_t height = validRows(i);
+        const size_t width = validCols(j);
+
+        kinds_[index] = TileKind::Dense;
+        if ((i > j ? i - j : j - i) < admissibleDistance) return;
+
+        auto tileEntry = [&](size_t r, size_t c) { return entry(i * blockRows_ + r, j * blockCols_ + c); };
+        if (!approximateCrossTile(height, width, tileEntry, tolerance, height * width / (height + width), approximations[index]))
+            return;
+
+        kinds_[index] = approximations[index].rank == 0 ? TileKind::Zero : TileKind::LowRank;
+    }, 1);
+
+    size_t dense = 0;
+    for (size_t t = 0; t < kinds_.size(); ++t) {
+        if (kinds_[t] == TileKind::LowRank) lowRankTiles_.emplace(t, std::move(approximations[t]));
+        if (kinds_[t] == TileKind::Dense) slots_[t] = dense++;
+    }
+
+    arena().resizeTiles(dense);
+    usedSlots_ = dense;
+
+    parallelFor(0, kinds_.size(), [&](size_t t) {
+        const size_t i = t / numBlocksCol_;
+        const size_t j = t % numBlocksCol_;
+        const size_t index = tileIndex(i, j);
+        if (kinds_[index] != TileKind::Dense) return;
+
+        MatrixType* tile = arena().tile(slots_[index]);
+        for (size_t r = 0; r < validRows(i); ++r)
+            for (size_t c = 0; c < validCols(j); ++c) tile[r * blockCols_ + c] = entry(i * blockRows_ + r, j * blockCols_ + c);
+    }, 1);
 }
 
+template<typename MatrixType>
+inline BlockMatrix<MatrixType>::BlockMatrix(const Matrix<MatrixType>& matrix)
+    : BlockMatrix(matrix, tunedShape(matrix.getRows(), matrix.getCols())) {}
+
+template<typename MatrixType>
+inline BlockMatrix<MatrixType>::BlockMatrix(const Matrix<MatrixType>& matrix, TileShape shape)
+    : BlockMatrix(matrix, shape.rows, shape.cols) {}
+
+template<typename MatrixType>
+inline BlockMatrix<MatrixType>::BlockMatrix(const BlockMatrix<MatrixType>& other)
+    : rows_(other.rows_), cols_(other.cols_),
+      blockRows_(other.blockRows_), blockCols_(other.blockCols_),
+      numBlocksRow_(other.numBlocksRow_), numBlocksCol_(other.numBlocksCol_),
+      arena_(std::make_shared<TileArena<MatrixType>>(other.arena())), kinds_(other.kinds_), slots_(other.slots_),
+      freeSlots_(other.freeSlots_), usedSlots_(other.usedSlots_),
+      sparseTiles_(other.sparseTiles_), lowRankTiles_(other.lowRankTiles_), sharedTiles_(other.sharedTiles_),
+      layout_(other.layout_), mortonIndex_(other.mortonIndex_), mortonPosition_(other.mortonPosition_) {}
+
 template<typename MatrixType>
 inline BlockMatrix<MatrixType>::BlockMatrix(BlockMatrix<MatrixType>&& other) noexcept
-    : rows_(std::exchange(other.rows_, 0)), 
+    : rows_(std::exchange(other.rows_, 0)),
       cols_(std::exchange(other.cols_, 0)),
-      blockRows_(std::exchange(other.blockRows_, 0)), 
+      blockRows_(std::exchange(other.blockRows_, 0)),
       blockCols_(std::exchange(other.blockCols_, 0)),
-      data_(std::move(other.data_)) {
-    other.data_ = nullptr; 
-}
+      numBlocksRow_(std::exchange(other.numBlocksRow_, 0)),
+      numBlocksCol_(std::exchange(other.numBlocksCol_, 0)),
+      arena_(std::move(other.arena_)),
+      kinds_(std::move(other.kinds_)),
+      slots_(std::move(other.slots_)),
+      freeSlots_(std::move(other.freeSlots_)),
+      usedSlots_(std::exchange(other.usedSlots_, 0)),
+      sparseTiles_(std::move(other.sparseTiles_)),
+      lowRankTiles_(std::move(other.lowRankTiles_)),
+      sharedTiles_(std::move(other.sharedTiles_)),
+      layout_(std::exchange(other.layout_, TileLayout::RowMajor)),
+      mortonIndex_(std::move(other.mortonIndex_)),
+      mortonPosition_(std::move(other.mortonPosition_)) {}
 
 template <typename MatrixType>
 inline BlockMatrix<MatrixType>& BlockMatrix<MatrixType>::operator=(const BlockMatrix<MatrixType>& other) {
     if (this != &other) {
-        BlockMatrix temp(other);  
-        std::swap(*this, temp);   
+        BlockMatrix temp(other);
+        *this = std::move(temp);
     }
 
     return *this;
@@ -584,9 +2058,19 @@ inline BlockMatrix<MatrixType>& BlockMatrix<MatrixType>::operator=(BlockMatrix<M
         cols_ = std::exchange(other.cols_, 0);
         blockRows_ = std::exchange(other.blockRows_, 0);
         blockCols_ = std::exchange(other.blockCols_, 0);
-        data_ = std::move(other.data_);
-
-        other.data_ = nullptr;
+        numBlocksRow_ = std::exchange(other.numBlocksRow_, 0);
+        numBlocksCol_ = std::exchange(other.numBlocksCol_, 0);
+        arena_ = std::move(other.arena_);
+        kinds_ = std::move(other.kinds_);
+        slots_ = std::move(other.slots_);
+        freeSlots_ = std::move(other.freeSlots_);
+        usedSlots_ = std::exchange(other.usedSlots_, 0);
+        sparseTiles_ = std::move(other.sparseTiles_);
+        lowRankTiles_ = std::move(other.lowRankTiles_);
+        sharedTiles_ = std::move(other.sharedTiles_);
+        layout_ = std::exchange(other.layout_, TileLayout::RowMajor);
+        mortonIndex_ = std::move(other.mortonIndex_);
+        mortonPosition_ = std::move(other.mortonPosition_);
     }
 
     return *this;
@@ -597,17 +2081,55 @@ inline Matrix<MatrixType> BlockMatrix<MatrixType>::operator()(const size_t block
     return getBlock(blockRow, blockCol);
 }
 
+template<typename MatrixType>
+inline Matrix<MatrixType> BlockMatrix<MatrixType>::toMatrix() const {
+    Matrix<MatrixType> result(rows_, cols_);
+    copyToView(result.view());
+
+    return result;
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::copyToView(const MatrixView<MatrixType>& target) const {
+    if (target.getRows() != rows_ || target.getCols() != cols_)
+        throw std::invalid_argument("View has incompatible dimensions");
+
+    parallelFor(0, numBlocksRow_ * numBlocksCol_, [&](size_t t) {
+        const size_t i = t / numBlocksCol_;
+        const size_t j = t % numBlocksCol_;
+        const size_t index = tileIndex(i, j);
+
+        if (kinds_[index] == TileKind::Zero) {
+            for (size_t r = 0; r < validRows(i); ++r) {
+                MatrixType* row = target.getRowData(i * blockRows_ + r) + j * blockCols_;
+                std::fill(row, row + validCols(j), static_cast<MatrixType>(0));
+            }
+            return;
+        }
+
+        std::vector<MatrixType> expanded;
+        const MatrixType* tile = tileData(index);
+        if (tile == nullptr) {
+            expanded.assign(blockRows_ * blockCols_, static_cast<MatrixType>(0));
+            expandTile(index, static_cast<MatrixType>(1), expanded.data(), blockCols_);
+            tile = expanded.data();
+        }
+
+        for (size_t r = 0; r < validRows(i); ++r)
+            std::copy(tile + r * blockCols_, tile + r * blockCols_ + validCols(j),
+                      target.getRowData(i * blockRows_ + r) + j * blockCols_);
+    }, 1);
+}
+
 template<typename MatrixType>
 BlockMatrix<MatrixType> BlockMatrix<MatrixType>::operator+(const BlockMatrix<MatrixType>& other) const {
     if (rows_!= other.rows_ || cols_!= other.cols_)
         throw std::invalid_argument("Matrices have different sizes");
 
-    BlockMatrix result(rows_, cols_, blockRows_, blockCols_);template<typename MatrixType>
+    if (!sameLayout(other)) return *this + conformed(other);
 
-    for (size_t i = 0; i < numBlocksRow; ++i) {
-        for (size_t j = 0; j < numBlocksCol; ++j) 
-            result.data_[i][j] = data_[i][j] + other.data_[i][j];
-    }
+    BlockMatrix result(*this);
+    result.addScaledBlockMatrix(other, static_cast<MatrixType>(1));
 
     return result;
 }
@@ -617,17 +2139,120 @@ BlockMatrix<MatrixType> BlockMatrix<MatrixType>::operator-(const BlockMatrix<Mat
     if (rows_!= other.rows_ || cols_!= other.cols_)
         throw std::invalid_argument("Matrices have different sizes");
 
-    BlockMatrix result(rows_, cols_, blockRows_, blockCols_);
+    if (!sameLayout(other)) return *this - conformed(other);
 
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
+    BlockMatrix result(*this);
+    result.addScaledBlockMatrix(other, static_cast<MatrixType>(-1));
 
-    for (size_t i = 0; i < numBlocksRow; ++i) {
-        for (size_t j = 0; j < numBlocksCol; ++j) 
-            result.data_[i][j] = data_[i][j] - other.data_[i][j];
+    return result;
+}
+
+template<typename MatrixType>
+inline void BlockMatrix<MatrixType>::multiplyAddBlockMatrix(const BlockMatrix<MatrixType>& a, const BlockMatrix<MatrixType>& b) {
+    multiplyAddBlockMatrix(a, b, false, false);
+}
+
+template<typename MatrixType>
+void BlockMatrix<MatrixType>::multiplyAddBlockMatrix(const BlockMatrix<MatrixType>& a, const BlockMatrix<MatrixType>& b,
+                                                     bool transposeA, bool transposeB) {
+    const size_t aRows = transposeA ? a.cols_ : a.rows_;
+    const size_t aCols = transposeA ? a.rows_ : a.cols_;
+    const size_t bRows = transposeB ? b.cols_ : b.rows_;
+    const size_t bCols = transposeB ? b.rows_ : b.cols_;
+    if (aCols != bRows || rows_ != aRows || cols_ != bCols)
+        throw std::invalid_argument("Matrix dimensions are incompatible for multiplication");
+
+    const size_t aBlockRows = transposeA ? a.blockCols_ : a.blockRows_;
+    const size_t depth = transposeA ? a.blockRows_ : a.blockCols_;
+    const size_t bBlockRows = transposeB ? b.blockCols_ : b.blockRows_;
+    const size_t bBlockCols = transposeB ? b.blockRows_ : b.blockCols_;
+    if (depth != bBlockRows || blockRows_ != aBlockRows || blockCols_ != bBlockCols)
+        throw std::invalid_argument("Block sizes are incompatible for multiplication");
+
+    if (this == &a || this == &b) {
+        BlockMatrix product(rows_, cols_, blockRows_, blockCols_);
+        product.multiplyAddBlockMatrix(a, b, transposeA, transposeB);
+        *this += product;
+        return;
     }
 
-    return result;
+    arena();
+
+    const size_t steps = transposeA ? a.numBlocksRow_ : a.numBlocksCol_;
+    auto leftIndex = [&a, transposeA](size_t i, size_t k) { return transposeA ? a.tileIndex(k, i) : a.tileIndex(i, k); };
+    auto rightIndex = [&b, transposeB](size_t k, size_t j) { return transposeB ? b.tileIndex(j, k) : b.tileIndex(k, j); };
+
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            size_t pairs = 0;
+            bool identity = true;
+
+            for (size_t k = 0; k < steps; ++k) {
+                const TileKind left = a.kinds_[leftIndex(i, k)];
+                const TileKind right = b.kinds_[rightIndex(k, j)];
+                if (left == TileKind::Zero || right == TileKind::Zero) continue;
+
+                ++pairs;
+                identity = identity && left == TileKind::Identity && right == TileKind::Identity;
+            }
+
+            if (pairs == 0) continue;
+
+            if (pairs == 1 && identity && kinds_[tileIndex(i, j)] == TileKind::Zero) {
+                kinds_[tileIndex(i, j)] = TileKind::Identity;
+                continue;
+            }
+
+            materializeTile(tileIndex(i, j));
+            targets.push_back(i * numBlocksCol_ + j);
+        }
+
+    TaskPool& pool = sharedTaskPool();
+    TaskGroup group;
+
+    // Плотная плитка op(x) по строкам с шагом, равным ее ширине.
+    auto operand = [](const BlockMatrix& x, size_t index, bool transpose,
+                      std::vector<MatrixType>& expanded, std::vector<MatrixType>& transposed) {
+        const MatrixType* source = x.tileData(index);
+        if (source == nullptr) {
+            expanded.assign(x.blockRows_ * x.blockCols_, static_cast<MatrixType>(0));
+            x.expandTile(index, static_cast<MatrixType>(1), expanded.data(), x.blockCols_);
+            source = expanded.data();
+        }
+        if (!transpose) return source;
+
+        transposed.resize(x.blockRows_ * x.blockCols_);
+        transposeTile(source, transposed.data(), x.blockRows_, x.blockCols_, x.blockCols_, x.blockRows_);
+        return static_cast<const MatrixType*>(transposed.data());
+    };
+
+    for (size_t target : targets) {
+        pool.submit(group, [=, &a, &b] {
+            const size_t i = target / numBlocksCol_;
+            const size_t j = target % numBlocksCol_;
+            MatrixType* c = arena().tile(slots_[tileIndex(i, j)]);
+            std::vector<MatrixType> scratch, leftExpanded, leftTransposed, rightExpanded, rightTransposed;
+
+            for (size_t k = 0; k < steps; ++k) {
+                const size_t left = leftIndex(i, k);
+                const size_t right = rightIndex(k, j);
+                if (a.kinds_[left] == TileKind::Zero || b.kinds_[right] == TileKind::Zero) continue;
+
+                if (!transposeA && !transposeB) {
+                    multiplyAddTile(a, left, b, right, validRows(i), a.validCols(k), validCols(j), c, scratch);
+                    continue;
+                }
+
+                const MatrixType* leftTile = operand(a, left, transposeA, leftExpanded, leftTransposed);
+                const MatrixType* rightTile = operand(b, right, transposeB, rightExpanded, rightTransposed);
+                packTilePanel(leftTile, blockRows_, depth, depth, scratch);
+                multiplyAddPackedTile(scratch.data(), rightTile, c, blockRows_, depth, blockCols_, blockCols_, blockCols_);
+            }
+        });
+    }
+
+    pool.wait(group);
 }
 
 template<typename MatrixType>
@@ -635,34 +2260,108 @@ BlockMatrix<MatrixType> BlockMatrix<MatrixType>::operator*(const BlockMatrix<Mat
     if (cols_ != other.rows_)
         throw std::invalid_argument("Matrix dimensions are incompatible for multiplication");
 
+    if (blockCols_ != other.blockRows_) {
+        BlockMatrix right(other.toMatrix(), blockCols_, other.blockCols_);
+        right.setTileLayout(layout_);
+        return *this * right;
+    }
+
     BlockMatrix result(rows_, other.cols_, blockRows_, other.blockCols_);
+    result.setTileLayout(layout_);
+    result.multiplyAddBlockMatrix(*this, other);
 
-    size_t numBlocksRowA = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksColA = (cols_ + blockCols_ - 1) / blockCols_;
-    size_t numBlocksColB = (other.cols_ + other.blockCols_ - 1) / other.blockCols_;
+    return result;
+}
 
-    for (size_t i = 0; i < numBlocksRowA; ++i) {
-        for (size_t j = 0; j < numBlocksColB; ++j) {
-            for (size_t k = 0; k < numBlocksColA; ++k) {
-                result.data_[i][j] += data_[i][k] * other.data_[k][j];
-            }
-        }
-    }
+template<typename MatrixType>
+BlockMatrix<MatrixType> BlockMatrix<MatrixType>::multiplyStrassenBlockMatrix(const BlockMatrix<MatrixType>& other, size_t crossover) const {
+    if (cols_ != other.rows_)
+        throw std::invalid_argument("Matrix dimensions are incompatible for multiplication");
+    if (blockCols_ != other.blockRows_)
+        throw std::invalid_argument("Block sizes are incompatible for multiplication");
+    if (crossover == 0)
+        throw std::invalid_argument("Strassen crossover must be positive");
+
+    const size_t extent = std::max({ numBlocksRow_, numBlocksCol_, other.numBlocksCol_ });
+    if (extent <= crossover) return *this * other;
+
+    StrassenGrid grid{ 0, extent, blockRows_, blockCols_, other.blockCols_ };
+    size_t levels = 0;
+    for (; grid.leaf > crossover; ++levels) grid.leaf = (grid.leaf + 1) / 2;
+    grid.side = grid.leaf << levels;
+
+    std::vector<MatrixType> left(grid.leftSize(grid.side), static_cast<MatrixType>(0));
+    std::vector<MatrixType> right(grid.rightSize(grid.side), static_cast<MatrixType>(0));
+    std::vector<MatrixType> product(grid.resultSize(grid.side));
+
+    auto gather = [&grid](const BlockMatrix& source, std::vector<MatrixType>& target) {
+        const size_t size = source.blockRows_ * source.blockCols_;
+        parallelFor(0, source.kinds_.size(), [&](size_t t) {
+            const size_t i = t / source.numBlocksCol_;
+            const size_t j = t % source.numBlocksCol_;
+            MatrixType* tile = target.data() + strassenTileOffset(i, j, grid.side, grid.leaf) * size;
+            source.expandTile(source.tileIndex(i, j), static_cast<MatrixType>(1), tile, source.blockCols_);
+        }, 1);
+    };
+    gather(*this, left);
+    gather(other, right);
+
+    strassenMultiplyTilesParallel(left.data(), right.data(), product.data(), grid);
+
+    BlockMatrix result(rows_, other.cols_, blockRows_, other.blockCols_);
+    result.setTileLayout(layout_);
+    const size_t size = result.blockRows_ * result.blockCols_;
+    auto productTile = [&](size_t i, size_t j) {
+        return product.data() + strassenTileOffset(i, j, grid.side, grid.leaf) * size;
+    };
+
+    parallelFor(0, result.kinds_.size(), [&](size_t t) {
+        const size_t i = t / result.numBlocksCol_;
+        const size_t j = t % result.numBlocksCol_;
+        const MatrixType* tile = productTile(i, j);
+        result.kinds_[result.tileIndex(i, j)] = classifyRegion(result.validRows(i), result.validCols(j), [&](size_t r, size_t c) {
+            return tile[r * result.blockCols_ + c];
+        });
+    }, 1);
+
+    size_t dense = 0;
+    for (size_t t = 0; t < result.kinds_.size(); ++t)
+        if (result.kinds_[t] == TileKind::Dense) result.slots_[t] = dense++;
+
+    result.arena().resizeTiles(dense);
+    result.usedSlots_ = dense;
+
+    parallelFor(0, result.kinds_.size(), [&](size_t t) {
+        const size_t i = t / result.numBlocksCol_;
+        const size_t j = t % result.numBlocksCol_;
+        const size_t index = result.tileIndex(i, j);
+        if (result.kinds_[index] != TileKind::Dense) return;
+
+        MatrixType* tile = result.arena().tile(result.slots_[index]);
+        std::copy(productTile(i, j), productTile(i, j) + size, tile);
+    }, 1);
 
     return result;
 }
 
 template<typename MatrixType>
 BlockMatrix<MatrixType> BlockMatrix<MatrixType>::operator*(const MatrixType& scalar) const {
-    BlockMatrix result(rows_, cols_, blockRows_, blockCols_);
+    if (scalar == static_cast<MatrixType>(0)) return BlockMatrix(rows_, cols_, blockRows_, blockCols_);
 
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
+    BlockMatrix result(*this);
+    if (scalar == static_cast<MatrixType>(1)) return result;
 
-    for (size_t i = 0; i < numBlocksRow; ++i) {
-        for (size_t j = 0; j < numBlocksCol; ++j) 
-            result.data_[i][j] = scalar * data_[i][j];
-    }
+    for (size_t t = 0; t < result.kinds_.size(); ++t)
+        if (result.kinds_[t] == TileKind::Identity || result.kinds_[t] == TileKind::Shared) result.materializeTile(t);
+
+    for (auto& entry : result.sparseTiles_)
+        for (MatrixType& value : entry.second.values) value *= scalar;
+
+    for (auto& entry : result.lowRankTiles_)
+        for (MatrixType& value : entry.second.u) value *= scalar;
+
+    MatrixType* out = result.arena().data();
+    for (size_t k = 0; k < result.arena().size(); ++k) out[k] *= scalar;
 
     return result;
 }
@@ -671,14 +2370,25 @@ template<typename MatrixType>
 bool BlockMatrix<MatrixType>::operator==(const BlockMatrix<MatrixType>& other) const {
     if (rows_!= other.rows_ || cols_!= other.cols_) return false;
 
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
+    if (!sameLayout(other)) {
+        for (size_t i = 0; i < rows_; ++i)
+            for (size_t j = 0; j < cols_; ++j)
+                if (getValue(i, j) != other.getValue(i, j)) return false;
 
-    for (size_t i = 0; i < numBlocksRow; ++i) {
-        for (size_t j = 0; j < numBlocksCol; ++j) 
-            if (data_[i][j] != other.data_[i][j]) return false;
+        return true;
     }
 
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const size_t index = tileIndex(i, j);
+            const TileKind kind = kinds_[index];
+            if ((kind == TileKind::Zero || kind == TileKind::Identity) && kind == other.kinds_[index]) continue;
+
+            for (size_t r = 0; r < validRows(i); ++r)
+                for (size_t c = 0; c < validCols(j); ++c)
+                    if (elementAt(index, r, c) != other.elementAt(index, r, c)) return false;
+        }
+
     return true;
 }
 
@@ -713,29 +2423,26 @@ inline BlockMatrix<MatrixType>& BlockMatrix<MatrixType>::operator*=(const Matrix
 
 template<typename MatrixType>
 void BlockMatrix<MatrixType>::printBlockMatrix() const {
-    size_t numBlocksRow = (rows_ + blockRows_ - 1) / blockRows_;
-    size_t numBlocksCol = (cols_ + blockCols_ - 1) / blockCols_;
-
-    for (size_t i = 0; i < numBlocksRow; ++i) {
-        for (size_t j = 0; j < numBlocksCol; ++j) {
+    for (size_t i = 0; i < numBlocksRow_; ++i) {
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
             std::cout << "Block (" << i << ", " << j << "):\n";
-            std::cout << data_[i][j] << "\n";  
+            std::cout << getBlock(i, j) << "\n";
         }
-        std::cout << std::string(40, '-') << "\n";  
+        std::cout << std::string(40, '-') << "\n";
     }
 }
 
 template<typename MatrixType>
-inline void BlockMatrix<MatrixType>::sumBlockMatrix(const BlockMatrix<MatrixType>& other) { this += other; }
+inline void BlockMatrix<MatrixType>::sumBlockMatrix(const BlockMatrix<MatrixType>& other) { *this += other; }
 
 template<typename MatrixType>
-inline void BlockMatrix<MatrixType>::subBlockMatrix(const BlockMatrix<MatrixType>& other) { this -= other; }
+inline void BlockMatrix<MatrixType>::subBlockMatrix(const BlockMatrix<MatrixType>& other) { *this -= other; }
 
 template<typename MatrixType>
-inline void BlockMatrix<MatrixType>::mulBlockMatrix(const BlockMatrix<MatrixType>& other) { this *= other; }
+inline void BlockMatrix<MatrixType>::mulBlockMatrix(const BlockMatrix<MatrixType>& other) { *this *= other; }
 
 template<typename MatrixType>
-inline void BlockMatrix<MatrixType>::mulBlockScalar(const MatrixType& scalar) { this *= scalar; }
+inline void BlockMatrix<MatrixType>::mulBlockScalar(const MatrixType& scalar) { *this *= scalar; }
 
 template<typename MatrixType>
 inline BlockMatrix<MatrixType> BlockMatrix<MatrixType>::sumBlockMatrix(const BlockMatrix<MatrixType>& mat1, const BlockMatrix<MatrixType>& mat2) const {
@@ -762,8 +2469,8 @@ bool BlockMatrix<MatrixType>::isSymmetric() const {
     if (rows_ != cols_) return false;
 
     for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = i + 1; j < cols_; ++j) 
-            if (data_[i][j] != data_[j][i]) return false;
+        for (size_t j = i + 1; j < cols_; ++j)
+            if (getValue(i, j) != getValue(j, i)) return false;
     }
 
     return true;
@@ -775,162 +2482,682 @@ inline bool BlockMatrix<MatrixType>::isSquareBlockMatrix() const { return rows_
 template<typename MatrixType>
 double BlockMatrix<MatrixType>::frobeniusNorm() const {
     double sum = 0.0;
+    const MatrixType* data = arena().data();
+
+    for (size_t k = 0; k < arena().size(); ++k) sum += static_cast<double>(data[k]) * static_cast<double>(data[k]);
+
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j)
+            if (kinds_[tileIndex(i, j)] == TileKind::Identity) sum += static_cast<double>(validRows(i));
+
+    for (const auto& entry : sparseTiles_)
+        for (MatrixType value : entry.second.values) sum += static_cast<double>(value) * static_cast<double>(value);
+
+    for (const auto& entry : sharedTiles_) {
+        const MatrixType* tile = entry.second.data();
+        for (size_t k = 0; k < blockRows_ * blockCols_; ++k) sum += static_cast<double>(tile[k]) * static_cast<double>(tile[k]);
+    }
+
+    for (const auto& entry : lowRankTiles_)
+        for (size_t r = 0; r < entry.second.height; ++r)
+            for (size_t c = 0; c < entry.second.width; ++c) {
+                const double value = static_cast<double>(lowRankElement(entry.second, r, c));
+                sum += value * value;
+            }
 
-    for (size_t i = 0; i < getBlockCount(); ++i) 
-        for (size_t j = 0; j < getBlockCount(); ++j) sum += data_[i][j].frobeniusNorm(); 
-        
     return std::sqrt(sum);
 }
 
 template <typename MatrixType>
 inline size_t BlockMatrix<MatrixType>::getBlockCount() const {
-    return (rows_ + blockRows_ - 1) / blockRows_ * (cols_ + blockCols_ - 1) / blockCols_;
+    return numBlocksRow_ * numBlocksCol_;
 }
 
 template <typename MatrixType>
 void BlockMatrix<MatrixType>::transposeBlockMatrix() {
-    if (rows_ != cols_)
-        throw std::invalid_argument("Only square block matrices can be transposed.");
+    arena();
+    for (size_t t = 0; t < kinds_.size(); ++t)
+        if (kinds_[t] == TileKind::Shared) materializeTile(t);
+
+    // from[p] — прежний номер блока, который станет блоком на позиции p транспонированной сетки.
+    std::vector<size_t> from(kinds_.size());
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const size_t index = tileIndex(i, j);
+            from[j * numBlocksRow_ + i] = index;
+
+            if (kinds_[index] == TileKind::Sparse) {
+                sparseTiles_[index] = transposeCompressedTile(sparseTiles_.at(index), validCols(j));
+            } else if (kinds_[index] == TileKind::LowRank) {
+                LowRankTile<MatrixType>& tile = lowRankTiles_.at(index);
+                std::swap(tile.u, tile.v);
+                std::swap(tile.height, tile.width);
+            }
+        }
 
-    for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = i + 1; j < cols_; ++j) 
-            std::swap(data_[i][j], data_[j][i]);
+    const size_t height = blockRows_;
+    const size_t width = blockCols_;
+    std::swap(rows_, cols_);
+    std::swap(blockRows_, blockCols_);
+    std::swap(numBlocksRow_, numBlocksCol_);
+    buildLayout();
+
+    std::vector<TileKind> kinds(kinds_.size());
+    std::vector<size_t> slots(slots_.size());
+    std::unordered_map<size_t, CompressedRows<MatrixType>> sparse;
+    std::unordered_map<size_t, LowRankTile<MatrixType>> lowRank;
+
+    for (size_t p = 0; p < from.size(); ++p) {
+        const size_t to = tileIndex(p / numBlocksCol_, p % numBlocksCol_);
+        kinds[to] = kinds_[from[p]];
+        slots[to] = slots_[from[p]];
+
+        if (kinds[to] == TileKind::Sparse) sparse.emplace(to, std::move(sparseTiles_.at(from[p])));
+        else if (kinds[to] == TileKind::LowRank) lowRank.emplace(to, std::move(lowRankTiles_.at(from[p])));
     }
+
+    kinds_ = std::move(kinds);
+    slots_ = std::move(slots);
+    sparseTiles_ = std::move(sparse);
+    lowRankTiles_ = std::move(lowRank);
+
+    parallelFor(0, kinds_.size(), [&](size_t t) {
+        if (kinds_[t] != TileKind::Dense) return;
+
+        MatrixType* tile = arena().tile(slots_[t]);
+        if (height == width) {
+            transposeSquareTile(tile, height, width);
+            return;
+        }
+
+        const std::vector<MatrixType> source(tile, tile + height * width);
+        transposeTile(source.data(), tile, height, width, width, height);
+    }, 1);
+}
+
+template <typename MatrixType>
+BlockMatrix<MatrixType> BlockMatrix<MatrixType>::transposedBlockMatrix() const {
+    BlockMatrix result(cols_, rows_, blockCols_, blockRows_);
+    result.setTileLayout(layout_);
+
+    size_t dense = 0;
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const size_t from = tileIndex(i, j);
+            const size_t to = result.tileIndex(j, i);
+            result.kinds_[to] = kinds_[from];
+
+            if (tileData(from) != nullptr) {
+                result.kinds_[to] = TileKind::Dense;
+                result.slots_[to] = dense++;
+            } else if (kinds_[from] == TileKind::Sparse) {
+                result.sparseTiles_.emplace(to, transposeCompressedTile(sparseTiles_.at(from), validCols(j)));
+            } else if (kinds_[from] == TileKind::LowRank) {
+                const LowRankTile<MatrixType>& tile = lowRankTiles_.at(from);
+                result.lowRankTiles_.emplace(to, LowRankTile<MatrixType>{ tile.width, tile.height, tile.rank, tile.v, tile.u });
+            }
+        }
+
+    result.arena().resizeTiles(dense);
+    result.usedSlots_ = dense;
+
+    TileArena<MatrixType>& target = result.arena();
+    parallelFor(0, kinds_.size(), [&](size_t from) {
+        const MatrixType* source = tileData(from);
+        if (source == nullptr) return;
+
+        const size_t i = tilePosition(from) / numBlocksCol_;
+        const size_t j = tilePosition(from) % numBlocksCol_;
+        transposeTile(source, target.tile(result.slots_[result.tileIndex(j, i)]), blockRows_, blockCols_, blockCols_, blockRows_);
+    }, 1);
+
+    return result;
 }
 
 template <typename MatrixType>
 BlockMatrix<MatrixType> BlockMatrix<MatrixType>::concat(const BlockMatrix<MatrixType>& other, bool horizontal) const {
-    if (horizontal) {
+    if (horizontal && rows_ != other.rows_)
+        throw std::invalid_argument("Row counts must match for horizontal concatenation.");
 
-        if (rows_ != other.rows_)
-            throw std::invalid_argument("Row counts must match for horizontal concatenation.");
+    if (!horizontal && cols_ != other.cols_)
+        throw std::invalid_argument("Column counts must match for vertical concatenation.");
 
-        BlockMatrix result(rows_, cols_ + other.cols_, blockRows_, blockCols_);
+    if (horizontal) return assembleBlockMatrix({ { *this, other } });
 
-        for (size_t i = 0; i < rows_; ++i) {
-            for (size_t j = 0; j < cols_; ++j) 
-                result.data_[i][j] = data_[i][j];
-            
-            for (size_t j = 0; j < other.cols_; ++j) 
-                result.data_[i][j + cols_] = other.data_[i][j];
+    return assembleBlockMatrix({ { *this }, { other } });
+}
+
+template <typename MatrixType>
+BlockMatrix<MatrixType> BlockMatrix<MatrixType>::assembleBlockMatrix(
+    const std::vector<std::vector<std::reference_wrapper<const BlockMatrix<MatrixType>>>>& grid) {
+    if (grid.empty() || grid[0].empty())
+        throw std::invalid_argument("Block grid must not be empty.");
+
+    const BlockMatrix& first = grid[0][0];
+    std::vector<size_t> rowOffsets(grid.size() + 1, 0), colOffsets(grid[0].size() + 1, 0);
+    bool aligned = true;
+
+    for (size_t p = 0; p < grid.size(); ++p) {
+        if (grid[p].size() != grid[0].size())
+            throw std::invalid_argument("Every row of the block grid must have the same number of parts.");
+
+        for (size_t q = 0; q < grid[p].size(); ++q) {
+            const BlockMatrix& part = grid[p][q];
+            if (part.rows_ != grid[p][0].get().rows_)
+                throw std::invalid_argument("Row counts must match within a row of the block grid.");
+            if (part.cols_ != grid[0][q].get().cols_)
+                throw std::invalid_argument("Column counts must match within a column of the block grid.");
+
+            aligned = aligned && part.blockRows_ == first.blockRows_ && part.blockCols_ == first.blockCols_;
         }
 
-        return result;
-        
-    } else {
-
-        if (cols_ != other.cols_)
-            throw std::invalid_argument("Column counts must match for vertical concatenation.");
-
-        BlockMatrix result(rows_ + other.rows_, cols_, blockRows_, blockCols_);
-
-        for (size_t i = 0; i < rows_; ++i) 
-            for (size_t j = 0; j < cols_; ++j) result.data_[i][j] = data_[i][j];
-            
-        
-        for (size_t i = 0; i < other.rows_; ++i) 
-            for (size_t j = 0; j < cols_; ++j) result.data_[i + rows_][j] = other.data_[i][j];
-            
-        
-        return result;
+        rowOffsets[p + 1] = rowOffsets[p] + grid[p][0].get().rows_;
     }
+
+    for (size_t q = 0; q < grid[0].size(); ++q) colOffsets[q + 1] = colOffsets[q] + grid[0][q].get().cols_;
+
+    for (size_t p = 0; p + 1 < grid.size(); ++p) aligned = aligned && rowOffsets[p + 1] % first.blockRows_ == 0;
+    for (size_t q = 0; q + 1 < grid[0].size(); ++q) aligned = aligned && colOffsets[q + 1] % first.blockCols_ == 0;
+
+    BlockMatrix result(rowOffsets.back(), colOffsets.back(), first.blockRows_, first.blockCols_);
+    result.setTileLayout(first.layout_);
+
+    for (size_t p = 0; p < grid.size(); ++p)
+        for (size_t q = 0; q < grid[p].size(); ++q) {
+            const BlockMatrix& source = grid[p][q];
+
+            if (!aligned) {
+                for (size_t i = 0; i < source.numBlocksRow_; ++i)
+                    for (size_t j = 0; j < source.numBlocksCol_; ++j) {
+                        const size_t index = source.tileIndex(i, j);
+                        if (source.kinds_[index] == TileKind::Zero) continue;
+
+                        for (size_t r = 0; r < source.validRows(i); ++r)
+                            for (size_t c = 0; c < source.validCols(j); ++c)
+                                result.setValue(rowOffsets[p] + i * source.blockRows_ + r, colOffsets[q] + j * source.blockCols_ + c,
+                                                source.elementAt(index, r, c));
+                    }
+                continue;
+            }
+
+            const size_t rowShift = rowOffsets[p] / first.blockRows_;
+            const size_t colShift = colOffsets[q] / first.blockCols_;
+
+            for (size_t i = 0; i < source.numBlocksRow_; ++i)
+                for (size_t j = 0; j < source.numBlocksCol_; ++j) {
+                    const size_t from = source.tileIndex(i, j);
+                    const size_t to = result.tileIndex(i + rowShift, j + colShift);
+
+                    switch (source.kinds_[from]) {
+                        case TileKind::Dense:
+                            result.sharedTiles_[to] = SharedTile<MatrixType>{ source.arena_, source.slots_[from] };
+                            result.kinds_[to] = TileKind::Shared;
+                            continue;
+                        case TileKind::Shared:
+                            result.sharedTiles_[to] = source.sharedTiles_.at(from);
+                            break;
+                        case TileKind::Sparse:
+                            result.sparseTiles_[to] = source.sparseTiles_.at(from);
+                            break;
+                        case TileKind::LowRank:
+                            result.lowRankTiles_[to] = source.lowRankTiles_.at(from);
+                            break;
+                        default:
+                            break;
+                    }
+
+                    result.kinds_[to] = source.kinds_[from];
+                }
+        }
+
+    return result;
 }
 
 template<typename MatrixType>
-MatrixType findMaxElementBlockMamtrix() noexcept {
+MatrixType BlockMatrix<MatrixType>::findMaxElementBlockMatrix() const noexcept {
+    auto better = [](MatrixType candidate, MatrixType best) { return candidate > best; };
     MatrixType maxElement = MIN_VALUE(MatrixType);
 
-    for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = 0; j < cols_; ++j) {
-            MatrixType maxInBlock = data_[i][j].findMaxElement()
-            if (maxInBlock > maxElement) maxElement = maxInBlock;
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const MatrixType candidate = tileExtreme(i, j, better);
+            if ((i == 0 && j == 0) || better(candidate, maxElement)) maxElement = candidate;
         }
-    }
 
     return maxElement;
 }
 
 template<typename MatrixType>
-MatrixType findMinElementBlockMatrix() noexcept {
+MatrixType BlockMatrix<MatrixType>::findMinElementBlockMatrix() const noexcept {
+    auto better = [](MatrixType candidate, MatrixType best) { return candidate < best; };
     MatrixType minElement = MAX_VALUE(MatrixType);
 
-    for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = 0; j < cols_; ++j) {
-            MatrixType minInBlock = data_[i][j].findMinElement()
-            if (minInBlock < minElement) minElement = minInBlock;
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const MatrixType candidate = tileExtreme(i, j, better);
+            if (better(candidate, minElement)) minElement = candidate;
         }
-    }
 
     return minElement;
 }
 
 template<typename MatrixType>
 Matrix<MatrixType> BlockMatrix<MatrixType>::findMaxElementBlockMatrixBlock() const noexcept {
-    Matrix<MatrixType> res = data_[0][0];
-    MatrixType resMaxElement = data_[0][0].findMaxElement();
+    auto better = [](MatrixType candidate, MatrixType best) { return candidate > best; };
+    const MatrixType maxElement = findMaxElementBlockMatrix();
 
-    for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = 0; j < cols_; ++j) {
-            Matrix<MatrixType> curBlock = data_[i][j];
-            MatrixType curMaxElement = curBlock.findMaxElement();
-            if (curMaxElement > resMaxElement) {
-                res = curBlock;
-                resMaxElement = curMaxElement;
-            }
-        }
-    }
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j)
+            if (tileExtreme(i, j, better) == maxElement) return getBlock(i, j);
 
-    return res;
+    return Matrix<MatrixType>(0, 0);
 }
 
-
 template<typename MatrixType>
 Matrix<MatrixType> BlockMatrix<MatrixType>::findMinElementBlockMatrixBlock() const noexcept {
-    Matrix<MatrixType> res = data_[0][0];
-    MatrixType resMinElement = data_[0][0].findMinElement();
+    auto better = [](MatrixType candidate, MatrixType best) { return candidate < best; };
+    const MatrixType minElement = findMinElementBlockMatrix();
 
-    for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = 0; j < cols_; ++j) {
-            Matrix<MatrixType> curBlock = data_[i][j];
-            MatrixType curMinElement = curBlock.findMinElement();
-            if (curMinElement < resMinElement) {
-                res = curBlock;
-                resMinElement = curMinElement;
-            }
-        }
-    }
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j)
+            if (tileExtreme(i, j, better) == minElement) return getBlock(i, j);
 
-    return res;
+    return Matrix<MatrixType>(0, 0);
 }
 
 template <typename MatrixType>
 MatrixType BlockMatrix<MatrixType>::dotProduct(const BlockMatrix<MatrixType>& other) const {
+    if (rows_ != other.rows_ || cols_ != other.cols_)
+        throw std::invalid_argument("Matrices have different sizes");
+
     MatrixType result = static_cast<MatrixType>(0);
 
-    for (size_t i = 0; i < getBlockRows(); ++i) 
-        for (size_t j = 0; j < getBlockCols(); ++j) result += (this->getBlock(i, j) * other.getBlock(i, j)).findSumElements();
-    
+    if (!sameLayout(other)) {
+        for (size_t i = 0; i < rows_; ++i)
+            for (size_t j = 0; j < cols_; ++j) result += getValue(i, j) * other.getValue(i, j);
+
+        return result;
+    }
+
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j) {
+            const size_t index = tileIndex(i, j);
+            if (kinds_[index] == TileKind::Zero || other.kinds_[index] == TileKind::Zero) continue;
+
+            const MatrixType* a = tileData(index);
+            const MatrixType* b = other.tileData(index);
+            if (a != nullptr && b != nullptr) {
+                for (size_t k = 0; k < blockRows_ * blockCols_; ++k) result += a[k] * b[k];
+                continue;
+            }
+
+            if (kinds_[index] == TileKind::Identity || other.kinds_[index] == TileKind::Identity) {
+                for (size_t r = 0; r < std::min(validRows(i), validCols(j)); ++r)
+                    result += kinds_[index] == TileKind::Identity ? other.elementAt(index, r, r) : elementAt(index, r, r);
+                continue;
+            }
+
+            for (size_t r = 0; r < validRows(i); ++r)
+                for (size_t c = 0; c < validCols(j); ++c) result += elementAt(index, r, c) * other.elementAt(index, r, c);
+        }
+
     return result;
 }
 
 template <typename MatrixType>
 BlockMatrix<MatrixType> BlockMatrix<MatrixType>::powBlockMatrix(int exp) const {
-    if (!isSquareBlockMatrix()) 
+    if (!isSquareBlockMatrix())
         throw std::invalid_argument("Matrix must be square to raise to a power.");
-    
-    BlockMatrix<MatrixType> result(*this); 
+
+    if (exp < 0)
+        throw std::invalid_argument("Exponent must be non-negative.");
+
+    if (blockRows_ != blockCols_)
+        throw std::invalid_argument("Blocks must be square to raise to a power.");
+
+    BlockMatrix<MatrixType> result(rows_, cols_, blockRows_, blockCols_);
+    result.setTileLayout(layout_);
+    for (size_t i = 0; i < numBlocksRow_; ++i) result.kinds_[result.tileIndex(i, i)] = TileKind::Identity;
+
     BlockMatrix<MatrixType> base(*this);
+    for (; exp > 0; exp >>= 1) {
+        if (exp & 1) result = result * base;
+        if (exp > 1) base = base * base;
+    }
+
+    return result;
+}
+
+template <typename MatrixType>
+void BlockMatrix<MatrixType>::factorizeLUBlockMatrix() {
+    static_assert(std::is_floating_point<MatrixType>::value, "LU factorization requires a floating-point type.");
+
+    if (rows_ != cols_ || blockRows_ != blockCols_)
+        throw std::invalid_argument("LU factorization requires a square matrix with square blocks.");
+
+    const size_t count = numBlocksRow_;
+    const size_t ld = blockCols_;
+
+    std::vector<char> nonzero(count * count);
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j < count; ++j) nonzero[i * count + j] = i == j || kinds_[tileIndex(i, j)] != TileKind::Zero;
+
+    for (size_t k = 0; k < count; ++k)
+        for (size_t i = k + 1; i < count; ++i)
+            if (nonzero[i * count + k])
+                for (size_t j = k + 1; j < count; ++j)
+                    if (nonzero[k * count + j]) nonzero[i * count + j] = 1;
+
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j < count; ++j)
+            if (nonzero[i * count + j]) materializeTile(tileIndex(i, j));
+
+    auto tile = [&](size_t i, size_t j) { return arena().tile(slots_[tileIndex(i, j)]); };
+    TaskGraph graph;
+
+    for (size_t k = 0; k < count; ++k) {
+        MatrixType* kk = tile(k, k);
+        const size_t nk = validRows(k);
+
+        graph.addTask([=] { factorizeLUTile(kk, nk, ld); }, {}, { tileIndex(k, k) });
+
+        for (size_t j = k + 1; j < count; ++j) {
+            if (!nonzero[k * count + j]) continue;
+
+            MatrixType* kj = tile(k, j);
+            const size_t nj = validCols(j);
+            graph.addTask([=] { solveLowerUnitTile(kk, kj, nk, nj, ld); }, { tileIndex(k, k) }, { tileIndex(k, j) });
+        }
+
+        for (size_t i = k + 1; i < count; ++i) {
+            if (!nonzero[i * count + k]) continue;
+
+            MatrixType* ik = tile(i, k);
+            const size_t ni = validRows(i);
+            graph.addTask([=] { solveUpperRightTile(kk, ik, ni, nk, ld); }, { tileIndex(k, k) }, { tileIndex(i, k) });
+        }
+
+        for (size_t i = k + 1; i < count; ++i)
+            for (size_t j = k + 1; j < count; ++j) {
+                if (!nonzero[i * count + k] || !nonzero[k * count + j]) continue;
+
+                const MatrixType* ik = tile(i, k);
+                const MatrixType* kj = tile(k, j);
+                MatrixType* ij = tile(i, j);
+                const size_t ni = validRows(i);
+                const size_t nj = validCols(j);
+
+                graph.addTask([=] { multiplySubtractTile(ik, kj, ij, ni, nk, nj, ld); },
+                              { tileIndex(i, k), tileIndex(k, j) }, { tileIndex(i, j) });
+            }
+    }
+
+    graph.run();
+}
+
+template <typename MatrixType>
+void BlockMatrix<MatrixType>::factorizeCholeskyBlockMatrix() {
+    static_assert(std::is_floating_point<MatrixType>::value, "Cholesky factorization requires a floating-point type.");
+
+    if (rows_ != cols_ || blockRows_ != blockCols_)
+        throw std::invalid_argument("Cholesky factorization requires a square matrix with square blocks.");
+
+    const size_t count = numBlocksRow_;
+    const size_t ld = blockCols_;
+
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = i + 1; j < count; ++j) releaseTile(tileIndex(i, j));
+
+    std::vector<char> nonzero(count * count);
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j <= i; ++j) nonzero[i * count + j] = i == j || kinds_[tileIndex(i, j)] != TileKind::Zero;
+
+    for (size_t k = 0; k < count; ++k)
+        for (size_t i = k + 1; i < count; ++i)
+            if (nonzero[i * count + k])
+                for (size_t j = k + 1; j < i; ++j)
+                    if (nonzero[j * count + k]) nonzero[i * count + j] = 1;
+
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j <= i; ++j)
+            if (nonzero[i * count + j]) materializeTile(tileIndex(i, j));
 
-    if (exp == 0) {
-        result = BlockMatrix<MatrixType>(getRowsBlockMatrix(), getColsBlockMatrix(), getBlockRows(), getBlockCols());
-        for (size_t i = 0; i < getBlockRows(); ++i) 
-            result.getBlock(i, i) = Matrix<MatrixType>::makeIdentityMatrix(getBlockRows());
-    } else {
-        for (int i = 1; i < exp; ++i) 
-            result = result * base;
+    auto tile = [&](size_t i, size_t j) { return arena().tile(slots_[tileIndex(i, j)]); };
+    TaskGraph graph;
+
+    for (size_t k = 0; k < count; ++k) {
+        MatrixType* kk = tile(k, k);
+        const size_t nk = validRows(k);
+
+        graph.addTask([=] { factorizeCholeskyTile(kk, nk, ld); }, {}, { tileIndex(k, k) });
+
+        for (size_t i = k + 1; i < count; ++i) {
+            if (!nonzero[i * count + k]) continue;
+
+            MatrixType* ik = tile(i, k);
+            const size_t ni = validRows(i);
+            graph.addTask([=] { solveLowerTransposedRightTile(kk, ik, ni, nk, ld); }, { tileIndex(k, k) }, { tileIndex(i, k) });
+        }
+
+        for (size_t i = k + 1; i < count; ++i) {
+            if (!nonzero[i * count + k]) continue;
+
+            const MatrixType* ik = tile(i, k);
+            MatrixType* ii = tile(i, i);
+            const size_t ni = validRows(i);
+
+            graph.addTask([=] { symmetricRankUpdateTile(ik, ii, ni, nk, ld); }, { tileIndex(i, k) }, { tileIndex(i, i) });
+
+            for (size_t j = k + 1; j < i; ++j) {
+                if (!nonzero[j * count + k]) continue;
+
+                const MatrixType* jk = tile(j, k);
+                MatrixType* ij = tile(i, j);
+                const size_t nj = validRows(j);
+
+                graph.addTask([=] { multiplySubtractTransposedTile(ik, jk, ij, ni, nk, nj, ld); },
+                              { tileIndex(i, k), tileIndex(j, k) }, { tileIndex(i, j) });
+            }
+        }
     }
 
+    graph.run();
+
+    parallelFor(0, count, [&](size_t i) {
+        MatrixType* ii = tile(i, i);
+        for (size_t r = 0; r < validRows(i); ++r)
+            std::fill(ii + r * ld + r + 1, ii + r * ld + validCols(i), static_cast<MatrixType>(0));
+    }, 1);
+}
+
+template <typename MatrixType>
+void BlockMatrix<MatrixType>::factorizeApproximateLUBlockMatrix(double tolerance) {
+    static_assert(std::is_floating_point<MatrixType>::value, "LU factorization requires a floating-point type.");
+
+    if (rows_ != cols_ || blockRows_ != blockCols_)
+        throw std::invalid_argument("LU factorization requires a square matrix with square blocks.");
+
+    const size_t count = numBlocksRow_;
+    const size_t ld = blockCols_;
+
+    std::vector<TileKind> plan(count * count);
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j < count; ++j) {
+            const TileKind kind = kinds_[tileIndex(i, j)];
+            plan[i * count + j] = i != j && (kind == TileKind::Zero || kind == TileKind::LowRank) ? kind : TileKind::Dense;
+        }
+
+    for (size_t k = 0; k < count; ++k)
+        for (size_t i = k + 1; i < count; ++i)
+            for (size_t j = k + 1; j < count; ++j) {
+                const TileKind left = plan[i * count + k];
+                const TileKind right = plan[k * count + j];
+                if (left == TileKind::Zero || right == TileKind::Zero) continue;
+
+                const bool lowRank = left == TileKind::LowRank || right == TileKind::LowRank;
+                TileKind& target = plan[i * count + j];
+                if (target == TileKind::Zero) target = lowRank && i != j ? TileKind::LowRank : TileKind::Dense;
+                else if (target == TileKind::LowRank && !lowRank) target = TileKind::Dense;
+            }
+
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j < count; ++j) {
+            const size_t index = tileIndex(i, j);
+            if (plan[i * count + j] == TileKind::Dense) {
+                materializeTile(index);
+            } else if (plan[i * count + j] == TileKind::LowRank && kinds_[index] == TileKind::Zero) {
+                lowRankTiles_[index] = LowRankTile<MatrixType>{ validRows(i), validCols(j), 0, {}, {} };
+                kinds_[index] = TileKind::LowRank;
+            }
+        }
+
+    auto tile = [&](size_t i, size_t j) { return arena().tile(slots_[tileIndex(i, j)]); };
+    TaskGraph graph;
+
+    for (size_t k = 0; k < count; ++k) {
+        MatrixType* kk = tile(k, k);
+        const size_t nk = validRows(k);
+
+        graph.addTask([=] { factorizeLUTile(kk, nk, ld); }, {}, { tileIndex(k, k) });
+
+        for (size_t j = k + 1; j < count; ++j) {
+            const size_t kj = tileIndex(k, j);
+            if (plan[k * count + j] == TileKind::Zero) continue;
+
+            if (plan[k * count + j] == TileKind::Dense) {
+                MatrixType* target = tile(k, j);
+                const size_t nj = validCols(j);
+                graph.addTask([=] { solveLowerUnitTile(kk, target, nk, nj, ld); }, { tileIndex(k, k) }, { kj });
+                continue;
+            }
+
+            LowRankTile<MatrixType>* target = &lowRankTiles_.at(kj);
+            graph.addTask([=] {
+                const size_t rank = target->rank;
+                std::vector<MatrixType> buffer(nk * ld);
+                for (size_t r = 0; r < nk; ++r) std::copy_n(target->u.data() + r * rank, rank, buffer.data() + r * ld);
+
+                solveLowerUnitTile(kk, buffer.data(), nk, rank, ld);
+                for (size_t r = 0; r < nk; ++r) std::copy_n(buffer.data() + r * ld, rank, target->u.data() + r * rank);
+            }, { tileIndex(k, k) }, { kj });
+        }
+
+        for (size_t i = k + 1; i < count; ++i) {
+            const size_t ik = tileIndex(i, k);
+            if (plan[i * count + k] == TileKind::Zero) continue;
+
+            if (plan[i * count + k] == TileKind::Dense) {
+                MatrixType* target = tile(i, k);
+                const size_t ni = validRows(i);
+                graph.addTask([=] { solveUpperRightTile(kk, target, ni, nk, ld); }, { tileIndex(k, k) }, { ik });
+                continue;
+            }
+
+            LowRankTile<MatrixType>* target = &lowRankTiles_.at(ik);
+            graph.addTask([=] {
+                const size_t rank = target->rank;
+                std::vector<MatrixType> buffer(rank * ld);
+                for (size_t p = 0; p < nk; ++p)
+                    for (size_t s = 0; s < rank; ++s) buffer[s * ld + p] = target->v[p * rank + s];
+
+                solveUpperRightTile(kk, buffer.data(), rank, nk, ld);
+                for (size_t p = 0; p < nk; ++p)
+                    for (size_t s = 0; s < rank; ++s) target->v[p * rank + s] = buffer[s * ld + p];
+            }, { tileIndex(k, k) }, { ik });
+        }
+
+        for (size_t i = k + 1; i < count; ++i)
+            for (size_t j = k + 1; j < count; ++j) {
+                if (plan[i * count + k] == TileKind::Zero || plan[k * count + j] == TileKind::Zero) continue;
+
+                const size_t ik = tileIndex(i, k);
+                const size_t kj = tileIndex(k, j);
+                const size_t ij = tileIndex(i, j);
+                const size_t ni = validRows(i);
+                const size_t nj = validCols(j);
+
+                if (plan[i * count + j] == TileKind::LowRank) {
+                    LowRankTile<MatrixType>* target = &lowRankTiles_.at(ij);
+                    graph.addTask([=] {
+                        const LowRankTile<MatrixType> product = multiplyLowRankTile(*this, ik, *this, kj, ni, nk, nj);
+                        const LowRankTile<MatrixType> current = *target;
+                        approximateCrossTile(ni, nj, [&](size_t r, size_t c) {
+                            return lowRankElement(current, r, c) - lowRankElement(product, r, c);
+                        }, tolerance, std::min(ni, nj), *target);
+                    }, { ik, kj }, { ij });
+                } else if (plan[i * count + k] == TileKind::Dense && plan[k * count + j] == TileKind::Dense) {
+                    const MatrixType* left = tile(i, k);
+                    const MatrixType* right = tile(k, j);
+                    MatrixType* target = tile(i, j);
+                    graph.addTask([=] { multiplySubtractTile(left, right, target, ni, nk, nj, ld); }, { ik, kj }, { ij });
+                } else {
+                    MatrixType* target = tile(i, j);
+                    graph.addTask([=] {
+                        std::vector<MatrixType> product(blockRows_ * blockCols_, static_cast<MatrixType>(0)), scratch;
+                        multiplyAddTile(*this, ik, *this, kj, ni, nk, nj, product.data(), scratch);
+                        for (size_t r = 0; r < ni; ++r)
+                            for (size_t c = 0; c < nj; ++c) target[r * ld + c] -= product[r * ld + c];
+                    }, { ik, kj }, { ij });
+                }
+            }
+    }
+
+    graph.run();
+
+    for (size_t t = 0; t < kinds_.size(); ++t)
+        if (kinds_[t] == TileKind::LowRank && lowRankTiles_.at(t).rank == 0) releaseTile(t);
+}
+
+template <typename MatrixType>
+std::vector<MatrixType> BlockMatrix<MatrixType>::multiplyVectorBlockMatrix(const std::vector<MatrixType>& vector) const {
+    if (vector.size() != cols_)
+        throw std::invalid_argument("Vector size does not match the number of columns");
+
+    std::vector<MatrixType> result(rows_, static_cast<MatrixType>(0));
+    parallelFor(0, numBlocksRow_, [&](size_t i) {
+        for (size_t j = 0; j < numBlocksCol_; ++j)
+            multiplyAddVectorTile(tileIndex(i, j), static_cast<MatrixType>(1), vector.data() + j * blockCols_,
+                                  result.data() + i * blockRows_, validRows(i), validCols(j));
+    }, 1);
+
     return result;
 }
 
-} // namespace
\ No newline at end of file
+template <typename MatrixType>
+std::vector<MatrixType> BlockMatrix<MatrixType>::solveLUBlockMatrix(const std::vector<MatrixType>& rhs) const {
+    if (rows_ != cols_ || blockRows_ != blockCols_)
+        throw std::invalid_argument("LU solve requires a square matrix with square blocks.");
+    if (rhs.size() != rows_)
+        throw std::invalid_argument("Vector size does not match the number of rows");
+
+    std::vector<MatrixType> x(rhs);
+    const size_t count = numBlocksRow_;
+
+    for (size_t i = 0; i < count; ++i) {
+        MatrixType* xi = x.data() + i * blockRows_;
+        for (size_t j = 0; j < i; ++j)
+            multiplyAddVectorTile(tileIndex(i, j), static_cast<MatrixType>(-1), x.data() + j * blockCols_, xi,
+                                  validRows(i), validCols(j));
+
+        const size_t diagonal = tileIndex(i, i);
+        for (size_t r = 1; r < validRows(i); ++r)
+            for (size_t p = 0; p < r; ++p) xi[r] -= elementAt(diagonal, r, p) * xi[p];
+    }
+
+    for (size_t i = count; i-- > 0;) {
+        MatrixType* xi = x.data() + i * blockRows_;
+        for (size_t j = i + 1; j < count; ++j)
+            multiplyAddVectorTile(tileIndex(i, j), static_cast<MatrixType>(-1), x.data() + j * blockCols_, xi,
+                                  validRows(i), validCols(j));
+
+        const size_t diagonal = tileIndex(i, i);
+        for (size_t r = validRows(i); r-- > 0;) {
+            for (size_t p = r + 1; p < validRows(i); ++p) xi[r] -= elementAt(diagonal, r, p) * xi[p];
+            xi[r] /= elementAt(diagonal, r, r);
+        }
+    }
+
+    return x;
+}
+
+} // namespace
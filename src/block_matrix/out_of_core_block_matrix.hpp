@@ -0,0 +1,409 @@
+/**
+ * @file out_of_core_block_matrix.hpp
+ * @brief Блочная матрица, плитки которой хранятся в файле и подгружаются в ограниченный кэш.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../parallel/prefetch_pipeline.hpp"
+#include "block_matrix.hpp"
+#include "tile_store.hpp"
+
+namespace matrix_lib {
+
+/**
+ * @brief Блочная матрица, не помещающаяся в оперативную память.
+ *
+ * Сетка плиток та же, что у BlockMatrix, но каждая плитка (blockRows x blockCols, по строкам)
+ * лежит в файле подкачки TileStore, а в памяти держится только LRU-кэш горячих плиток
+ * заданного объема. Умножение и LU-разложение используют те же ядра плиток, что и BlockMatrix:
+ * задача закрепляет свои плитки только на время счета и заранее запрашивает фоновую загрузку
+ * плиток следующего шага. Обмен с BlockMatrix — через конструктор и toBlockMatrix().
+ * Проходы по всем плиткам (toBlockMatrix(), multiplyVectorBlockMatrix()) идут через
+ * runPrefetchPipeline(): чтение следующих плиток перекрывается со счетом над текущей.
+ *
+ * @tparam MatrixType Тип элементов.
+ */
+template <typename MatrixType>
+class OutOfCoreBlockMatrix {
+private:
+    using Pin = typename TileStore<MatrixType>::Pin;
+
+    size_t rows_;
+    size_t cols_;
+    size_t blockRows_;
+    size_t blockCols_;
+    size_t numBlocksRow_;
+    size_t numBlocksCol_;
+    std::unique_ptr<TileStore<MatrixType>> store_;
+    mutable PipelineStats pipelineStats_;     ///< Замеры последнего потокового прохода.
+
+    /**
+     * @brief Копия плитки из хранилища (шаг загрузки конвейера).
+     * @param index Номер плитки.
+     * @return Элементы плитки.
+     */
+    std::vector<MatrixType> loadTile(size_t index) const {
+        Pin tile(*store_, index, false);
+        return std::vector<MatrixType>(tile.data(), tile.data() + blockRows_ * blockCols_);
+    }
+
+    size_t tileIndex(size_t blockRow, size_t blockCol) const noexcept { return blockRow * numBlocksCol_ + blockCol; }
+
+    size_t validRows(size_t blockRow) const noexcept { return std::min(blockRows_, rows_ - blockRow * blockRows_); }
+
+    size_t validCols(size_t blockCol) const noexcept { return std::min(blockCols_, cols_ - blockCol * blockCols_); }
+
+    void checkBlock(size_t blockRow, size_t blockCol) const {
+        if (blockRow >= numBlocksRow_ || blockCol >= numBlocksCol_)
+            throw std::out_of_range("Block index out of range");
+    }
+
+public:
+    /**
+     * @brief Создать нулевую матрицу в файле подкачки.
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param blockRows Количество строк в блоке.
+     * @param blockCols Количество столбцов в блоке.
+     * @param path Путь к файлу подкачки (удаляется вместе с матрицей).
+     * @param budget Объем кэша плиток в байтах.
+     * @throw std::invalid_argument Если размер блока равен нулю.
+     * @throw std::runtime_error Если файл не удается создать.
+     */
+    OutOfCoreBlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols,
+                         const std::string& path, size_t budget = TILE_STORE_DEFAULT_BUDGET)
+        : rows_(rows), cols_(cols), blockRows_(blockRows), blockCols_(blockCols) {
+        if (blockRows == 0 || blockCols == 0) throw std::invalid_argument("Block size must be positive");
+
+        numBlocksRow_ = (rows + blockRows - 1) / blockRows;
+        numBlocksCol_ = (cols + blockCols - 1) / blockCols;
+        store_ = std::make_unique<TileStore<MatrixType>>(path, numBlocksRow_ * numBlocksCol_, blockRows * blockCols, budget);
+    }
+
+    /**
+     * @brief Выгрузить блочную матрицу в файл подкачки (с теми же размерами блоков).
+     * @param matrix Исходная матрица.
+     * @param path Путь к файлу подкачки.
+     * @param budget Объем кэша плиток в байтах.
+     */
+    OutOfCoreBlockMatrix(const BlockMatrix<MatrixType>& matrix, const std::string& path,
+                         size_t budget = TILE_STORE_DEFAULT_BUDGET)
+        : OutOfCoreBlockMatrix(matrix.getRowsBlockMatrix(), matrix.getColsBlockMatrix(),
+                               matrix.getBlockRows(), matrix.getBlockCols(), path, budget) {
+        for (size_t i = 0; i < numBlocksRow_; ++i)
+            for (size_t j = 0; j < numBlocksCol_; ++j)
+                if (matrix.getTileKind(i, j) != TileKind::Zero) setBlock(i, j, matrix.getBlock(i, j));
+    }
+
+    OutOfCoreBlockMatrix(const OutOfCoreBlockMatrix&) = delete;
+    OutOfCoreBlockMatrix& operator=(const OutOfCoreBlockMatrix&) = delete;
+
+    /**
+     * @brief Возвращает количество строк в блочной матрице.
+     * @return Количество строк.
+     */
+    size_t getRowsBlockMatrix() const noexcept { return rows_; }
+
+    /**
+     * @brief Возвращает количество столбцов в блочной матрице.
+     * @return Количество столбцов.
+     */
+    size_t getColsBlockMatrix() const noexcept { return cols_; }
+
+    /**
+     * @brief Возвращает количество строк в блоке матрицы.
+     * @return Количество строк в блоке.
+     */
+    size_t getBlockRows() const noexcept { return blockRows_; }
+
+    /**
+     * @brief Возвращает количество столбцов в блоке матрицы.
+     * @return Количество столбцов в блоке.
+     */
+    size_t getBlockCols() const noexcept { return blockCols_; }
+
+    /**
+     * @brief Возвращает количество блоков по строкам.
+     * @return Количество блоков по строкам.
+     */
+    size_t getNumBlocksRow() const noexcept { return numBlocksRow_; }
+
+    /**
+     * @brief Возвращает количество блоков по столбцам.
+     * @return Количество блоков по столбцам.
+     */
+    size_t getNumBlocksCol() const noexcept { return numBlocksCol_; }
+
+    /**
+     * @brief Хранилище плиток (статистика кэша, сброс на диск).
+     * @return Хранилище.
+     */
+    TileStore<MatrixType>& getTileStore() const noexcept { return *store_; }
+
+    /**
+     * @brief Замеры последнего потокового прохода (доля перекрытия загрузки со счетом).
+     * @return Замеры конвейера.
+     */
+    const PipelineStats& getPipelineStats() const noexcept { return pipelineStats_; }
+
+    /**
+     * @brief Получить копию блока.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Заполненная часть блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    Matrix<MatrixType> getBlock(size_t blockRow, size_t blockCol) const {
+        checkBlock(blockRow, blockCol);
+
+        Pin tile(*store_, tileIndex(blockRow, blockCol), false);
+        Matrix<MatrixType> block(validRows(blockRow), validCols(blockCol));
+        for (size_t r = 0; r < block.getRows(); ++r)
+            std::copy(tile.data() + r * blockCols_, tile.data() + r * blockCols_ + block.getCols(), block.getRowData(r));
+
+        return block;
+    }
+
+    /**
+     * @brief Записать блок.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @param block Матрица размера заполненной части блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если размер матрицы не совпадает с размером блока.
+     */
+    void setBlock(size_t blockRow, size_t blockCol, const Matrix<MatrixType>& block) {
+        checkBlock(blockRow, blockCol);
+        if (block.getRows() != validRows(blockRow) || block.getCols() != validCols(blockCol))
+            throw std::invalid_argument("Block has incompatible dimensions");
+
+        Pin tile(*store_, tileIndex(blockRow, blockCol), true);
+        for (size_t r = 0; r < block.getRows(); ++r)
+            std::copy(block.getRowData(r), block.getRowData(r) + block.getCols(), tile.data() + r * blockCols_);
+    }
+
+    /**
+     * @brief Получить элемент.
+     * @param row Строка.
+     * @param col Столбец.
+     * @return Значение элемента.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    MatrixType getValue(size_t row, size_t col) const {
+        if (row >= rows_ || col >= cols_) throw std::out_of_range("Index out of range");
+
+        Pin tile(*store_, tileIndex(row / blockRows_, col / blockCols_), false);
+        return tile.data()[(row % blockRows_) * blockCols_ + col % blockCols_];
+    }
+
+    /**
+     * @brief Записать элемент.
+     * @param row Строка.
+     * @param col Столбец.
+     * @param value Значение.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    void setValue(size_t row, size_t col, MatrixType value) {
+        if (row >= rows_ || col >= cols_) throw std::out_of_range("Index out of range");
+
+        Pin tile(*store_, tileIndex(row / blockRows_, col / blockCols_), true);
+        tile.data()[(row % blockRows_) * blockCols_ + col % blockCols_] = value;
+    }
+
+    /**
+     * @brief Загрузить матрицу в память.
+     * @return Блочная матрица с теми же размерами блоков.
+     */
+    BlockMatrix<MatrixType> toBlockMatrix() const {
+        BlockMatrix<MatrixType> result(rows_, cols_, blockRows_, blockCols_);
+        pipelineStats_ = runPrefetchPipeline(numBlocksRow_ * numBlocksCol_, [this](size_t t) { return loadTile(t); },
+                                             [&](size_t t, std::vector<MatrixType>& tile) {
+            const size_t i = t / numBlocksCol_;
+            const size_t j = t % numBlocksCol_;
+            Matrix<MatrixType> block(validRows(i), validCols(j));
+            for (size_t r = 0; r < block.getRows(); ++r)
+                std::copy(tile.data() + r * blockCols_, tile.data() + r * blockCols_ + block.getCols(), block.getRowData(r));
+
+            result.setBlock(i, j, block);
+        });
+
+        return result;
+    }
+
+    /**
+     * @brief Умножение на вектор за один потоковый проход по плиткам.
+     * @param vector Вектор длины getColsBlockMatrix().
+     * @return Произведение.
+     * @throw std::invalid_argument Если длина вектора не совпадает с количеством столбцов.
+     */
+    std::vector<MatrixType> multiplyVectorBlockMatrix(const std::vector<MatrixType>& vector) const {
+        if (vector.size() != cols_)
+            throw std::invalid_argument("Vector size does not match the number of columns");
+
+        std::vector<MatrixType> result(rows_, static_cast<MatrixType>(0));
+        pipelineStats_ = runPrefetchPipeline(numBlocksRow_ * numBlocksCol_, [this](size_t t) { return loadTile(t); },
+                                             [&](size_t t, std::vector<MatrixType>& tile) {
+            const size_t i = t / numBlocksCol_;
+            const size_t j = t % numBlocksCol_;
+            const MatrixType* x = vector.data() + j * blockCols_;
+            MatrixType* y = result.data() + i * blockRows_;
+
+            for (size_t r = 0; r < validRows(i); ++r) {
+                MatrixType sum = static_cast<MatrixType>(0);
+                for (size_t c = 0; c < validCols(j); ++c) sum += tile[r * blockCols_ + c] * x[c];
+                y[r] += sum;
+            }
+        });
+
+        return result;
+    }
+
+    /**
+     * @brief Умножение с накоплением: this += a * b.
+     *
+     * Одна задача sharedTaskPool на блок результата; на шаге k задача закрепляет A(i, k) и
+     * B(k, j) и запрашивает предзагрузку A(i, k + 1) и B(k + 1, j).
+     *
+     * @param a Левый множитель.
+     * @param b Правый множитель.
+     * @throw std::invalid_argument Если размеры матриц или блоков несовместимы либо результат совпадает с множителем.
+     */
+    void multiplyAddBlockMatrix(const OutOfCoreBlockMatrix& a, const OutOfCoreBlockMatrix& b);
+
+    /**
+     * @brief LU-разложение на месте без выбора ведущего элемента (как BlockMatrix::factorizeLUBlockMatrix()).
+     *
+     * Задачи графа TaskGraph выполняются над закрепленными плитками; перед счетом задача
+     * запрашивает предзагрузку плиток следующей по порядку задачи.
+     *
+     * @throw std::invalid_argument Если матрица или блоки не квадратные.
+     * @throw std::domain_error Если встречен нулевой ведущий элемент.
+     */
+    void factorizeLUBlockMatrix();
+};
+
+template <typename MatrixType>
+void OutOfCoreBlockMatrix<MatrixType>::multiplyAddBlockMatrix(const OutOfCoreBlockMatrix& a, const OutOfCoreBlockMatrix& b) {
+    if (a.cols_ != b.rows_ || rows_ != a.rows_ || cols_ != b.cols_)
+        throw std::invalid_argument("Matrix dimensions are incompatible for multiplication");
+
+    if (a.blockCols_ != b.blockRows_ || blockRows_ != a.blockRows_ || blockCols_ != b.blockCols_)
+        throw std::invalid_argument("Block sizes are incompatible for multiplication");
+
+    if (this == &a || this == &b)
+        throw std::invalid_argument("Result must not alias a factor");
+
+    TaskPool& pool = sharedTaskPool();
+    TaskGroup group;
+    for (size_t i = 0; i < numBlocksRow_; ++i)
+        for (size_t j = 0; j < numBlocksCol_; ++j)
+            pool.submit(group, [this, &a, &b, i, j] {
+                Pin c(*store_, tileIndex(i, j), true);
+                std::vector<MatrixType> packed;
+
+                for (size_t k = 0; k < a.numBlocksCol_; ++k) {
+                    if (k + 1 < a.numBlocksCol_) {
+                        a.store_->prefetch({ a.tileIndex(i, k + 1) });
+                        b.store_->prefetch({ b.tileIndex(k + 1, j) });
+                    }
+
+                    Pin left(*a.store_, a.tileIndex(i, k), false);
+                    Pin right(*b.store_, b.tileIndex(k, j), false);
+                    packTilePanel(left.data(), blockRows_, a.blockCols_, a.blockCols_, packed);
+                    multiplyAddPackedTile(packed.data(), right.data(), c.data(),
+                                          blockRows_, a.blockCols_, blockCols_, blockCols_, blockCols_);
+                }
+            });
+
+    pool.wait(group);
+}
+
+template <typename MatrixType>
+void OutOfCoreBlockMatrix<MatrixType>::factorizeLUBlockMatrix() {
+    static_assert(std::is_floating_point<MatrixType>::value, "LU factorization requires a floating-point type.");
+
+    if (rows_ != cols_ || blockRows_ != blockCols_)
+        throw std::invalid_argument("LU factorization requires a square matrix with square blocks.");
+
+    const size_t count = numBlocksRow_;
+    const size_t ld = blockCols_;
+    TileStore<MatrixType>& store = *store_;
+
+    std::vector<std::function<void()>> bodies;
+    std::vector<std::vector<size_t>> reads, writes;
+    auto add = [&](std::function<void()> body, std::vector<size_t> read, std::vector<size_t> write) {
+        bodies.push_back(std::move(body));
+        reads.push_back(std::move(read));
+        writes.push_back(std::move(write));
+    };
+
+    for (size_t k = 0; k < count; ++k) {
+        const size_t kk = tileIndex(k, k);
+        const size_t nk = validRows(k);
+
+        add([&store, kk, nk, ld] {
+            Pin diagonal(store, kk, true);
+            factorizeLUTile(diagonal.data(), nk, ld);
+        }, {}, { kk });
+
+        for (size_t j = k + 1; j < count; ++j) {
+            const size_t kj = tileIndex(k, j);
+            const size_t nj = validCols(j);
+            add([&store, kk, kj, nk, nj, ld] {
+                Pin diagonal(store, kk, false);
+                Pin target(store, kj, true);
+                solveLowerUnitTile(diagonal.data(), target.data(), nk, nj, ld);
+            }, { kk }, { kj });
+        }
+
+        for (size_t i = k + 1; i < count; ++i) {
+            const size_t ik = tileIndex(i, k);
+            const size_t ni = validRows(i);
+            add([&store, kk, ik, ni, nk, ld] {
+                Pin diagonal(store, kk, false);
+                Pin target(store, ik, true);
+                solveUpperRightTile(diagonal.data(), target.data(), ni, nk, ld);
+            }, { kk }, { ik });
+        }
+
+        for (size_t i = k + 1; i < count; ++i)
+            for (size_t j = k + 1; j < count; ++j) {
+                const size_t ik = tileIndex(i, k);
+                const size_t kj = tileIndex(k, j);
+                const size_t ij = tileIndex(i, j);
+                const size_t ni = validRows(i);
+                const size_t nj = validCols(j);
+                add([&store, ik, kj, ij, ni, nk, nj, ld] {
+                    Pin left(store, ik, false);
+                    Pin right(store, kj, false);
+                    Pin target(store, ij, true);
+                    multiplySubtractTile(left.data(), right.data(), target.data(), ni, nk, nj, ld);
+                }, { ik, kj }, { ij });
+            }
+    }
+
+    TaskGraph graph;
+    for (size_t t = 0; t < bodies.size(); ++t) {
+        std::vector<size_t> next;
+        if (t + 1 < bodies.size()) {
+            next = reads[t + 1];
+            next.insert(next.end(), writes[t + 1].begin(), writes[t + 1].end());
+        }
+
+        graph.addTask([&store, body = std::move(bodies[t]), next = std::move(next)] {
+            store.prefetch(next);
+            body();
+        }, reads[t], writes[t]);
+    }
+
+    graph.run();
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,546 @@
+/**
+ * @file shared_block_matrix.hpp
+ * @brief Блочная матрица в разделяемой памяти POSIX, общая для нескольких процессов одного узла.
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../matrix/matrix_view.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "block_matrix.hpp"
+#include "tile_kernel.hpp"
+
+#define SHARED_TILE_ALIGNMENT 64
+
+namespace matrix_lib {
+
+/**
+ * @brief Заголовок сегмента разделяемой памяти с плитками.
+ *
+ * За заголовком следует каталог плиток (номер плитки в области данных для каждой позиции
+ * сетки по строкам или SHARED_TILE_ABSENT для нулевой плитки), затем, с выравниванием
+ * SHARED_TILE_ALIGNMENT байт, сами плитки blockRows x blockCols по строкам.
+ */
+struct SharedTileHeader {
+    static constexpr uint64_t MAGIC = 0x454c49544d4c4853ULL;  ///< "SHLMTILE".
+
+    uint64_t magic;
+    uint64_t elementSize;                   ///< sizeof(MatrixType) процесса-создателя.
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t blockRows;
+    uint64_t blockCols;
+    uint64_t tileCount;                     ///< Количество хранимых плиток.
+    std::atomic<uint64_t> finishedBands;    ///< Завершенные полосы текущего раунда совместного умножения.
+    std::atomic<uint64_t> failedBands;      ///< Полосы текущего раунда, завершившиеся ошибкой.
+    std::atomic<uint64_t> round;            ///< Номер раунда (увеличивается resetRowBands()).
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared tile counters require lock-free 64-bit atomics.");
+
+/// Отметка нулевой плитки в каталоге.
+constexpr uint64_t SHARED_TILE_ABSENT = ~uint64_t(0);
+
+/**
+ * @brief Блочная матрица в именованном сегменте shm_open()/mmap().
+ *
+ * Процесс-создатель размещает в сегменте каталог и плитки (нулевые плитки места не занимают,
+ * остальные виды плиток BlockMatrix хранятся плотно) и удаляет имя сегмента в деструкторе.
+ * Другие процессы узла подключаются к сегменту по имени, по умолчанию только для чтения:
+ * плитки читаются прямо из общих страниц (getBlockView() не копирует данные), поэтому
+ * матрица не дублируется в каждом процессе и ничего не сериализуется. Совместное умножение:
+ * каждый процесс вызывает multiplyAddRowBand() для своей полосы строк плиток результата,
+ * подключенного для записи, отмечает ее finishRowBand() (или failRowBand() при ошибке) и ждет
+ * остальных waitRowBands() с ограничением времени, чтобы упавший участник не подвесил
+ * остальных. Полосы не пересекаются, поэтому синхронизация плиток не нужна. Перед следующим
+ * умножением в тот же сегмент один из участников вызывает resetRowBands().
+ *
+ * Сегмент привязан к размеру элемента и не переносится между узлами с другим порядком байтов.
+ *
+ * @tparam MatrixType Тип элементов.
+ */
+template <typename MatrixType>
+class SharedBlockMatrix {
+    static_assert(std::is_trivially_copyable<MatrixType>::value, "Shared tiles must be trivially copyable.");
+
+private:
+    std::string name_;
+    bool owner_;                      ///< Сегмент создан этим объектом и удаляется в деструкторе.
+    bool writable_;
+    void* base_;
+    size_t bytes_;
+    SharedTileHeader* header_;
+    const uint64_t* directory_;
+    MatrixType* tiles_;
+    size_t numBlocksRow_;
+    size_t numBlocksCol_;
+
+    static size_t dataOffset(size_t positions) noexcept {
+        const size_t offset = sizeof(SharedTileHeader) + positions * sizeof(uint64_t);
+        return (offset + SHARED_TILE_ALIGNMENT - 1) / SHARED_TILE_ALIGNMENT * SHARED_TILE_ALIGNMENT;
+    }
+
+    static void checkName(const std::string& name) {
+        if (name.size() < 2 || name[0] != '/' || name.find('/', 1) != std::string::npos)
+            throw std::invalid_argument("Shared segment name must be '/' followed by a file name");
+    }
+
+    size_t tileSize() const noexcept { return header_->blockRows * header_->blockCols; }
+
+    size_t tileIndex(size_t blockRow, size_t blockCol) const noexcept { return blockRow * numBlocksCol_ + blockCol; }
+
+    size_t validRows(size_t blockRow) const noexcept {
+        return std::min<size_t>(header_->blockRows, header_->rows - blockRow * header_->blockRows);
+    }
+
+    size_t validCols(size_t blockCol) const noexcept {
+        return std::min<size_t>(header_->blockCols, header_->cols - blockCol * header_->blockCols);
+    }
+
+    void checkBlock(size_t blockRow, size_t blockCol) const {
+        if (blockRow >= numBlocksRow_ || blockCol >= numBlocksCol_)
+            throw std::out_of_range("Block index out of range");
+    }
+
+    void checkWritable() const {
+        if (!writable_) throw std::invalid_argument("Shared matrix is attached read-only");
+    }
+
+    MatrixType* tileData(size_t index) const noexcept {
+        return directory_[index] == SHARED_TILE_ABSENT ? nullptr : tiles_ + directory_[index] * tileSize();
+    }
+
+    void setGrid() noexcept {
+        numBlocksRow_ = (header_->rows + header_->blockRows - 1) / header_->blockRows;
+        numBlocksCol_ = (header_->cols + header_->blockCols - 1) / header_->blockCols;
+        directory_ = reinterpret_cast<const uint64_t*>(header_ + 1);
+        tiles_ = reinterpret_cast<MatrixType*>(static_cast<char*>(base_) + dataOffset(numBlocksRow_ * numBlocksCol_));
+    }
+
+    bool validDirectory() const noexcept {
+        for (size_t t = 0; t < numBlocksRow_ * numBlocksCol_; ++t)
+            if (directory_[t] != SHARED_TILE_ABSENT && directory_[t] >= header_->tileCount) return false;
+
+        return true;
+    }
+
+    /**
+     * @brief Создать сегмент с каталогом; stored[t] — хранится ли плитка на позиции t.
+     */
+    void create(size_t rows, size_t cols, size_t blockRows, size_t blockCols, const std::vector<bool>& stored) {
+        std::vector<uint64_t> directory(stored.size(), SHARED_TILE_ABSENT);
+        uint64_t count = 0;
+        for (size_t t = 0; t < stored.size(); ++t)
+            if (stored[t]) directory[t] = count++;
+
+        bytes_ = dataOffset(stored.size()) + count * blockRows * blockCols * sizeof(MatrixType);
+
+        const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) throw std::runtime_error("Cannot create shared segment: " + name_);
+
+        base_ = ftruncate(fd, static_cast<off_t>(bytes_)) == 0
+                    ? mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                    : MAP_FAILED;
+        close(fd);
+        if (base_ == MAP_FAILED) {
+            shm_unlink(name_.c_str());
+            throw std::runtime_error("Cannot create shared segment: " + name_);
+        }
+
+        header_ = new (base_) SharedTileHeader{ SharedTileHeader::MAGIC, sizeof(MatrixType), rows, cols,
+                                                blockRows, blockCols, count, { 0 }, { 0 }, { 0 } };
+        std::copy(directory.begin(), directory.end(), reinterpret_cast<uint64_t*>(header_ + 1));
+        setGrid();
+    }
+
+public:
+    /**
+     * @brief Создать сегмент с нулевой матрицей, все плитки которой хранятся (результат умножения).
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param blockRows Количество строк в блоке.
+     * @param blockCols Количество столбцов в блоке.
+     * @param name Имя сегмента ("/имя"); сегмент с таким именем не должен существовать.
+     * @throw std::invalid_argument Если размер блока равен нулю или имя некорректно.
+     * @throw std::runtime_error Если сегмент не удается создать.
+     */
+    SharedBlockMatrix(size_t rows, size_t cols, size_t blockRows, size_t blockCols, const std::string& name)
+        : name_(name), owner_(true), writable_(true) {
+        if (blockRows == 0 || blockCols == 0) throw std::invalid_argument("Block size must be positive");
+        checkName(name);
+
+        const size_t positions = ((rows + blockRows - 1) / blockRows) * ((cols + blockCols - 1) / blockCols);
+        create(rows, cols, blockRows, blockCols, std::vector<bool>(positions, true));
+    }
+
+    /**
+     * @brief Разместить блочную матрицу в новом сегменте (с теми же размерами блоков).
+     * @param matrix Исходная матрица.
+     * @param name Имя сегмента ("/имя"); сегмент с таким именем не должен существовать.
+     * @throw std::invalid_argument Если имя некорректно.
+     * @throw std::runtime_error Если сегмент не удается создать.
+     */
+    SharedBlockMatrix(const BlockMatrix<MatrixType>& matrix, const std::string& name)
+        : name_(name), owner_(true), writable_(true) {
+        checkName(name);
+
+        const size_t numBlocksCol = matrix.getNumBlocksCol();
+        std::vector<bool> stored(matrix.getNumBlocksRow() * numBlocksCol);
+        for (size_t t = 0; t < stored.size(); ++t)
+            stored[t] = matrix.getTileKind(t / numBlocksCol, t % numBlocksCol) != TileKind::Zero;
+
+        create(matrix.getRowsBlockMatrix(), matrix.getColsBlockMatrix(), matrix.getBlockRows(), matrix.getBlockCols(), stored);
+
+        parallelFor(0, stored.size(), [&](size_t t) {
+            MatrixType* tile = tileData(t);
+            if (tile == nullptr) return;
+
+            const size_t i = t / numBlocksCol_;
+            const size_t j = t % numBlocksCol_;
+            const MatrixView<MatrixType> target(tile, validRows(i), validCols(j), header_->blockCols);
+            const auto copy = [&](const MatrixView<const MatrixType>& source) {
+                for (size_t r = 0; r < source.getRows(); ++r)
+                    std::copy(source.getRowData(r), source.getRowData(r) + source.getCols(), target.getRowData(r));
+            };
+
+            if (matrix.getTileKind(i, j) == TileKind::Dense) {
+                copy(matrix.getBlockView(i, j));
+            } else {
+                const Matrix<MatrixType> block = matrix.getBlock(i, j);
+                copy(block.view());
+            }
+        }, 1);
+    }
+
+    /**
+     * @brief Подключиться к существующему сегменту.
+     * @param name Имя сегмента.
+     * @param writable Подключить для записи (для результата совместного умножения).
+     * @throw std::invalid_argument Если имя некорректно.
+     * @throw std::runtime_error Если сегмент не найден, имеет другой формат либо тип элементов или
+     *        его каталог плиток ссылается за пределы области плиток.
+     */
+    explicit SharedBlockMatrix(const std::string& name, bool writable = false)
+        : name_(name), owner_(false), writable_(writable) {
+        checkName(name);
+
+        const int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+        if (fd < 0) throw std::runtime_error("Cannot open shared segment: " + name);
+
+        struct stat info;
+        base_ = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedTileHeader)) {
+            bytes_ = static_cast<size_t>(info.st_size);
+            base_ = mmap(nullptr, bytes_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (base_ == MAP_FAILED) throw std::runtime_error("Cannot map shared segment: " + name);
+
+        header_ = static_cast<SharedTileHeader*>(base_);
+        const bool valid = header_->magic == SharedTileHeader::MAGIC && header_->elementSize == sizeof(MatrixType) &&
+                           header_->blockRows > 0 && header_->blockCols > 0;
+        if (valid) setGrid();
+
+        if (!valid || bytes_ < dataOffset(numBlocksRow_ * numBlocksCol_) + header_->tileCount * tileSize() * sizeof(MatrixType) ||
+            !validDirectory()) {
+            munmap(base_, bytes_);
+            throw std::runtime_error("Shared segment has an incompatible format: " + name);
+        }
+    }
+
+    SharedBlockMatrix(const SharedBlockMatrix&) = delete;
+    SharedBlockMatrix& operator=(const SharedBlockMatrix&) = delete;
+
+    /**
+     * @brief Отключиться от сегмента; создатель также удаляет его имя (память освобождается,
+     * когда отключатся все процессы).
+     */
+    ~SharedBlockMatrix() {
+        munmap(base_, bytes_);
+        if (owner_) shm_unlink(name_.c_str());
+    }
+
+    /**
+     * @brief Имя сегмента.
+     * @return Имя.
+     */
+    const std::string& getName() const noexcept { return name_; }
+
+    /**
+     * @brief Размер сегмента в байтах.
+     * @return Размер.
+     */
+    size_t getSegmentSize() const noexcept { return bytes_; }
+
+    /**
+     * @brief Подключена ли матрица для записи.
+     * @return true для создателя и для подключения с writable.
+     */
+    bool isWritable() const noexcept { return writable_; }
+
+    /**
+     * @brief Возвращает количество строк в блочной матрице.
+     * @return Количество строк.
+     */
+    size_t getRowsBlockMatrix() const noexcept { return header_->rows; }
+
+    /**
+     * @brief Возвращает количество столбцов в блочной матрице.
+     * @return Количество столбцов.
+     */
+    size_t getColsBlockMatrix() const noexcept { return header_->cols; }
+
+    /**
+     * @brief Возвращает количество строк в блоке матрицы.
+     * @return Количество строк в блоке.
+     */
+    size_t getBlockRows() const noexcept { return header_->blockRows; }
+
+    /**
+     * @brief Возвращает количество столбцов в блоке матрицы.
+     * @return Количество столбцов в блоке.
+     */
+    size_t getBlockCols() const noexcept { return header_->blockCols; }
+
+    /**
+     * @brief Возвращает количество блоков по строкам.
+     * @return Количество блоков по строкам.
+     */
+    size_t getNumBlocksRow() const noexcept { return numBlocksRow_; }
+
+    /**
+     * @brief Возвращает количество блоков по столбцам.
+     * @return Количество блоков по столбцам.
+     */
+    size_t getNumBlocksCol() const noexcept { return numBlocksCol_; }
+
+    /**
+     * @brief Количество хранимых (ненулевых) плиток.
+     * @return Количество плиток в сегменте.
+     */
+    size_t getStoredTileCount() const noexcept { return header_->tileCount; }
+
+    /**
+     * @brief Вид плитки: Zero или Dense.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Вид плитки.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    TileKind getTileKind(size_t blockRow, size_t blockCol) const {
+        checkBlock(blockRow, blockCol);
+        return directory_[tileIndex(blockRow, blockCol)] == SHARED_TILE_ABSENT ? TileKind::Zero : TileKind::Dense;
+    }
+
+    /**
+     * @brief Представление блока прямо в разделяемой памяти, без копирования.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Заполненная часть блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     * @throw std::invalid_argument Если блок нулевой и не хранится.
+     */
+    MatrixView<const MatrixType> getBlockView(size_t blockRow, size_t blockCol) const {
+        checkBlock(blockRow, blockCol);
+
+        const MatrixType* tile = tileData(tileIndex(blockRow, blockCol));
+        if (tile == nullptr) throw std::invalid_argument("Block is not stored densely");
+
+        return MatrixView<const MatrixType>(tile, validRows(blockRow), validCols(blockCol), header_->blockCols);
+    }
+
+    /**
+     * @brief Получить копию блока.
+     * @param blockRow Индекс строки блока.
+     * @param blockCol Индекс столбца блока.
+     * @return Заполненная часть блока.
+     * @throw std::out_of_range Если индекс блока выходит за пределы сетки.
+     */
+    Matrix<MatrixType> getBlock(size_t blockRow, size_t blockCol) const {
+        if (getTileKind(blockRow, blockCol) == TileKind::Zero) return Matrix<MatrixType>(validRows(blockRow), validCols(blockCol));
+
+        return Matrix<MatrixType>(getBlockView(blockRow, blockCol));
+    }
+
+    /**
+     * @brief Получить элемент.
+     * @param row Строка.
+     * @param col Столбец.
+     * @return Значение элемента.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    MatrixType getValue(size_t row, size_t col) const {
+        if (row >= header_->rows || col >= header_->cols) throw std::out_of_range("Index out of range");
+
+        const MatrixType* tile = tileData(tileIndex(row / header_->blockRows, col / header_->blockCols));
+        if (tile == nullptr) return static_cast<MatrixType>(0);
+
+        return tile[(row % header_->blockRows) * header_->blockCols + col % header_->blockCols];
+    }
+
+    /**
+     * @brief Скопировать матрицу в память процесса.
+     * @return Блочная матрица с теми же размерами блоков.
+     */
+    BlockMatrix<MatrixType> toBlockMatrix() const {
+        BlockMatrix<MatrixType> result(header_->rows, header_->cols, header_->blockRows, header_->blockCols);
+        for (size_t i = 0; i < numBlocksRow_; ++i)
+            for (size_t j = 0; j < numBlocksCol_; ++j)
+                if (getTileKind(i, j) == TileKind::Dense) result.setBlock(i, j, getBlockView(i, j));
+
+        return result;
+    }
+
+    /**
+     * @brief Полоса строк плиток, принадлежащая участнику part из parts.
+     * @param part Номер участника.
+     * @param parts Количество участников.
+     * @return Первая строка плиток и строка за последней.
+     * @throw std::out_of_range Если part не меньше parts.
+     */
+    std::pair<size_t, size_t> getRowBand(size_t part, size_t parts) const {
+        if (part >= parts) throw std::out_of_range("Row band index out of range");
+
+        return { numBlocksRow_ * part / parts, numBlocksRow_ * (part + 1) / parts };
+    }
+
+    /**
+     * @brief Совместное умножение: this += a * b для строк плиток из getRowBand(part, parts).
+     *
+     * Плитки полосы распределяются между потоками процесса parallelFor(); множители читаются
+     * прямо из разделяемой памяти, нулевые плитки пропускаются.
+     *
+     * @param a Левый множитель.
+     * @param b Правый множитель.
+     * @param part Номер участника.
+     * @param parts Количество участников.
+     * @throw std::invalid_argument Если размеры несовместимы, результат подключен только для
+     *        чтения или плитки полосы результата не хранятся.
+     * @throw std::out_of_range Если part не меньше parts.
+     */
+    void multiplyAddRowBand(const SharedBlockMatrix& a, const SharedBlockMatrix& b, size_t part, size_t parts);
+
+    /**
+     * @brief Отметить свою полосу завершенной.
+     * @return Количество завершенных полос, включая эту.
+     * @throw std::invalid_argument Если матрица подключена только для чтения.
+     */
+    size_t finishRowBand() {
+        checkWritable();
+        return header_->finishedBands.fetch_add(1, std::memory_order_acq_rel) + 1;
+    }
+
+    /**
+     * @brief Отметить, что своя полоса не будет досчитана (например, после исключения в
+     * multiplyAddRowBand()); ожидающие участники получат ошибку вместо ожидания до таймаута.
+     * @throw std::invalid_argument Если матрица подключена только для чтения.
+     */
+    void failRowBand() {
+        checkWritable();
+        header_->failedBands.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Начать новый раунд совместного умножения: обнулить счетчики полос.
+     *
+     * Вызывается одним участником, когда все дождались предыдущего раунда и до того, как
+     * кто-либо начнет новый. Участник, еще ждущий предыдущего раунда, по смене номера раунда
+     * считает его завершенным.
+     *
+     * @throw std::invalid_argument Если матрица подключена только для чтения.
+     */
+    void resetRowBands() {
+        checkWritable();
+        header_->finishedBands.store(0, std::memory_order_release);
+        header_->failedBands.store(0, std::memory_order_release);
+        header_->round.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Количество завершенных полос текущего раунда.
+     * @return Значение счетчика.
+     */
+    size_t getFinishedRowBands() const noexcept { return header_->finishedBands.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Номер текущего раунда.
+     * @return Количество вызовов resetRowBands().
+     */
+    size_t getRowBandRound() const noexcept { return header_->round.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Дождаться, пока parts полос текущего раунда будут отмечены завершенными.
+     * @param parts Количество участников.
+     * @param timeout Наибольшее время ожидания.
+     * @return true, если все полосы завершены; false, если время истекло (участник мог упасть,
+     *         не отметив полосу).
+     * @throw std::runtime_error Если участник отметил свою полосу failRowBand().
+     */
+    template <typename Rep, typename Period>
+    bool waitRowBands(size_t parts, std::chrono::duration<Rep, Period> timeout) const {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        const size_t round = getRowBandRound();
+
+        for (;;) {
+            if (getRowBandRound() != round) return true;
+            if (header_->failedBands.load(std::memory_order_acquire) > 0)
+                throw std::runtime_error("A participant failed its row band in shared segment: " + name_);
+            if (getFinishedRowBands() >= parts) return true;
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+};
+
+template <typename MatrixType>
+void SharedBlockMatrix<MatrixType>::multiplyAddRowBand(const SharedBlockMatrix& a, const SharedBlockMatrix& b,
+                                                       size_t part, size_t parts) {
+    if (a.header_->cols != b.header_->rows || header_->rows != a.header_->rows || header_->cols != b.header_->cols)
+        throw std::invalid_argument("Matrix dimensions are incompatible for multiplication");
+
+    if (a.header_->blockCols != b.header_->blockRows || header_->blockRows != a.header_->blockRows ||
+        header_->blockCols != b.header_->blockCols)
+        throw std::invalid_argument("Block sizes are incompatible for multiplication");
+
+    checkWritable();
+    const std::pair<size_t, size_t> band = getRowBand(part, parts);
+    for (size_t t = band.first * numBlocksCol_; t < band.second * numBlocksCol_; ++t)
+        if (tileData(t) == nullptr) throw std::invalid_argument("Result tiles must be stored densely");
+
+    const size_t rows = header_->blockRows, depth = a.header_->blockCols, cols = header_->blockCols;
+    parallelFor(band.first * numBlocksCol_, band.second * numBlocksCol_, [&](size_t t) {
+        const size_t i = t / numBlocksCol_;
+        const size_t j = t % numBlocksCol_;
+        MatrixType* c = tileData(t);
+        std::vector<MatrixType> packed;
+
+        for (size_t k = 0; k < a.numBlocksCol_; ++k) {
+            const MatrixType* left = a.tileData(a.tileIndex(i, k));
+            const MatrixType* right = b.tileData(b.tileIndex(k, j));
+            if (left == nullptr || right == nullptr) continue;
+
+            packTilePanel(left, rows, depth, depth, packed);
+            multiplyAddPackedTile(packed.data(), right, c, rows, depth, cols, cols, cols);
+        }
+    }, 1);
+}
+
+} // namespace matrix_lib
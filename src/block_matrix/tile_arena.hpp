@@ -0,0 +1,179 @@
+/**
+ * @file tile_arena.hpp
+ * @brief Единый выровненный буфер для хранения плиток (блоков) матрицы.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#define TILE_ALIGNMENT 64
+
+namespace matrix_lib {
+
+/**
+ * @brief Непрерывная область памяти, разбитая на плитки одинакового размера.
+ *
+ * Каждая плитка начинается на границе TILE_ALIGNMENT байт (кэш-линии), размер плитки
+ * округляется вверх до целого числа кэш-линий. Память обнуляется при выделении,
+ * копирование выполняется одним memcpy.
+ *
+ * @tparam T Арифметический тип элементов.
+ */
+template <typename T>
+class TileArena {
+    static_assert(std::is_arithmetic<T>::value, "TileArena requires an arithmetic type.");
+
+private:
+    struct AlignedDelete {
+        void operator()(T* pointer) const noexcept { ::operator delete(pointer, std::align_val_t(TILE_ALIGNMENT)); }
+    };
+
+    size_t tileCount_;                          ///< Количество плиток.
+    size_t tileStride_;                         ///< Расстояние между началами плиток в элементах.
+    std::unique_ptr<T[], AlignedDelete> data_;  ///< Выровненная память.
+
+    static T* allocate(size_t count);
+
+public:
+    /**
+     * @brief Пустая область без плиток.
+     */
+    TileArena() noexcept : tileCount_(0), tileStride_(0) {}
+
+    /**
+     * @brief Выделить обнуленную область для плиток.
+     * @param tileCount Количество плиток.
+     * @param tileSize Количество элементов в одной плитке.
+     */
+    TileArena(size_t tileCount, size_t tileSize);
+
+    TileArena(const TileArena& other);
+    TileArena(TileArena&& other) noexcept = default;
+    TileArena& operator=(const TileArena& other);
+    TileArena& operator=(TileArena&& other) noexcept = default;
+
+    /**
+     * @brief Изменить количество плиток с сохранением содержимого первых плиток.
+     *
+     * Новые плитки обнуляются; указатели на плитки после вызова недействительны.
+     *
+     * @param tileCount Новое количество плиток.
+     */
+    void resizeTiles(size_t tileCount);
+
+    /**
+     * @brief Количество плиток.
+     * @return Количество плиток.
+     */
+    size_t getTileCount() const noexcept { return tileCount_; }
+
+    /**
+     * @brief Расстояние между началами соседних плиток.
+     * @return Количество элементов (кратно кэш-линии).
+     */
+    size_t getTileStride() const noexcept { return tileStride_; }
+
+    /**
+     * @brief Общее количество элементов области (с выравниванием).
+     * @return Количество элементов.
+     */
+    size_t size() const noexcept { return tileCount_ * tileStride_; }
+
+    /**
+     * @brief Начало области.
+     * @return Указатель на первый элемент.
+     */
+    T* data() noexcept { return data_.get(); }
+
+    /**
+     * @brief Начало области.
+     * @return Указатель на первый элемент.
+     */
+    const T* data() const noexcept { return data_.get(); }
+
+    /**
+     * @brief Начало плитки.
+     * @param index Номер плитки.
+     * @return Указатель на первый элемент плитки (выровнен по кэш-линии).
+     */
+    T* tile(size_t index) noexcept { return data_.get() + index * tileStride_; }
+
+    /**
+     * @brief Начало плитки.
+     * @param index Номер плитки.
+     * @return Указатель на первый элемент плитки (выровнен по кэш-линии).
+     */
+    const T* tile(size_t index) const noexcept { return data_.get() + index * tileStride_; }
+};
+
+/**
+ * @brief Плитка, хранящаяся в области TileArena другой матрицы.
+ *
+ * Владение областью общее, поэтому плитка остается действительной и после уничтожения
+ * исходной матрицы; сама область через эту ссылку не изменяется.
+ *
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct SharedTile {
+    std::shared_ptr<const TileArena<T>> arena;  ///< Область с плиткой.
+    size_t slot;                                ///< Номер плитки в области.
+
+    /**
+     * @brief Начало плитки.
+     * @return Указатель на первый элемент плитки.
+     */
+    const T* data() const noexcept { return arena->tile(slot); }
+};
+
+template <typename T>
+T* TileArena<T>::allocate(size_t count) {
+    if (count == 0) return nullptr;
+
+    T* pointer = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(TILE_ALIGNMENT)));
+    std::memset(pointer, 0, count * sizeof(T));
+
+    return pointer;
+}
+
+template <typename T>
+TileArena<T>::TileArena(size_t tileCount, size_t tileSize) : tileCount_(tileCount) {
+    const size_t line = TILE_ALIGNMENT / sizeof(T) > 0 ? TILE_ALIGNMENT / sizeof(T) : 1;
+    tileStride_ = (tileSize + line - 1) / line * line;
+    data_.reset(allocate(size()));
+}
+
+template <typename T>
+TileArena<T>::TileArena(const TileArena& other) : tileCount_(other.tileCount_), tileStride_(other.tileStride_) {
+    data_.reset(allocate(size()));
+    if (size() > 0) std::memcpy(data_.get(), other.data_.get(), size() * sizeof(T));
+}
+
+template <typename T>
+void TileArena<T>::resizeTiles(size_t tileCount) {
+    if (tileCount == tileCount_) return;
+
+    const size_t kept = std::min(tileCount, tileCount_) * tileStride_;
+    std::unique_ptr<T[], AlignedDelete> data(allocate(tileCount * tileStride_));
+    if (kept > 0) std::memcpy(data.get(), data_.get(), kept * sizeof(T));
+
+    data_ = std::move(data);
+    tileCount_ = tileCount;
+}
+
+template <typename T>
+TileArena<T>& TileArena<T>::operator=(const TileArena& other) {
+    if (this != &other) {
+        TileArena temp(other);
+        *this = std::move(temp);
+    }
+
+    return *this;
+}
+
+} // namespace matrix_lib
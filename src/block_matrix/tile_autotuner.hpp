@@ -0,0 +1,252 @@
+/**
+ * @file tile_autotuner.hpp
+ * @brief Автоматический подбор размера плиток блочной матрицы с сохранением профиля.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "tile_arena.hpp"
+#include "tile_kernel.hpp"
+
+#define TILE_AUTOTUNE_SIZE 192
+
+#define TILE_AUTOTUNE_REPEATS 3
+
+#define TILE_PROFILE_ENV "MATRIX_LIB_TILE_PROFILE"
+
+#define TILE_PROFILE_DEFAULT_PATH "matrix_lib_tiles.profile"
+
+namespace matrix_lib {
+
+/**
+ * @brief Операция, для которой подбирается размер плитки.
+ */
+enum class TileOperation {
+    Multiply    ///< Умножение блочных матриц.
+};
+
+/**
+ * @brief Размер плитки.
+ */
+struct TileShape {
+    size_t rows;  ///< Количество строк плитки.
+    size_t cols;  ///< Количество столбцов плитки.
+};
+
+/**
+ * @brief Подбор размера плиток по замерам на текущей машине.
+ *
+ * Для пары (тип элементов, операция) размер плитки определяется один раз: берется из файла
+ * профиля, а если записи нет — замеряются кандидаты на задаче TILE_AUTOTUNE_SIZE x
+ * TILE_AUTOTUNE_SIZE, лучший результат запоминается и дописывается в профиль. Кандидаты —
+ * все сочетания строк и столбцов из 16, 32, 64, в том числе прямоугольные: плитка
+ * rows x cols замеряется так, как ее умножает BlockMatrix::operator*, — C и A разбиты на
+ * плитки rows x cols, B на плитки cols x cols. Путь к профилю
+ * задается setProfilePath(), переменной окружения TILE_PROFILE_ENV или по умолчанию
+ * TILE_PROFILE_DEFAULT_PATH в текущем каталоге. Ошибка записи профиля не считается ошибкой:
+ * результат остается в памяти процесса.
+ */
+class TileAutotuner {
+private:
+    std::mutex mutex_;
+    std::string path_;
+    bool loaded_ = false;
+    std::map<std::string, TileShape> shapes_;
+
+    TileAutotuner() {
+        const char* path = std::getenv(TILE_PROFILE_ENV);
+        path_ = path != nullptr ? path : TILE_PROFILE_DEFAULT_PATH;
+    }
+
+    static const char* operationName(TileOperation) noexcept { return "multiply"; }
+
+    template <typename T>
+    static std::string typeName() {
+        const char kind = std::is_floating_point<T>::value ? 'f' : (std::is_signed<T>::value ? 'i' : 'u');
+        return kind + std::to_string(sizeof(T));
+    }
+
+    template <typename T>
+    static std::string key(TileOperation operation) {
+        return std::string(operationName(operation)) + " " + typeName<T>();
+    }
+
+    void loadLocked() {
+        if (loaded_) return;
+        loaded_ = true;
+
+        std::ifstream in(path_);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream fields(line);
+            std::string operation, type;
+            TileShape shape{ 0, 0 };
+            if (fields >> operation >> type >> shape.rows >> shape.cols && shape.rows > 0 && shape.cols > 0)
+                shapes_.emplace(operation + " " + type, shape);
+        }
+    }
+
+    bool saveLocked() const {
+        std::ofstream out(path_, std::ios::trunc);
+        if (!out) return false;
+
+        out << "# operation type rows cols\n";
+        for (const auto& entry : shapes_) out << entry.first << ' ' << entry.second.rows << ' ' << entry.second.cols << '\n';
+
+        return static_cast<bool>(out);
+    }
+
+    template <typename T>
+    static double measureMultiply(TileShape shape, size_t size) {
+        const size_t blockRows = size / shape.rows, blockCols = size / shape.cols;
+        const size_t tileA = shape.rows * shape.cols, tileB = shape.cols * shape.cols;
+        TileArena<T> a(blockRows * blockCols, tileA), b(blockCols * blockCols, tileB), c(blockRows * blockCols, tileA);
+        for (size_t k = 0; k < a.size(); ++k) a.data()[k] = static_cast<T>(k % 7);
+        for (size_t k = 0; k < b.size(); ++k) b.data()[k] = static_cast<T>(k % 5);
+
+        std::vector<T> packed;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < blockRows; ++i)
+            for (size_t k = 0; k < blockCols; ++k) {
+                packTilePanel(a.tile(i * blockCols + k), shape.rows, shape.cols, shape.cols, packed);
+                for (size_t j = 0; j < blockCols; ++j)
+                    multiplyAddPackedTile(packed.data(), b.tile(k * blockCols + j), c.tile(i * blockCols + j),
+                                          shape.rows, shape.cols, shape.cols, shape.cols, shape.cols);
+            }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template <typename T>
+    static TileShape benchmark(size_t size) {
+        static const size_t candidates[] = { 16, 32, 64 };
+
+        TileShape best{ size, size };
+        double bestTime = -1.0;
+
+        for (size_t rows : candidates)
+            for (size_t cols : candidates) {
+                if (rows > size || cols > size || size % rows != 0 || size % cols != 0) continue;
+
+                double time = -1.0;
+                for (size_t repeat = 0; repeat < TILE_AUTOTUNE_REPEATS; ++repeat) {
+                    const double sample = measureMultiply<T>(TileShape{ rows, cols }, size);
+                    if (time < 0.0 || sample < time) time = sample;
+                }
+
+                if (bestTime < 0.0 || time < bestTime) {
+                    bestTime = time;
+                    best = TileShape{ rows, cols };
+                }
+            }
+
+        return best;
+    }
+
+public:
+    TileAutotuner(const TileAutotuner&) = delete;
+    TileAutotuner& operator=(const TileAutotuner&) = delete;
+
+    /**
+     * @brief Общий экземпляр подбора.
+     * @return Экземпляр, создаваемый при первом обращении.
+     */
+    static TileAutotuner& instance() {
+        static TileAutotuner tuner;
+        return tuner;
+    }
+
+    /**
+     * @brief Путь к файлу профиля.
+     * @return Путь.
+     */
+    std::string getProfilePath() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return path_;
+    }
+
+    /**
+     * @brief Сменить файл профиля; результаты в памяти сбрасываются и будут прочитаны из нового файла.
+     * @param path Путь к файлу.
+     */
+    void setProfilePath(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        path_ = path;
+        loaded_ = false;
+        shapes_.clear();
+    }
+
+    /**
+     * @brief Размер плитки для типа и операции (при первом обращении — из профиля или замером).
+     * @tparam T Тип элементов.
+     * @param operation Операция.
+     * @return Размер плитки.
+     */
+    template <typename T>
+    TileShape getTileShape(TileOperation operation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loadLocked();
+
+        const std::string name = key<T>(operation);
+        auto it = shapes_.find(name);
+        if (it != shapes_.end()) return it->second;
+
+        const TileShape shape = benchmark<T>(TILE_AUTOTUNE_SIZE);
+        shapes_[name] = shape;
+        saveLocked();
+
+        return shape;
+    }
+
+    /**
+     * @brief Задать размер плитки вручную и сохранить его в профиль.
+     * @tparam T Тип элементов.
+     * @param operation Операция.
+     * @param shape Размер плитки.
+     * @throw std::invalid_argument Если размер плитки равен нулю.
+     */
+    template <typename T>
+    void setTileShape(TileOperation operation, TileShape shape) {
+        if (shape.rows == 0 || shape.cols == 0)
+            throw std::invalid_argument("Tile size must be positive");
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        loadLocked();
+        shapes_[key<T>(operation)] = shape;
+        saveLocked();
+    }
+
+    /**
+     * @brief Заново замерить кандидатов и сохранить результат в профиль.
+     * @tparam T Тип элементов.
+     * @param operation Операция.
+     * @param size Размер задачи для замера (кандидаты, не делящие его, пропускаются).
+     * @return Выбранный размер плитки.
+     */
+    template <typename T>
+    TileShape calibrate(TileOperation operation, size_t size = TILE_AUTOTUNE_SIZE) {
+        const TileShape shape = benchmark<T>(size);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        loadLocked();
+        shapes_[key<T>(operation)] = shape;
+        saveLocked();
+
+        return shape;
+    }
+};
+
+} // namespace matrix_lib
@@ -0,0 +1,182 @@
+/**
+ * @file tile_factorization.hpp
+ * @brief Ядра над плитками для блочных LU- и Холецкого-разложений (getrf, potrf, trsm, gemm, syrk).
+ *
+ * Все плитки хранятся по строкам с общим шагом ld.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "tile_kernel.hpp"
+
+namespace matrix_lib {
+
+/**
+ * @brief LU-разложение плитки без выбора ведущего элемента (getrf): A = L * U на месте.
+ * @param a Плитка n x n; на выходе ниже диагонали L (единичная диагональ не хранится), выше — U.
+ * @param n Порядок плитки.
+ * @param ld Шаг строк.
+ * @throw std::domain_error Если встретился нулевой ведущий элемент.
+ */
+template <typename T>
+void factorizeLUTile(T* a, size_t n, size_t ld) {
+    for (size_t p = 0; p < n; ++p) {
+        const T pivot = a[p * ld + p];
+        if (pivot == static_cast<T>(0))
+            throw std::domain_error("Zero pivot in block LU factorization");
+
+        for (size_t i = p + 1; i < n; ++i) {
+            T* row = a + i * ld;
+            const T factor = row[p] / pivot;
+            row[p] = factor;
+            for (size_t j = p + 1; j < n; ++j) row[j] -= factor * a[p * ld + j];
+        }
+    }
+}
+
+/**
+ * @brief Разложение Холецкого плитки (potrf): A = L * L^T, L записывается в нижний треугольник.
+ * @param a Симметричная плитка n x n (читается нижний треугольник).
+ * @param n Порядок плитки.
+ * @param ld Шаг строк.
+ * @throw std::domain_error Если матрица не положительно определена.
+ */
+template <typename T>
+void factorizeCholeskyTile(T* a, size_t n, size_t ld) {
+    for (size_t j = 0; j < n; ++j) {
+        T diagonal = a[j * ld + j];
+        for (size_t p = 0; p < j; ++p) diagonal -= a[j * ld + p] * a[j * ld + p];
+
+        if (!(diagonal > static_cast<T>(0)))
+            throw std::domain_error("Matrix is not positive definite");
+
+        const T root = std::sqrt(diagonal);
+        a[j * ld + j] = root;
+
+        for (size_t i = j + 1; i < n; ++i) {
+            T value = a[i * ld + j];
+            for (size_t p = 0; p < j; ++p) value -= a[i * ld + p] * a[j * ld + p];
+            a[i * ld + j] = value / root;
+        }
+    }
+}
+
+/**
+ * @brief B := L^{-1} * B, L — нижняя унитреугольная плитка (trsm слева).
+ * @param l Плитка L n x n.
+ * @param b Плитка B n x m.
+ * @param n Порядок L.
+ * @param m Количество столбцов B.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void solveLowerUnitTile(const T* l, T* b, size_t n, size_t m, size_t ld) {
+    for (size_t i = 1; i < n; ++i)
+        for (size_t p = 0; p < i; ++p) {
+            const T factor = l[i * ld + p];
+            for (size_t j = 0; j < m; ++j) b[i * ld + j] -= factor * b[p * ld + j];
+        }
+}
+
+/**
+ * @brief B := B * U^{-1}, U — верхняя треугольная плитка (trsm справа).
+ * @param u Плитка U n x n.
+ * @param b Плитка B m x n.
+ * @param m Количество строк B.
+ * @param n Порядок U.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void solveUpperRightTile(const T* u, T* b, size_t m, size_t n, size_t ld) {
+    for (size_t i = 0; i < m; ++i) {
+        T* row = b + i * ld;
+        for (size_t j = 0; j < n; ++j) {
+            T value = row[j];
+            for (size_t p = 0; p < j; ++p) value -= row[p] * u[p * ld + j];
+            row[j] = value / u[j * ld + j];
+        }
+    }
+}
+
+/**
+ * @brief B := B * L^{-T}, L — нижняя треугольная плитка (trsm справа для Холецкого).
+ * @param l Плитка L n x n.
+ * @param b Плитка B m x n.
+ * @param m Количество строк B.
+ * @param n Порядок L.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void solveLowerTransposedRightTile(const T* l, T* b, size_t m, size_t n, size_t ld) {
+    for (size_t i = 0; i < m; ++i) {
+        T* row = b + i * ld;
+        for (size_t j = 0; j < n; ++j) {
+            T value = row[j];
+            for (size_t p = 0; p < j; ++p) value -= row[p] * l[j * ld + p];
+            row[j] = value / l[j * ld + j];
+        }
+    }
+}
+
+/**
+ * @brief C -= A * B (gemm) через упакованное микроядро.
+ * @param a Плитка A m x k.
+ * @param b Плитка B k x n.
+ * @param c Плитка C m x n.
+ * @param m Количество строк A и C.
+ * @param k Количество столбцов A и строк B.
+ * @param n Количество столбцов B и C.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void multiplySubtractTile(const T* a, const T* b, T* c, size_t m, size_t k, size_t n, size_t ld) {
+    std::vector<T> packed;
+    packTilePanel(a, m, k, ld, packed);
+    for (T& value : packed) value = -value;
+
+    multiplyAddPackedTile(packed.data(), b, c, m, k, n, ld, ld);
+}
+
+/**
+ * @brief C -= A * B^T (gemm с транспонированным правым множителем).
+ * @param a Плитка A m x k.
+ * @param b Плитка B n x k.
+ * @param c Плитка C m x n.
+ * @param m Количество строк A и C.
+ * @param k Количество столбцов A и B.
+ * @param n Количество строк B и столбцов C.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void multiplySubtractTransposedTile(const T* a, const T* b, T* c, size_t m, size_t k, size_t n, size_t ld) {
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            T sum = static_cast<T>(0);
+            for (size_t p = 0; p < k; ++p) sum += a[i * ld + p] * b[j * ld + p];
+            c[i * ld + j] -= sum;
+        }
+}
+
+/**
+ * @brief C -= A * A^T для нижнего треугольника C (syrk).
+ * @param a Плитка A n x k.
+ * @param c Плитка C n x n.
+ * @param n Порядок C.
+ * @param k Количество столбцов A.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void symmetricRankUpdateTile(const T* a, T* c, size_t n, size_t k, size_t ld) {
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j <= i; ++j) {
+            T sum = static_cast<T>(0);
+            for (size_t p = 0; p < k; ++p) sum += a[i * ld + p] * a[j * ld + p];
+            c[i * ld + j] -= sum;
+        }
+}
+
+} // namespace matrix_lib
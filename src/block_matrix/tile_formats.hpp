@@ -0,0 +1,187 @@
+/**
+ * @file tile_formats.hpp
+ * @brief Форматы неплотных плиток блочной матрицы: разреженная (CSR) и малоранговая (U * V^T).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "../sparse_matrix/sparse_matrix.hpp"
+
+#define TILE_SPARSE_MAX_FILL 0.25
+
+namespace matrix_lib {
+
+/**
+ * @brief Малоранговая плитка A = U * V^T.
+ *
+ * U (height x rank) и V (width x rank) хранятся по строкам, поэтому строка A(r, :) — это
+ * комбинация строк V с коэффициентами U(r, :).
+ */
+template <typename T>
+struct LowRankTile {
+    size_t height;      ///< Количество строк плитки.
+    size_t width;       ///< Количество столбцов плитки.
+    size_t rank;        ///< Ранг разложения.
+    std::vector<T> u;   ///< Множитель U (height x rank).
+    std::vector<T> v;   ///< Множитель V (width x rank).
+};
+
+/**
+ * @brief Элемент малоранговой плитки.
+ * @param tile Плитка.
+ * @param row Строка.
+ * @param col Столбец.
+ * @return Значение (U(row, :), V(col, :)).
+ */
+template <typename T>
+T lowRankElement(const LowRankTile<T>& tile, size_t row, size_t col) noexcept {
+    T sum = static_cast<T>(0);
+    for (size_t s = 0; s < tile.rank; ++s) sum += tile.u[row * tile.rank + s] * tile.v[col * tile.rank + s];
+    return sum;
+}
+
+/**
+ * @brief C += factor * U * V^T.
+ * @param u Множитель U (height x rank, по строкам).
+ * @param v Множитель V (width x rank, по строкам).
+ * @param rank Ранг.
+ * @param height Количество строк C.
+ * @param width Количество столбцов C.
+ * @param factor Множитель.
+ * @param c Плитка C (по строкам, шаг ldc).
+ * @param ldc Шаг строк C.
+ */
+template <typename T>
+void addLowRankProductTile(const T* u, const T* v, size_t rank, size_t height, size_t width, T factor, T* c, size_t ldc) {
+    for (size_t r = 0; r < height; ++r)
+        for (size_t s = 0; s < rank; ++s) {
+            const T coefficient = factor * u[r * rank + s];
+            if (coefficient == static_cast<T>(0)) continue;
+            for (size_t q = 0; q < width; ++q) c[r * ldc + q] += coefficient * v[q * rank + s];
+        }
+}
+
+/**
+ * @brief Транспонировать разреженную плитку.
+ * @param csr Плитка height x width.
+ * @param width Количество столбцов плитки.
+ * @return Плитка width x height.
+ */
+template <typename T>
+CompressedRows<T> transposeCompressedTile(const CompressedRows<T>& csr, size_t width) {
+    const size_t height = csr.rowPtr.size() - 1;
+    CompressedRows<T> result{ std::vector<size_t>(width + 1, 0), std::vector<size_t>(csr.colIdx.size()),
+                              std::vector<T>(csr.values.size()) };
+
+    for (size_t col : csr.colIdx) ++result.rowPtr[col + 1];
+    for (size_t q = 0; q < width; ++q) result.rowPtr[q + 1] += result.rowPtr[q];
+
+    std::vector<size_t> next(result.rowPtr.begin(), result.rowPtr.end() - 1);
+    for (size_t r = 0; r < height; ++r)
+        for (size_t p = csr.rowPtr[r]; p < csr.rowPtr[r + 1]; ++p) {
+            result.colIdx[next[csr.colIdx[p]]] = r;
+            result.values[next[csr.colIdx[p]]++] = csr.values[p];
+        }
+
+    return result;
+}
+
+/**
+ * @brief Крестовая аппроксимация (ACA с частичным выбором ведущего элемента) плитки.
+ *
+ * На каждом шаге берется строка остатка, в ней — максимальный по модулю элемент, и к
+ * разложению добавляется крест из этой строки и соответствующего столбца; следующая строка
+ * выбирается по максимуму нового столбца. Плитка целиком не строится: вычисляется
+ * O((height + width) * rank) элементов. Остановка — когда норма последнего креста не
+ * превосходит tolerance от оценки нормы всего приближения.
+ *
+ * @tparam T Вещественный тип элементов.
+ * @tparam Entry Тип вызываемого объекта `T(size_t row, size_t col)`.
+ * @param height Количество строк плитки.
+ * @param width Количество столбцов плитки.
+ * @param entry Элементы плитки.
+ * @param tolerance Относительная точность.
+ * @param maxRank Наибольший допустимый ранг.
+ * @param result Приближение U * V^T.
+ * @return true, если точность достигнута не более чем за maxRank шагов.
+ */
+template <typename T, typename Entry>
+bool approximateCrossTile(size_t height, size_t width, Entry entry, double tolerance, size_t maxRank, LowRankTile<T>& result) {
+    static_assert(std::is_floating_point<T>::value, "Cross approximation requires a floating-point type.");
+
+    std::vector<std::vector<T>> us, vs;
+    std::vector<char> usedRows(height, 0);
+    std::vector<T> row(width), col(height);
+    double normSquared = 0.0;
+    size_t pivotRow = 0;
+    bool converged = height == 0 || width == 0;
+
+    while (!converged && us.size() < maxRank) {
+        usedRows[pivotRow] = 1;
+        for (size_t q = 0; q < width; ++q) {
+            row[q] = entry(pivotRow, q);
+            for (size_t s = 0; s < us.size(); ++s) row[q] -= us[s][pivotRow] * vs[s][q];
+        }
+
+        size_t pivotCol = 0;
+        for (size_t q = 1; q < width; ++q)
+            if (std::abs(row[q]) > std::abs(row[pivotCol])) pivotCol = q;
+
+        if (row[pivotCol] == static_cast<T>(0)) {
+            if (!us.empty()) {
+                converged = true;
+                break;
+            }
+
+            while (pivotRow < height && usedRows[pivotRow]) ++pivotRow;
+            converged = pivotRow == height;
+            continue;
+        }
+
+        const T pivot = row[pivotCol];
+        for (size_t r = 0; r < height; ++r) {
+            col[r] = entry(r, pivotCol);
+            for (size_t s = 0; s < us.size(); ++s) col[r] -= us[s][r] * vs[s][pivotCol];
+        }
+        for (size_t q = 0; q < width; ++q) row[q] /= pivot;
+
+        double uu = 0.0, vv = 0.0;
+        for (size_t r = 0; r < height; ++r) uu += static_cast<double>(col[r]) * static_cast<double>(col[r]);
+        for (size_t q = 0; q < width; ++q) vv += static_cast<double>(row[q]) * static_cast<double>(row[q]);
+
+        for (size_t s = 0; s < us.size(); ++s) {
+            double uDot = 0.0, vDot = 0.0;
+            for (size_t r = 0; r < height; ++r) uDot += static_cast<double>(col[r]) * static_cast<double>(us[s][r]);
+            for (size_t q = 0; q < width; ++q) vDot += static_cast<double>(row[q]) * static_cast<double>(vs[s][q]);
+            normSquared += 2.0 * uDot * vDot;
+        }
+        normSquared += uu * vv;
+
+        us.push_back(col);
+        vs.push_back(row);
+        converged = std::sqrt(uu * vv) <= tolerance * std::sqrt(std::max(normSquared, 0.0));
+
+        pivotRow = height;
+        for (size_t r = 0; r < height; ++r)
+            if (!usedRows[r] && (pivotRow == height || std::abs(col[r]) > std::abs(col[pivotRow]))) pivotRow = r;
+        if (pivotRow == height) converged = true;
+    }
+
+    if (!converged && us.size() == maxRank && maxRank == std::min(height, width)) converged = true;
+
+    const size_t rank = us.size();
+    result = LowRankTile<T>{ height, width, rank, std::vector<T>(height * rank), std::vector<T>(width * rank) };
+    for (size_t s = 0; s < rank; ++s) {
+        for (size_t r = 0; r < height; ++r) result.u[r * rank + s] = us[s][r];
+        for (size_t q = 0; q < width; ++q) result.v[q * rank + s] = vs[s][q];
+    }
+
+    return converged;
+}
+
+} // namespace matrix_lib
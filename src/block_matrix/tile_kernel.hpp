@@ -0,0 +1,162 @@
+/**
+ * @file tile_kernel.hpp
+ * @brief Микроядро умножения плиток с упаковкой панели левого множителя.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#define TILE_MICRO_ROWS 4
+
+#define TILE_MICRO_COLS 8
+
+#define TILE_TRANSPOSE_BLOCK 8
+
+namespace matrix_lib {
+
+/**
+ * @brief Упаковать плитку A в полосы по TILE_MICRO_ROWS строк.
+ *
+ * В полосе элементы одного столбца p из TILE_MICRO_ROWS строк лежат подряд, поэтому
+ * микроядро читает A последовательно. Строки за пределами плитки заполняются нулями.
+ *
+ * @tparam T Тип элементов.
+ * @param a Плитка A (по строкам, шаг lda).
+ * @param rows Количество строк A.
+ * @param depth Количество столбцов A.
+ * @param lda Шаг строк A.
+ * @param packed Буфер упаковки (размер изменяется).
+ */
+template <typename T>
+void packTilePanel(const T* a, size_t rows, size_t depth, size_t lda, std::vector<T>& packed) {
+    const size_t strips = (rows + TILE_MICRO_ROWS - 1) / TILE_MICRO_ROWS;
+    packed.assign(strips * TILE_MICRO_ROWS * depth, static_cast<T>(0));
+
+    for (size_t s = 0; s < strips; ++s) {
+        T* strip = packed.data() + s * TILE_MICRO_ROWS * depth;
+        const size_t height = std::min<size_t>(TILE_MICRO_ROWS, rows - s * TILE_MICRO_ROWS);
+
+        for (size_t r = 0; r < height; ++r) {
+            const T* row = a + (s * TILE_MICRO_ROWS + r) * lda;
+            for (size_t p = 0; p < depth; ++p) strip[p * TILE_MICRO_ROWS + r] = row[p];
+        }
+    }
+}
+
+/**
+ * @brief C += A * B для упакованной панели A и плитки B.
+ *
+ * Блок TILE_MICRO_ROWS x TILE_MICRO_COLS результата накапливается в локальном массиве
+ * (в регистрах) по всей глубине и добавляется в C один раз.
+ *
+ * @tparam T Тип элементов.
+ * @param packed Панель A после packTilePanel().
+ * @param b Плитка B (по строкам, шаг ldb).
+ * @param c Плитка C (по строкам, шаг ldc).
+ * @param rows Количество строк A и C.
+ * @param depth Количество столбцов A и строк B.
+ * @param cols Количество столбцов B и C.
+ * @param ldb Шаг строк B.
+ * @param ldc Шаг строк C.
+ */
+template <typename T>
+void multiplyAddPackedTile(const T* packed, const T* b, T* c, size_t rows, size_t depth, size_t cols,
+                           size_t ldb, size_t ldc) {
+    for (size_t i0 = 0; i0 < rows; i0 += TILE_MICRO_ROWS) {
+        const T* strip = packed + (i0 / TILE_MICRO_ROWS) * TILE_MICRO_ROWS * depth;
+        const size_t height = std::min<size_t>(TILE_MICRO_ROWS, rows - i0);
+
+        for (size_t j0 = 0; j0 < cols; j0 += TILE_MICRO_COLS) {
+            const size_t width = std::min<size_t>(TILE_MICRO_COLS, cols - j0);
+            T acc[TILE_MICRO_ROWS][TILE_MICRO_COLS] = {};
+
+            if (width == TILE_MICRO_COLS) {
+                for (size_t p = 0; p < depth; ++p) {
+                    const T* bp = b + p * ldb + j0;
+                    const T* ap = strip + p * TILE_MICRO_ROWS;
+                    for (size_t r = 0; r < TILE_MICRO_ROWS; ++r)
+                        for (size_t q = 0; q < TILE_MICRO_COLS; ++q) acc[r][q] += ap[r] * bp[q];
+                }
+            } else {
+                for (size_t p = 0; p < depth; ++p) {
+                    const T* bp = b + p * ldb + j0;
+                    const T* ap = strip + p * TILE_MICRO_ROWS;
+                    for (size_t r = 0; r < TILE_MICRO_ROWS; ++r)
+                        for (size_t q = 0; q < width; ++q) acc[r][q] += ap[r] * bp[q];
+                }
+            }
+
+            for (size_t r = 0; r < height; ++r) {
+                T* cr = c + (i0 + r) * ldc + j0;
+                for (size_t q = 0; q < width; ++q) cr[q] += acc[r][q];
+            }
+        }
+    }
+}
+
+/**
+ * @brief dst = src^T для плитки rows x cols.
+ *
+ * Плитка обходится квадратами TILE_TRANSPOSE_BLOCK x TILE_TRANSPOSE_BLOCK: внутри квадрата
+ * строки src и dst помещаются в кэш-линии, а внутренний цикл фиксированной длины компилятор
+ * разворачивает и векторизует.
+ *
+ * @tparam T Тип элементов.
+ * @param src Исходная плитка (по строкам, шаг lds).
+ * @param dst Результат cols x rows (по строкам, шаг ldd); не должен пересекаться с src.
+ * @param rows Количество строк src.
+ * @param cols Количество столбцов src.
+ * @param lds Шаг строк src.
+ * @param ldd Шаг строк dst.
+ */
+template <typename T>
+void transposeTile(const T* src, T* dst, size_t rows, size_t cols, size_t lds, size_t ldd) {
+    for (size_t r0 = 0; r0 < rows; r0 += TILE_TRANSPOSE_BLOCK) {
+        const size_t height = std::min<size_t>(TILE_TRANSPOSE_BLOCK, rows - r0);
+
+        for (size_t c0 = 0; c0 < cols; c0 += TILE_TRANSPOSE_BLOCK) {
+            const size_t width = std::min<size_t>(TILE_TRANSPOSE_BLOCK, cols - c0);
+
+            if (height == TILE_TRANSPOSE_BLOCK && width == TILE_TRANSPOSE_BLOCK) {
+                for (size_t c = 0; c < TILE_TRANSPOSE_BLOCK; ++c)
+                    for (size_t r = 0; r < TILE_TRANSPOSE_BLOCK; ++r)
+                        dst[(c0 + c) * ldd + r0 + r] = src[(r0 + r) * lds + c0 + c];
+            } else {
+                for (size_t c = 0; c < width; ++c)
+                    for (size_t r = 0; r < height; ++r) dst[(c0 + c) * ldd + r0 + r] = src[(r0 + r) * lds + c0 + c];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Транспонировать квадратную плитку n x n на месте.
+ *
+ * Квадраты TILE_TRANSPOSE_BLOCK x TILE_TRANSPOSE_BLOCK над диагональю меняются местами с
+ * симметричными им, диагональные квадраты транспонируются внутри себя.
+ *
+ * @tparam T Тип элементов.
+ * @param a Плитка (по строкам, шаг ld).
+ * @param n Порядок плитки.
+ * @param ld Шаг строк.
+ */
+template <typename T>
+void transposeSquareTile(T* a, size_t n, size_t ld) {
+    for (size_t r0 = 0; r0 < n; r0 += TILE_TRANSPOSE_BLOCK) {
+        const size_t height = std::min<size_t>(TILE_TRANSPOSE_BLOCK, n - r0);
+
+        for (size_t r = 0; r < height; ++r)
+            for (size_t c = r + 1; c < height; ++c) std::swap(a[(r0 + r) * ld + r0 + c], a[(r0 + c) * ld + r0 + r]);
+
+        for (size_t c0 = r0 + TILE_TRANSPOSE_BLOCK; c0 < n; c0 += TILE_TRANSPOSE_BLOCK) {
+            const size_t width = std::min<size_t>(TILE_TRANSPOSE_BLOCK, n - c0);
+            for (size_t r = 0; r < height; ++r)
+                for (size_t c = 0; c < width; ++c) std::swap(a[(r0 + r) * ld + c0 + c], a[(c0 + c) * ld + r0 + r]);
+        }
+    }
+}
+
+} // namespace matrix_lib
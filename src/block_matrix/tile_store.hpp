@@ -0,0 +1,382 @@
+/**
+ * @file tile_store.hpp
+ * @brief Хранилище плиток в файле с LRU-кэшем в памяти и фоновой предзагрузкой.
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define TILE_STORE_DEFAULT_BUDGET (size_t(256) << 20)
+
+namespace matrix_lib {
+
+/**
+ * @brief Плитки фиксированного размера в файле подкачки с кэшем горячих плиток.
+ *
+ * Плитка i занимает в файле участок [i * stride, (i + 1) * stride) элементов; файл создается
+ * заново (нулевым) и удаляется вместе с хранилищем. В памяти держится не больше
+ * budget байт плиток: при переполнении вытесняется давно не использовавшаяся незакрепленная
+ * плитка, измененная плитка перед вытеснением записывается в файл. Закрепленные плитки не
+ * вытесняются, поэтому бюджет — мягкая граница: одновременно закрепленных плиток может быть
+ * больше. Фоновый поток загружает плитки, запрошенные prefetch(), пока вычисления идут над
+ * другими плитками. Все методы потокобезопасны; чтение и запись при загрузке и вытеснении
+ * используют pread/pwrite без удержания общей блокировки.
+ *
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+class TileStore {
+private:
+    struct Entry {
+        std::vector<T> data;
+        std::list<size_t>::iterator position;  ///< Место в очереди LRU.
+        size_t pins = 0;
+        bool dirty = false;
+        bool ready = false;                    ///< Данные загружены и не записываются в файл.
+        bool failed = false;
+    };
+
+    std::string path_;
+    int fd_;
+    size_t tileCount_;
+    size_t tileStride_;
+    size_t capacity_;                          ///< Бюджет в плитках.
+
+    std::mutex mutex_;
+    std::condition_variable loaded_;           ///< Сигнал о завершении загрузки плитки.
+    std::unordered_map<size_t, Entry> cache_;
+    std::list<size_t> lru_;                    ///< Начало — последние использованные плитки.
+
+    std::thread worker_;
+    std::condition_variable requested_;        ///< Сигнал о новых запросах предзагрузки.
+    std::deque<size_t> requests_;
+    bool stopping_ = false;
+
+    std::atomic<size_t> hits_{ 0 };
+    std::atomic<size_t> misses_{ 0 };
+    std::atomic<size_t> evictions_{ 0 };
+    std::atomic<size_t> prefetched_{ 0 };
+
+    off_t offset(size_t index) const noexcept {
+        return static_cast<off_t>(index * tileStride_ * sizeof(T));
+    }
+
+    bool readTile(size_t index, T* data) const noexcept {
+        const size_t bytes = tileStride_ * sizeof(T);
+        return pread(fd_, data, bytes, offset(index)) == static_cast<ssize_t>(bytes);
+    }
+
+    bool writeTile(size_t index, const T* data) const noexcept {
+        const size_t bytes = tileStride_ * sizeof(T);
+        return pwrite(fd_, data, bytes, offset(index)) == static_cast<ssize_t>(bytes);
+    }
+
+    void eraseLocked(size_t index) {
+        lru_.erase(cache_.at(index).position);
+        cache_.erase(index);
+    }
+
+    /**
+     * Измененная плитка записывается без удержания блокировки: на время записи она помечается
+     * неготовой, поэтому pin() ждет loaded_, а другие вытеснения ее пропускают. Плитка, которую
+     * не удалось записать, остается в памяти измененной.
+     */
+    void evictLocked(std::unique_lock<std::mutex>& lock) {
+        std::vector<size_t> unwritable;
+        while (cache_.size() > capacity_) {
+            auto it = lru_.end();
+            Entry* victim = nullptr;
+            while (it != lru_.begin()) {
+                --it;
+                Entry& entry = cache_.at(*it);
+                if (entry.pins > 0 || !entry.ready) continue;
+                if (entry.dirty && !entry.failed && std::find(unwritable.begin(), unwritable.end(), *it) != unwritable.end())
+                    continue;
+
+                victim = &entry;
+                break;
+            }
+            if (victim == nullptr) return;
+
+            const size_t index = *it;
+            if (victim->dirty && !victim->failed) {
+                victim->ready = false;
+                lock.unlock();
+                const bool ok = writeTile(index, victim->data.data());
+                lock.lock();
+
+                victim->ready = true;
+                loaded_.notify_all();
+                if (!ok) {
+                    unwritable.push_back(index);
+                    continue;
+                }
+                victim->dirty = false;
+                if (victim->pins > 0) continue;
+            }
+
+            eraseLocked(index);
+            ++evictions_;
+        }
+    }
+
+    /**
+     * Загрузка без удержания блокировки: запись видна другим потокам как неготовая, они ждут
+     * loaded_, а вытеснение ее пропускает.
+     */
+    Entry& loadLocked(size_t index, std::unique_lock<std::mutex>& lock) {
+        Entry& entry = cache_[index];
+        entry.data.resize(tileStride_);
+        lru_.push_front(index);
+        entry.position = lru_.begin();
+        evictLocked(lock);
+
+        lock.unlock();
+        const bool ok = readTile(index, entry.data.data());
+        lock.lock();
+
+        entry.ready = true;
+        entry.failed = !ok;
+        loaded_.notify_all();
+        return entry;
+    }
+
+    void prefetchLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            requested_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+            if (stopping_) return;
+
+            const size_t index = requests_.front();
+            requests_.pop_front();
+            if (cache_.count(index) != 0) continue;
+
+            ++prefetched_;
+            loadLocked(index, lock);
+        }
+    }
+
+public:
+    /**
+     * @brief Создать файл подкачки и хранилище.
+     * @param path Путь к файлу (перезаписывается и удаляется в деструкторе).
+     * @param tileCount Количество плиток.
+     * @param tileStride Размер плитки в элементах.
+     * @param budget Объем кэша в байтах (не меньше одной плитки).
+     * @throw std::invalid_argument Если размер плитки равен нулю.
+     * @throw std::runtime_error Если файл не удается создать.
+     */
+    TileStore(const std::string& path, size_t tileCount, size_t tileStride, size_t budget = TILE_STORE_DEFAULT_BUDGET)
+        : path_(path), fd_(-1), tileCount_(tileCount), tileStride_(tileStride) {
+        if (tileStride == 0) throw std::invalid_argument("Tile size must be positive");
+
+        capacity_ = std::max<size_t>(1, budget / (tileStride * sizeof(T)));
+
+        fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd_ < 0 || ftruncate(fd_, offset(tileCount)) != 0) {
+            if (fd_ >= 0) close(fd_);
+            throw std::runtime_error("Cannot create tile file: " + path);
+        }
+
+        worker_ = std::thread([this] { prefetchLoop(); });
+    }
+
+    TileStore(const TileStore&) = delete;
+    TileStore& operator=(const TileStore&) = delete;
+
+    ~TileStore() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        requested_.notify_all();
+        worker_.join();
+
+        close(fd_);
+        std::remove(path_.c_str());
+    }
+
+    /**
+     * @brief Закрепить плитку в памяти (загрузив ее при необходимости).
+     * @param index Номер плитки.
+     * @return Указатель на tileStride() элементов, действительный до unpin().
+     * @throw std::out_of_range Если номер выходит за пределы.
+     * @throw std::runtime_error Если плитку не удалось прочитать; следующий вызов читает ее заново.
+     */
+    T* pin(size_t index) {
+        if (index >= tileCount_) throw std::out_of_range("Tile index out of range");
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = cache_.find(index);
+        if (it != cache_.end() && it->second.ready && it->second.failed && it->second.pins == 0) {
+            eraseLocked(index);
+            it = cache_.end();
+        }
+
+        Entry* entry = nullptr;
+        if (it == cache_.end()) {
+            ++misses_;
+            entry = &loadLocked(index, lock);
+        } else {
+            ++hits_;
+            entry = &it->second;
+        }
+
+        ++entry->pins;
+        loaded_.wait(lock, [entry] { return entry->ready; });
+
+        if (entry->failed) {
+            if (--entry->pins == 0) eraseLocked(index);
+            throw std::runtime_error("Cannot read tile from file: " + path_);
+        }
+
+        lru_.splice(lru_.begin(), lru_, entry->position);
+        return entry->data.data();
+    }
+
+    /**
+     * @brief Снять закрепление плитки.
+     * @param index Номер плитки.
+     * @param modified Плитка изменялась и должна быть записана при вытеснении.
+     */
+    void unpin(size_t index, bool modified) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Entry& entry = cache_.at(index);
+        --entry.pins;
+        entry.dirty = entry.dirty || modified;
+        evictLocked(lock);
+    }
+
+    /**
+     * @brief Запросить фоновую загрузку плиток, которые понадобятся следующими.
+     *
+     * Очередь запросов ограничена бюджетом кэша: старые запросы отбрасываются.
+     *
+     * @param indices Номера плиток.
+     */
+    void prefetch(const std::vector<size_t>& indices) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t index : indices) {
+                if (index >= tileCount_ || cache_.count(index) != 0) continue;
+
+                requests_.push_back(index);
+                if (requests_.size() > capacity_) requests_.pop_front();
+            }
+        }
+        requested_.notify_one();
+    }
+
+    /**
+     * @brief Записать в файл все измененные плитки кэша.
+     * @throw std::runtime_error Если запись не удалась.
+     */
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& item : cache_) {
+            Entry& entry = item.second;
+            if (!entry.ready || !entry.dirty || entry.failed) continue;
+
+            if (!writeTile(item.first, entry.data.data()))
+                throw std::runtime_error("Cannot write tile to file: " + path_);
+            entry.dirty = false;
+        }
+    }
+
+    /**
+     * @brief Закрепление плитки на время жизни объекта.
+     */
+    class Pin {
+    private:
+        TileStore& store_;
+        size_t index_;
+        bool writable_;
+        T* data_;
+
+    public:
+        /**
+         * @brief Закрепить плитку.
+         * @param store Хранилище.
+         * @param index Номер плитки.
+         * @param writable Плитка будет изменяться.
+         */
+        Pin(TileStore& store, size_t index, bool writable)
+            : store_(store), index_(index), writable_(writable), data_(store.pin(index)) {}
+
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+        ~Pin() { store_.unpin(index_, writable_); }
+
+        /**
+         * @brief Данные плитки.
+         * @return Указатель на элементы.
+         */
+        T* data() const noexcept { return data_; }
+    };
+
+    /**
+     * @brief Путь к файлу подкачки.
+     * @return Путь.
+     */
+    const std::string& getPath() const noexcept { return path_; }
+
+    /**
+     * @brief Количество плиток.
+     * @return Количество плиток.
+     */
+    size_t getTileCount() const noexcept { return tileCount_; }
+
+    /**
+     * @brief Размер плитки в элементах.
+     * @return Размер плитки.
+     */
+    size_t getTileStride() const noexcept { return tileStride_; }
+
+    /**
+     * @brief Наибольшее количество незакрепленных плиток в памяти.
+     * @return Бюджет в плитках.
+     */
+    size_t getCapacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Количество обращений к плиткам, уже находившимся в кэше.
+     * @return Количество попаданий.
+     */
+    size_t getHitCount() const noexcept { return hits_; }
+
+    /**
+     * @brief Количество обращений, потребовавших чтения из файла.
+     * @return Количество промахов.
+     */
+    size_t getMissCount() const noexcept { return misses_; }
+
+    /**
+     * @brief Количество вытесненных плиток.
+     * @return Количество вытеснений.
+     */
+    size_t getEvictionCount() const noexcept { return evictions_; }
+
+    /**
+     * @brief Количество плиток, загруженных фоновым потоком.
+     * @return Количество предзагрузок.
+     */
+    size_t getPrefetchCount() const noexcept { return prefetched_; }
+};
+
+} // namespace matrix_lib
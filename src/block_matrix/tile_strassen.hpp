@@ -0,0 +1,247 @@
+/**
+ * @file tile_strassen.hpp
+ * @brief Алгоритм Штрассена — Винограда над сеткой плиток: 7 умножений подсеток вместо 8 на уровень.
+ *
+ * Сетка side x side плиток хранится рекурсивно по квадрантам: четыре квадранта (11, 12, 21, 22)
+ * лежат подряд, каждый устроен так же, пока сторона не станет равной leaf; сетка leaf x leaf
+ * хранится по строкам плиток. Каждая плитка хранится по строкам без промежутков. Поэтому
+ * квадрант — непрерывный участок памяти, а сложение квадрантов — один проход по массиву.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "tile_kernel.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "../parallel/task_pool.hpp"
+
+#define STRASSEN_CROSSOVER_BLOCKS 4
+
+namespace matrix_lib {
+
+/**
+ * @brief Размеры сеток плиток для C = A * B.
+ */
+struct StrassenGrid {
+    size_t side;   ///< Сторона сеток в плитках (leaf * 2^levels).
+    size_t leaf;   ///< Сторона сетки, умножаемой обычным плиточным алгоритмом.
+    size_t rows;   ///< Строк в плитках A и C.
+    size_t depth;  ///< Столбцов в плитках A и строк в плитках B.
+    size_t cols;   ///< Столбцов в плитках B и C.
+
+    /**
+     * @brief Элементов в сетке плиток A стороны s.
+     */
+    size_t leftSize(size_t s) const noexcept { return s * s * rows * depth; }
+
+    /**
+     * @brief Элементов в сетке плиток B стороны s.
+     */
+    size_t rightSize(size_t s) const noexcept { return s * s * depth * cols; }
+
+    /**
+     * @brief Элементов в сетке плиток C стороны s.
+     */
+    size_t resultSize(size_t s) const noexcept { return s * s * rows * cols; }
+};
+
+/**
+ * @brief Номер плитки (i, j) в рекурсивном по квадрантам порядке.
+ * @param i Строка плитки.
+ * @param j Столбец плитки.
+ * @param side Сторона сетки.
+ * @param leaf Сторона листовой сетки.
+ * @return Номер плитки в массиве сетки.
+ */
+inline size_t strassenTileOffset(size_t i, size_t j, size_t side, size_t leaf) noexcept {
+    size_t offset = 0;
+    while (side > leaf) {
+        const size_t half = side / 2;
+        offset += ((i >= half ? 2 : 0) + (j >= half ? 1 : 0)) * half * half;
+        i %= half;
+        j %= half;
+        side = half;
+    }
+
+    return offset + i * leaf + j;
+}
+
+/**
+ * @brief Объем рабочей памяти для strassenMultiplyTiles() над сеткой стороны side.
+ *
+ * На каждом уровне нужны S1..S4 (квадранты A), T1..T4 (квадранты B) и два квадранта C;
+ * вызовы одного уровня выполняются по очереди и используют один и тот же участок.
+ *
+ * @param grid Размеры сеток.
+ * @param side Сторона сетки.
+ * @return Количество элементов.
+ */
+inline size_t strassenWorkspaceSize(const StrassenGrid& grid, size_t side) noexcept {
+    size_t size = 0;
+    for (; side > grid.leaf; side /= 2)
+        size += 4 * grid.leftSize(side / 2) + 4 * grid.rightSize(side / 2) + 2 * grid.resultSize(side / 2);
+
+    return size;
+}
+
+/**
+ * @brief dst = x + sign * y поэлементно.
+ */
+template <typename T>
+void combineTiles(T* dst, const T* x, const T* y, size_t count, T sign) noexcept {
+    for (size_t k = 0; k < count; ++k) dst[k] = x[k] + sign * y[k];
+}
+
+/**
+ * @brief C = A * B для листовых сеток обычным плиточным алгоритмом.
+ * @param packed Буфер упаковки плиток A.
+ */
+template <typename T>
+void multiplyLeafTiles(const T* a, const T* b, T* c, const StrassenGrid& grid, std::vector<T>& packed) {
+    const size_t tileA = grid.rows * grid.depth, tileB = grid.depth * grid.cols, tileC = grid.rows * grid.cols;
+    std::fill(c, c + grid.resultSize(grid.leaf), static_cast<T>(0));
+
+    for (size_t i = 0; i < grid.leaf; ++i)
+        for (size_t k = 0; k < grid.leaf; ++k) {
+            packTilePanel(a + (i * grid.leaf + k) * tileA, grid.rows, grid.depth, grid.depth, packed);
+            for (size_t j = 0; j < grid.leaf; ++j)
+                multiplyAddPackedTile(packed.data(), b + (k * grid.leaf + j) * tileB, c + (i * grid.leaf + j) * tileC,
+                                      grid.rows, grid.depth, grid.cols, grid.cols, grid.cols);
+        }
+}
+
+/**
+ * @brief Суммы Винограда S1..S4 и T1..T4 квадрантов A и B.
+ *
+ * S1 = A21 + A22, S2 = S1 - A11, S3 = A11 - A21, S4 = A12 - S2;
+ * T1 = B12 - B11, T2 = B22 - T1, T3 = B22 - B12, T4 = T2 - B21.
+ *
+ * @param s Четыре квадранта A подряд.
+ * @param t Четыре квадранта B подряд.
+ * @param sizeA Элементов в квадранте A.
+ * @param sizeB Элементов в квадранте B.
+ */
+template <typename T>
+void strassenOperandSums(const T* a, const T* b, T* s, T* t, size_t sizeA, size_t sizeB) noexcept {
+    const T plus = static_cast<T>(1), minus = static_cast<T>(-1);
+    const T *a11 = a, *a12 = a + sizeA, *a21 = a + 2 * sizeA, *a22 = a + 3 * sizeA;
+    const T *b11 = b, *b12 = b + sizeB, *b21 = b + 2 * sizeB, *b22 = b + 3 * sizeB;
+
+    combineTiles(s, a21, a22, sizeA, plus);
+    combineTiles(s + sizeA, s, a11, sizeA, minus);
+    combineTiles(s + 2 * sizeA, a11, a21, sizeA, minus);
+    combineTiles(s + 3 * sizeA, a12, s + sizeA, sizeA, minus);
+
+    combineTiles(t, b12, b11, sizeB, minus);
+    combineTiles(t + sizeB, b22, t, sizeB, minus);
+    combineTiles(t + 2 * sizeB, b22, b12, sizeB, minus);
+    combineTiles(t + 3 * sizeB, t + sizeB, b21, sizeB, minus);
+}
+
+/**
+ * @brief C = A * B по Штрассену — Винограду в вызывающем потоке.
+ *
+ * M1 = A11 B11, M2 = A12 B21, M3 = S4 B22, M4 = A22 T4, M5 = S1 T1, M6 = S2 T2, M7 = S3 T3;
+ * C11 = M1 + M2, C12 = M1 + M6 + M5 + M3, C21 = M1 + M6 + M7 - M4, C22 = M1 + M6 + M7 + M5.
+ * Произведения по очереди пишутся в два временных квадранта и в квадранты C.
+ *
+ * @param a Сетка A стороны side.
+ * @param b Сетка B стороны side.
+ * @param c Сетка C стороны side (перезаписывается).
+ * @param grid Размеры сеток.
+ * @param side Сторона сеток.
+ * @param workspace Не меньше strassenWorkspaceSize(grid, side) элементов.
+ * @param packed Буфер упаковки плиток A.
+ */
+template <typename T>
+void strassenMultiplyTiles(const T* a, const T* b, T* c, const StrassenGrid& grid, size_t side, T* workspace,
+                           std::vector<T>& packed) {
+    if (side <= grid.leaf) {
+        multiplyLeafTiles(a, b, c, grid, packed);
+        return;
+    }
+
+    const size_t half = side / 2;
+    const size_t sizeA = grid.leftSize(half), sizeB = grid.rightSize(half), sizeC = grid.resultSize(half);
+    T* s = workspace;
+    T* t = s + 4 * sizeA;
+    T* p = t + 4 * sizeB;
+    T* q = p + sizeC;
+    T* next = q + sizeC;
+    strassenOperandSums(a, b, s, t, sizeA, sizeB);
+
+    const T plus = static_cast<T>(1), minus = static_cast<T>(-1);
+    T *c11 = c, *c12 = c + sizeC, *c21 = c + 2 * sizeC, *c22 = c + 3 * sizeC;
+    auto multiply = [&](const T* x, const T* y, T* z) { strassenMultiplyTiles(x, y, z, grid, half, next, packed); };
+
+    multiply(a, b, p);                                 // M1
+    multiply(a + sizeA, b + 2 * sizeB, c11);           // M2
+    combineTiles(c11, c11, p, sizeC, plus);            // C11 = M1 + M2
+    multiply(s + sizeA, t + sizeB, q);                 // M6
+    combineTiles(p, p, q, sizeC, plus);                // U2 = M1 + M6
+    multiply(s + 2 * sizeA, t + 2 * sizeB, q);         // M7
+    combineTiles(c21, p, q, sizeC, plus);              // U3 = U2 + M7
+    multiply(s, t, q);                                 // M5
+    combineTiles(c22, c21, q, sizeC, plus);            // C22 = U3 + M5
+    combineTiles(p, p, q, sizeC, plus);                // U4 = U2 + M5
+    multiply(s + 3 * sizeA, b + 3 * sizeB, q);         // M3
+    combineTiles(c12, p, q, sizeC, plus);              // C12 = U4 + M3
+    multiply(a + 3 * sizeA, t + 3 * sizeB, q);         // M4
+    combineTiles(c21, c21, q, sizeC, minus);           // C21 = U3 - M4
+}
+
+/**
+ * @brief C = A * B по Штрассену — Винограду; семь произведений верхнего уровня выполняются
+ * параллельно в sharedTaskPool().
+ *
+ * Каждая задача получает свою рабочую память на всю глубину рекурсии и переиспользует ее
+ * на нижних уровнях. Сложения верхнего уровня распределяются между потоками parallelFor().
+ *
+ * @param a Сетка A стороны grid.side.
+ * @param b Сетка B стороны grid.side.
+ * @param c Сетка C стороны grid.side (перезаписывается).
+ * @param grid Размеры сеток.
+ */
+template <typename T>
+void strassenMultiplyTilesParallel(const T* a, const T* b, T* c, const StrassenGrid& grid) {
+    if (grid.side <= grid.leaf) {
+        std::vector<T> packed;
+        multiplyLeafTiles(a, b, c, grid, packed);
+        return;
+    }
+
+    const size_t half = grid.side / 2;
+    const size_t sizeA = grid.leftSize(half), sizeB = grid.rightSize(half), sizeC = grid.resultSize(half);
+    std::vector<T> s(4 * sizeA), t(4 * sizeB), m(7 * sizeC);
+    strassenOperandSums(a, b, s.data(), t.data(), sizeA, sizeB);
+
+    const T* left[7] = { a, a + sizeA, s.data() + 3 * sizeA, a + 3 * sizeA, s.data(), s.data() + sizeA, s.data() + 2 * sizeA };
+    const T* right[7] = { b, b + 2 * sizeB, b + 3 * sizeB, t.data() + 3 * sizeB, t.data(), t.data() + sizeB, t.data() + 2 * sizeB };
+
+    TaskPool& pool = sharedTaskPool();
+    TaskGroup group;
+    for (size_t k = 0; k < 7; ++k) {
+        pool.submit(group, [&, k] {
+            std::vector<T> workspace(strassenWorkspaceSize(grid, half)), packed;
+            strassenMultiplyTiles(left[k], right[k], m.data() + k * sizeC, grid, half, workspace.data(), packed);
+        });
+    }
+    pool.wait(group);
+
+    // M1..M7 лежат в m по порядку; U2 = M1 + M6, U3 = U2 + M7, U4 = U2 + M5.
+    const T* product[7];
+    for (size_t k = 0; k < 7; ++k) product[k] = m.data() + k * sizeC;
+
+    parallelFor(0, sizeC, [&](size_t e) {
+        const T u2 = product[0][e] + product[5][e];
+        const T u3 = u2 + product[6][e];
+        c[e] = product[0][e] + product[1][e];
+        c[sizeC + e] = u2 + product[4][e] + product[2][e];
+        c[2 * sizeC + e] = u3 - product[3][e];
+        c[3 * sizeC + e] = u3 + product[4][e];
+    }, PARALLEL_MIN_GRAIN * 64);
+}
+
+} // namespace matrix_lib
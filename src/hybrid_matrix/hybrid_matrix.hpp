@@ -0,0 +1,404 @@
+/**
+ * @file hybrid_matrix.hpp
+ * @brief Матрица, автоматически выбирающая плотное или разреженное представление по плотности.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <random>
+
+#include "../matrix/matrix.hpp"
+#include "../sparse_matrix/diagonal_matrix.hpp"
+#include "../sparse_matrix/sparse_matrix.hpp"
+
+#define HYBRID_CALIBRATION_SIZE 128
+
+#define HYBRID_CALIBRATION_DENSITY 0.05
+
+#define HYBRID_MIN_THRESHOLD 0.001
+
+#define HYBRID_MAX_THRESHOLD 0.5
+
+namespace matrix_lib {
+
+/**
+ * @brief Представление, в котором хранится гибридная матрица.
+ */
+enum class Representation { Dense, Sparse, Diagonal };
+
+/**
+ * @brief Вид операции, под которую выбирается представление.
+ */
+enum class HybridOperation { Multiply, Add };
+
+/**
+ * @brief Пороговые плотности, ниже которых разреженное представление выгоднее плотного.
+ */
+struct HybridThresholds {
+    double multiplyDensity;  ///< Порог для умножения на плотный блок.
+    double addDensity;       ///< Порог для поэлементного сложения.
+};
+
+/**
+ * @brief Матрица, хранящая данные в плотном (Matrix) или разреженном (SparseMatrix) виде.
+ *
+ * Представление выбирается по плотности ненулевых элементов и виду операции.
+ * Пороги для каждого типа элементов калибруются один раз при первом обращении:
+ * на небольшой тестовой матрице измеряется время плотных и разреженных ядер.
+ * Разреженная матрица с небольшим числом заполненных диагоналей (см. DiagonalMatrix::isSuitable())
+ * для умножения хранится в формате DIA.
+ *
+ * @tparam T Тип элементов матрицы.
+ */
+template <typename T>
+class HybridMatrix {
+private:
+    Representation representation_;  ///< Текущее представление.
+    Matrix<T> dense_;                 ///< Данные в плотном виде.
+    SparseMatrix<T> sparse_;          ///< Данные в разреженном виде.
+    DiagonalMatrix<T> diagonal_;      ///< Данные в формате DIA.
+    size_t nonZeros_;                 ///< Количество ненулевых элементов.
+
+    /**
+     * @brief Хранилище порогов для типа T (калибруется при первом обращении).
+     * @return Ссылка на пороги.
+     */
+    static HybridThresholds& thresholdStorage();
+
+    /**
+     * @brief Порог плотности для указанной операции.
+     * @param operation Вид операции.
+     * @return Пороговая плотность.
+     */
+    static double thresholdFor(HybridOperation operation);
+
+public:
+    /**
+     * @brief Конструктор из плотной матрицы.
+     * @param dense Исходная матрица.
+     * @param operation Операция, под которую выбирается представление.
+     */
+    explicit HybridMatrix(const Matrix<T>& dense, HybridOperation operation = HybridOperation::Multiply);
+
+    /**
+     * @brief Конструктор из разреженной матрицы.
+     * @param sparse Исходная матрица.
+     * @param operation Операция, под которую выбирается представление.
+     */
+    explicit HybridMatrix(const SparseMatrix<T>& sparse, HybridOperation operation = HybridOperation::Multiply);
+
+    /**
+     * @brief Текущие пороги выбора представления для типа T.
+     * @return Пороги (при первом вызове выполняется калибровка).
+     */
+    static HybridThresholds getThresholds();
+
+    /**
+     * @brief Заменить пороги выбора представления для типа T.
+     *
+     * Не потокобезопасно по отношению к одновременным операциям над HybridMatrix<T>.
+     *
+     * @param thresholds Новые пороги.
+     */
+    static void setThresholds(const HybridThresholds& thresholds);
+
+    /**
+     * @brief Измерить пороги выбора представления на текущей машине.
+     * @return Откалиброванные пороги.
+     */
+    static HybridThresholds calibrateThresholds();
+
+    /**
+     * @brief Возвращает количество строк.
+     * @return Количество строк.
+     */
+    size_t getRows() const noexcept;
+
+    /**
+     * @brief Возвращает количество столбцов.
+     * @return Количество столбцов.
+     */
+    size_t getCols() const noexcept;
+
+    /**
+     * @brief Возвращает текущее представление.
+     * @return Плотное, разреженное или диагональное.
+     */
+    Representation getRepresentation() const noexcept;
+
+    /**
+     * @brief Плотность ненулевых элементов.
+     * @return Отношение ненулевых элементов к общему количеству элементов.
+     */
+    double densityHybridMatrix() const noexcept;
+
+    /**
+     * @brief Получить значение по индексу.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return Значение в указанной позиции.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    T getValue(const size_t row, const size_t col) const;
+
+    /**
+     * @brief Перевыбрать представление под указанную операцию.
+     * @param operation Вид операции.
+     */
+    void optimizeFor(HybridOperation operation);
+
+    /**
+     * @brief Получить копию данных в плотном виде.
+     * @return Плотная матрица.
+     */
+    Matrix<T> toDenseMatrix() const;
+
+    /**
+     * @brief Получить копию данных в разреженном виде.
+     * @return Разреженная матрица.
+     */
+    SparseMatrix<T> toSparseMatrix() const;
+
+    /**
+     * @brief Умножение на плотную матрицу текущим ядром (SpMM или плотное умножение).
+     * @param other Плотная матрица.
+     * @return Плотная матрица-произведение.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    Matrix<T> operator*(const Matrix<T>& other) const;
+
+    /**
+     * @brief Умножение на вектор текущим ядром.
+     * @param vector Вектор длины getCols().
+     * @return Вектор-произведение.
+     * @throw std::invalid_argument Если размер вектора не совпадает с количеством столбцов.
+     */
+    std::vector<T> multiplyVectorHybridMatrix(const std::vector<T>& vector) const;
+
+    /**
+     * @brief Умножение гибридных матриц; ядро выбирается по представлениям операндов.
+     * @param other Правый операнд.
+     * @return Гибридная матрица-произведение.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    HybridMatrix operator*(const HybridMatrix& other) const;
+
+    /**
+     * @brief Сложение гибридных матриц.
+     *
+     * Разреженное сложение используется, если оценка плотности результата ниже порога сложения.
+     *
+     * @param other Правый операнд.
+     * @return Гибридная матрица-сумма.
+     * @throw std::invalid_argument Если размеры матриц не совпадают.
+     */
+    HybridMatrix operator+(const HybridMatrix& other) const;
+};
+
+template <typename T>
+HybridThresholds& HybridMatrix<T>::thresholdStorage() {
+    static HybridThresholds thresholds = calibrateThresholds();
+    return thresholds;
+}
+
+template <typename T>
+inline double HybridMatrix<T>::thresholdFor(HybridOperation operation) {
+    const HybridThresholds& thresholds = thresholdStorage();
+    return operation == HybridOperation::Multiply ? thresholds.multiplyDensity : thresholds.addDensity;
+}
+
+template <typename T>
+inline HybridThresholds HybridMatrix<T>::getThresholds() { return thresholdStorage(); }
+
+template <typename T>
+inline void HybridMatrix<T>::setThresholds(const HybridThresholds& thresholds) { thresholdStorage() = thresholds; }
+
+template <typename T>
+HybridThresholds HybridMatrix<T>::calibrateThresholds() {
+    const size_t n = HYBRID_CALIBRATION_SIZE;
+    std::mt19937 gen(n);
+    std::bernoulli_distribution pick(HYBRID_CALIBRATION_DENSITY);
+
+    Matrix<T> dense(n, n);
+    Matrix<T> block(n, SPMM_COLUMN_BLOCK);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j)
+            if (pick(gen)) dense(i, j) = static_cast<T>(1);
+
+        for (size_t j = 0; j < SPMM_COLUMN_BLOCK; ++j) block(i, j) = static_cast<T>(1);
+    }
+
+    const SparseMatrix<T> sparse(dense);
+
+    auto measure = [](auto&& op) {
+        double best = 0.0;
+        for (int rep = 0; rep < 3; ++rep) {
+            auto start = std::chrono::steady_clock::now();
+            op();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (rep == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        return std::max(best, 1e-9);
+    };
+
+    const double denseMul = measure([&] { return dense * block; });
+    const double sparseMul = measure([&] { return sparse * block; });
+    const double denseAdd = measure([&] { return dense + dense; });
+    const double sparseAdd = measure([&] { return sparse + sparse; });
+
+    auto clamp = [](double value) { return std::min(std::max(value, HYBRID_MIN_THRESHOLD), HYBRID_MAX_THRESHOLD); };
+
+    return { clamp(HYBRID_CALIBRATION_DENSITY * denseMul / sparseMul),
+             clamp(HYBRID_CALIBRATION_DENSITY * denseAdd / sparseAdd) };
+}
+
+template <typename T>
+HybridMatrix<T>::HybridMatrix(const Matrix<T>& dense, HybridOperation operation)
+    : representation_(Representation::Dense), dense_(dense), sparse_(dense.getRows(), dense.getCols()),
+      diagonal_(0, 0, {}), nonZeros_(0) {
+    for (size_t i = 0; i < dense_.getRows(); ++i) {
+        const T* row = dense_.getRowData(i);
+        for (size_t j = 0; j < dense_.getCols(); ++j)
+            if (row[j] != static_cast<T>(0)) ++nonZeros_;
+    }
+
+    optimizeFor(operation);
+}
+
+template <typename T>
+HybridMatrix<T>::HybridMatrix(const SparseMatrix<T>& sparse, HybridOperation operation)
+    : representation_(Representation::Sparse), dense_(0, 0), sparse_(sparse), diagonal_(0, 0, {}),
+      nonZeros_(sparse.getNonZeroCount()) {
+    optimizeFor(operation);
+}
+
+template <typename T>
+inline size_t HybridMatrix<T>::getRows() const noexcept { return sparse_.getRowsSparseMatrix(); }
+
+template <typename T>
+inline size_t HybridMatrix<T>::getCols() const noexcept { return sparse_.getColsSparseMatrix(); }
+
+template <typename T>
+inline Representation HybridMatrix<T>::getRepresentation() const noexcept { return representation_; }
+
+template <typename T>
+inline double HybridMatrix<T>::densityHybridMatrix() const noexcept {
+    const size_t total = getRows() * getCols();
+    return total == 0 ? 0.0 : static_cast<double>(nonZeros_) / total;
+}
+
+template <typename T>
+T HybridMatrix<T>::getValue(const size_t row, const size_t col) const {
+    if (representation_ == Representation::Dense) return dense_(row, col);
+
+    if (representation_ == Representation::Diagonal) return diagonal_.getValue(row, col);
+
+    return sparse_.getValue(row, col);
+}
+
+template <typename T>
+void HybridMatrix<T>::optimizeFor(HybridOperation operation) {
+    if (densityHybridMatrix() >= thresholdFor(operation)) {
+        if (representation_ == Representation::Dense) return;
+
+        dense_ = toDenseMatrix();
+        sparse_ = SparseMatrix<T>(dense_.getRows(), dense_.getCols());
+        diagonal_ = DiagonalMatrix<T>(0, 0, {});
+        representation_ = Representation::Dense;
+        return;
+    }
+
+    if (representation_ == Representation::Dense) {
+        sparse_ = SparseMatrix<T>(dense_);
+        dense_ = Matrix<T>(0, 0);
+    } else if (representation_ == Representation::Diagonal) {
+        if (operation == HybridOperation::Multiply) return;
+
+        sparse_ = diagonal_.toSparseMatrix();
+        diagonal_ = DiagonalMatrix<T>(0, 0, {});
+    }
+    representation_ = Representation::Sparse;
+
+    if (operation == HybridOperation::Multiply && DiagonalMatrix<T>::isSuitable(sparse_)) {
+        diagonal_ = DiagonalMatrix<T>(sparse_);
+        sparse_ = SparseMatrix<T>(diagonal_.getRows(), diagonal_.getCols());
+        representation_ = Representation::Diagonal;
+    }
+}
+
+template <typename T>
+Matrix<T> HybridMatrix<T>::toDenseMatrix() const {
+    if (representation_ == Representation::Diagonal) return diagonal_.toSparseMatrix().toDenseMatrix();
+
+    return representation_ == Representation::Dense ? dense_ : sparse_.toDenseMatrix();
+}
+
+template <typename T>
+SparseMatrix<T> HybridMatrix<T>::toSparseMatrix() const {
+    if (representation_ == Representation::Diagonal) return diagonal_.toSparseMatrix();
+
+    return representation_ == Representation::Sparse ? sparse_ : SparseMatrix<T>(dense_);
+}
+
+template <typename T>
+Matrix<T> HybridMatrix<T>::operator*(const Matrix<T>& other) const {
+    if (representation_ == Representation::Sparse) return sparse_ * other;
+
+    if (representation_ == Representation::Diagonal) return diagonal_ * other;
+
+    return dense_ * other;
+}
+
+template <typename T>
+std::vector<T> HybridMatrix<T>::multiplyVectorHybridMatrix(const std::vector<T>& vector) const {
+    if (representation_ == Representation::Sparse) return sparse_.multiplyVectorSparseMatrix(vector);
+
+    if (representation_ == Representation::Diagonal) return diagonal_.multiplyVectorDiagonalMatrix(vector);
+
+    if (vector.size() != getCols())
+        throw std::invalid_argument("Vector size must match the number of columns");
+
+    std::vector<T> result(getRows(), static_cast<T>(0));
+    parallelFor(0, getRows(), [&](size_t i) {
+        const T* row = dense_.getRowData(i);
+        T sum = static_cast<T>(0);
+        for (size_t j = 0; j < getCols(); ++j) sum += row[j] * vector[j];
+        result[i] = sum;
+    });
+
+    return result;
+}
+
+template <typename T>
+HybridMatrix<T> HybridMatrix<T>::operator*(const HybridMatrix& other) const {
+    if (getCols() != other.getRows())
+        throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
+
+    if (representation_ == Representation::Sparse && other.representation_ == Representation::Sparse)
+        return HybridMatrix(sparse_ * other.sparse_);
+
+    if (representation_ == Representation::Dense && other.representation_ == Representation::Dense)
+        return HybridMatrix(dense_ * other.dense_);
+
+    if (other.representation_ == Representation::Dense) return HybridMatrix(*this * other.dense_);
+
+    if (representation_ == Representation::Dense) return HybridMatrix(dense_ * other.toSparseMatrix());
+
+    return HybridMatrix(toSparseMatrix() * other.toSparseMatrix());
+}
+
+template <typename T>
+HybridMatrix<T> HybridMatrix<T>::operator+(const HybridMatrix& other) const {
+    if (getRows() != other.getRows() || getCols() != other.getCols())
+        throw std::invalid_argument("Matrices have different dimensions");
+
+    const double estimate = densityHybridMatrix() + other.densityHybridMatrix();
+
+    if (estimate < thresholdFor(HybridOperation::Add))
+        return HybridMatrix(toSparseMatrix() + other.toSparseMatrix(), HybridOperation::Add);
+
+    return HybridMatrix(toDenseMatrix() + other.toDenseMatrix(), HybridOperation::Add);
+}
+
+} // namespace matrix_lib
@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <random>
 
+#include "matrix_view.hpp"
+
 #define MIN_SIZE_MATRIX 2
 
 namespace matrix_lib {
@@ -28,7 +30,8 @@ class Matrix {
 private:
     size_t rows_;  /**< Количество строк в матрице. */
     size_t cols_;  /**< Количество столбцов в матрице. */
-    std::unique_ptr<std::unique_ptr<T[]>[]> data_;  /**< Двумерный массив для хранения данных матрицы. */
+    std::unique_ptr<T[]> buffer_;   /**< Элементы матрицы по строкам одним непрерывным блоком. */
+    std::unique_ptr<T*[]> data_;    /**< Указатели на начала строк внутри buffer_. */
 
     /**
      * @brief Инициализация памяти под матрицу.
@@ -59,6 +62,40 @@ public:
      */
     size_t getCols() const noexcept;
 
+    /**
+     * @brief Возвращает указатель на начало строки матрицы без проверки границ.
+     *
+     * Предназначен для вычислительных ядер, которым нужен прямой доступ к данным строки.
+     *
+     * @param row Индекс строки.
+     * @return Указатель на первый элемент строки.
+     */
+    T* getRowData(const size_t row) noexcept;
+
+    /**
+     * @brief Возвращает указатель на начало строки константной матрицы без проверки границ.
+     * @param row Индекс строки.
+     * @return Константный указатель на первый элемент строки.
+     */
+    const T* getRowData(const size_t row) const noexcept;
+
+    /**
+     * @brief Представление всей матрицы без копирования.
+     *
+     * Элементы хранятся по строкам непрерывно, поэтому представление имеет шаг getCols();
+     * плитки матрицы получаются через MatrixView::tile(). Представление действительно,
+     * пока матрица жива и не переприсвоена.
+     *
+     * @return Изменяемое представление.
+     */
+    MatrixView<T> view() noexcept;
+
+    /**
+     * @brief Представление константной матрицы без копирования.
+     * @return Представление только для чтения.
+     */
+    MatrixView<const T> view() const noexcept;
+
     /**
      * @brief Конструктор по умолчанию.
      */
@@ -92,6 +129,12 @@ public:
      */
     Matrix(const Matrix& other) noexcept;
 
+    /**
+     * @brief Конструктор копирования области другого буфера.
+     * @param view Представление области.
+     */
+    explicit Matrix(const MatrixView<const T>& view) noexcept;
+
     /**
      * @brief Конструктор перемещения.
      * @param other Другая матрица для перемещения.
@@ -726,16 +769,15 @@ public:
 
 template<typename T>
 void Matrix<T>::initMatrix() noexcept {
-    data_ = std::make_unique<std::unique_ptr<T[]>[]>(rows_);
-    for (size_t i = 0; i < rows_; ++i) {
-        data_[i] = std::make_unique<T[]>(cols_);
-        std::fill(data_[i].get(), data_[i].get() + cols_, static_cast<T>(0)); 
-    }
+    buffer_ = std::make_unique<T[]>(rows_ * cols_);
+    data_ = std::make_unique<T*[]>(rows_);
+    for (size_t i = 0; i < rows_; ++i) data_[i] = buffer_.get() + i * cols_;
 }
 
 template<typename T>
 inline void Matrix<T>::freeMemoryMatrix() noexcept {
     data_.reset();
+    buffer_.reset();
     rows_ = 0;
     cols_ = 0;
 }
@@ -747,8 +789,7 @@ void Matrix<T>::copyMatrix(const Matrix<T>& other) noexcept {
 
     initMatrix();
 
-    for (size_t i = 0; i < rows_; ++i) 
-        std::copy(other.data_[i].get(), other.data_[i].get() + cols_, data_[i].get());
+    std::copy(other.buffer_.get(), other.buffer_.get() + rows_ * cols_, buffer_.get());
 }
 
 template <typename T>
@@ -757,6 +798,18 @@ inline size_t Matrix<T>::getRows() const noexcept { return rows_; }
 template <typename T>
 inline size_t Matrix<T>::getCols() const noexcept { return cols_; }
 
+template <typename T>
+inline T* Matrix<T>::getRowData(const size_t row) noexcept { return data_[row]; }
+
+template <typename T>
+inline const T* Matrix<T>::getRowData(const size_t row) const noexcept { return data_[row]; }
+
+template <typename T>
+inline MatrixView<T> Matrix<T>::view() noexcept { return MatrixView<T>(buffer_.get(), rows_, cols_, cols_); }
+
+template <typename T>
+inline MatrixView<const T> Matrix<T>::view() const noexcept { return MatrixView<const T>(buffer_.get(), rows_, cols_, cols_); }
+
 template<typename T>
 inline Matrix<T>::Matrix() noexcept : rows_(MIN_SIZE_MATRIX), cols_(MIN_SIZE_MATRIX) {
     initMatrix();
@@ -777,7 +830,7 @@ template<const size_t N, const size_t M>
 inline Matrix<T>::Matrix(T (&array)[N][M]) noexcept : rows_(N), cols_(M) {
     initMatrix();
     for (size_t i = 0; i < N; ++i) 
-        std::copy(array[i], array[i] + M, data_[i].get());
+        std::copy(array[i], array[i] + M, data_[i]);
 }
 
 template<typename T>
@@ -786,7 +839,15 @@ inline Matrix<T>::Matrix(const Matrix<T>& other) noexcept {
 }
 
 template<typename T>
-inline Matrix<T>::Matrix(Matrix<T>&& other) noexcept : rows_(other.rows_), cols_(other.cols_), data_(std::move(other.data_)) {
+Matrix<T>::Matrix(const MatrixView<const T>& view) noexcept : rows_(view.getRows()), cols_(view.getCols()) {
+    initMatrix();
+    for (size_t i = 0; i < rows_; ++i)
+        std::copy(view.getRowData(i), view.getRowData(i) + cols_, data_[i]);
+}
+
+template<typename T>
+inline Matrix<T>::Matrix(Matrix<T>&& other) noexcept
+    : rows_(other.rows_), cols_(other.cols_), buffer_(std::move(other.buffer_)), data_(std::move(other.data_)) {
     other.rows_ = 0;
     other.cols_ = 0;
 }
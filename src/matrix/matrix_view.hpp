@@ -0,0 +1,132 @@
+/**
+ * @file matrix_view.hpp
+ * @brief Невладеющее представление прямоугольной области матрицы с шагом строк.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace matrix_lib {
+
+/**
+ * @class MatrixView
+ * @brief Окно rows x cols в чужом буфере, хранящемся по строкам с шагом stride.
+ *
+ * Представление не владеет памятью и не копирует ее: элемент (r, c) — это data[r * stride + c].
+ * Используется для плиток плоской матрицы (subView(), tile()) и для плиток арены BlockMatrix;
+ * указатель на данные и шаг можно передавать прямо в ядра над плитками.
+ *
+ * @tparam T Тип элементов (const T — представление только для чтения).
+ */
+template<typename T>
+class MatrixView {
+    static_assert(std::is_arithmetic<std::remove_const_t<T>>::value, "MatrixView can only view arithmetic types (numbers).");
+
+private:
+    T* data_;        /**< Первый элемент окна. */
+    size_t rows_;    /**< Количество строк окна. */
+    size_t cols_;    /**< Количество столбцов окна. */
+    size_t stride_;  /**< Шаг строк в элементах. */
+
+public:
+    /**
+     * @brief Создать представление.
+     * @param data Первый элемент окна.
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param stride Шаг строк (не меньше cols).
+     * @throw std::invalid_argument Если шаг меньше количества столбцов.
+     */
+    MatrixView(T* data, size_t rows, size_t cols, size_t stride) : data_(data), rows_(rows), cols_(cols), stride_(stride) {
+        if (stride < cols) throw std::invalid_argument("View stride must not be less than its width");
+    }
+
+    /**
+     * @brief Преобразование изменяемого представления в представление только для чтения.
+     * @param other Изменяемое представление.
+     */
+    template<typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+    MatrixView(const MatrixView<U>& other) noexcept
+        : data_(other.getRowData(0)), rows_(other.getRows()), cols_(other.getCols()), stride_(other.getStride()) {}
+
+    /**
+     * @brief Количество строк.
+     * @return Количество строк.
+     */
+    size_t getRows() const noexcept { return rows_; }
+
+    /**
+     * @brief Количество столбцов.
+     * @return Количество столбцов.
+     */
+    size_t getCols() const noexcept { return cols_; }
+
+    /**
+     * @brief Шаг строк в элементах.
+     * @return Шаг строк.
+     */
+    size_t getStride() const noexcept { return stride_; }
+
+    /**
+     * @brief Указатель на начало строки без проверки границ.
+     * @param row Индекс строки.
+     * @return Указатель на первый элемент строки.
+     */
+    T* getRowData(const size_t row) const noexcept { return data_ + row * stride_; }
+
+    /**
+     * @brief Доступ к элементу.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return Ссылка на элемент в исходном буфере.
+     * @throw std::out_of_range Если индексы выходят за пределы окна.
+     */
+    T& operator()(const size_t row, const size_t col) const {
+        if (row >= rows_ || col >= cols_)
+            throw std::out_of_range("Matrix index out of range");
+
+        return data_[row * stride_ + col];
+    }
+
+    /**
+     * @brief Окно внутри текущего окна.
+     * @param row Первая строка.
+     * @param col Первый столбец.
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @return Представление с тем же шагом.
+     * @throw std::out_of_range Если окно выходит за пределы текущего.
+     */
+    MatrixView subView(size_t row, size_t col, size_t rows, size_t cols) const {
+        if (row > rows_ || col > cols_ || rows > rows_ - row || cols > cols_ - col)
+            throw std::out_of_range("Matrix index out of range");
+
+        return MatrixView(data_ + row * stride_ + col, rows, cols, stride_);
+    }
+
+    /**
+     * @brief Плитка (blockRow, blockCol) разбиения на блоки blockRows x blockCols.
+     *
+     * Плитки на правом и нижнем краях усечены до размеров окна.
+     *
+     * @param blockRow Индекс строки плитки.
+     * @param blockCol Индекс столбца плитки.
+     * @param blockRows Количество строк в блоке.
+     * @param blockCols Количество столбцов в блоке.
+     * @return Представление плитки.
+     * @throw std::out_of_range Если плитка выходит за пределы окна.
+     */
+    MatrixView tile(size_t blockRow, size_t blockCol, size_t blockRows, size_t blockCols) const {
+        const size_t row = blockRow * blockRows;
+        const size_t col = blockCol * blockCols;
+        if (row >= rows_ || col >= cols_)
+            throw std::out_of_range("Block index out of range");
+
+        return subView(row, col, std::min(blockRows, rows_ - row), std::min(blockCols, cols_ - col));
+    }
+};
+
+} // namespace matrix_lib
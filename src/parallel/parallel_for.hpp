@@ -0,0 +1,86 @@
+/**
+ * @file parallel_for.hpp
+ * @brief Простейший параллельный цикл по диапазону индексов на основе std::thread.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#define PARALLEL_MIN_GRAIN 64
+
+namespace matrix_lib {
+
+/**
+ * @brief Возвращает число потоков, доступных для параллельных ядер.
+ * @return Количество аппаратных потоков (не меньше 1).
+ */
+inline size_t hardwareThreads() noexcept {
+    size_t count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+/**
+ * @brief Количество непрерывных порций для разбиения работы между потоками.
+ * @param work Количество итераций.
+ * @param grain Минимальное количество итераций на одну порцию.
+ * @return Количество порций (не меньше 1).
+ */
+inline size_t parallelChunks(size_t work, size_t grain = PARALLEL_MIN_GRAIN) noexcept {
+    return std::max<size_t>(1, std::min(hardwareThreads(), work / std::max<size_t>(grain, 1)));
+}
+
+/**
+ * @brief Выполняет тело цикла для каждого индекса из [begin, end) параллельно.
+ *
+ * Диапазон делится на непрерывные куски, каждый кусок обрабатывается отдельным потоком.
+ * Если итераций меньше двух порций `grain`, цикл выполняется в вызывающем потоке.
+ * Исключение, брошенное телом цикла, пробрасывается вызывающему после завершения всех потоков.
+ *
+ * @tparam Body Тип вызываемого объекта с сигнатурой `void(size_t)`.
+ * @param begin Первый индекс.
+ * @param end Индекс за последним.
+ * @param body Тело цикла.
+ * @param grain Минимальное количество итераций на один поток.
+ */
+template <typename Body>
+void parallelFor(size_t begin, size_t end, Body&& body, size_t grain = PARALLEL_MIN_GRAIN) {
+    if (end <= begin) return;
+
+    size_t total = end - begin;
+    size_t threads = std::min(hardwareThreads(), total / std::max<size_t>(grain, 1));
+
+    if (threads <= 1) {
+        for (size_t i = begin; i < end; ++i) body(i);
+        return;
+    }
+
+    size_t chunk = (total + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(threads);
+    workers.reserve(threads - 1);
+
+    auto runChunk = [&](size_t t) {
+        size_t from = begin + t * chunk;
+        size_t to = std::min(end, from + chunk);
+
+        try {
+            for (size_t i = from; i < to; ++i) body(i);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    for (size_t t = 1; t < threads; ++t) workers.emplace_back(runChunk, t);
+    runChunk(0);
+
+    for (auto& worker : workers) worker.join();
+
+    for (auto& error : errors)
+        if (error) std::rethrow_exception(error);
+}
+
+} // namespace matrix_lib
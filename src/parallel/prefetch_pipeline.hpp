@@ -0,0 +1,158 @@
+/**
+ * @file prefetch_pipeline.hpp
+ * @brief Конвейер с фоновой загрузкой: загрузка элемента k + 1 перекрывается со счетом над элементом k.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define PIPELINE_IO_THREADS 2
+
+#define PIPELINE_DEPTH 2
+
+namespace matrix_lib {
+
+/**
+ * @brief Замеры одного прогона конвейера.
+ */
+struct PipelineStats {
+    size_t items = 0;             ///< Количество обработанных элементов.
+    double loadSeconds = 0.0;     ///< Суммарное время загрузки (по всем потокам ввода-вывода).
+    double computeSeconds = 0.0;  ///< Суммарное время счета.
+    double stallSeconds = 0.0;    ///< Время, которое счет ждал загрузки.
+
+    /**
+     * @brief Доля времени загрузки, скрытая за счетом.
+     * @return 1 — загрузка полностью перекрыта, 0 — счет каждый раз ждал всю загрузку.
+     */
+    double getOverlapRatio() const noexcept {
+        if (loadSeconds <= 0.0) return 1.0;
+        return std::min(1.0, std::max(0.0, 1.0 - stallSeconds / loadSeconds));
+    }
+};
+
+/**
+ * @brief Обработать элементы 0..count-1, загружая их заранее в фоновых потоках.
+ *
+ * Потоки ввода-вывода вызывают load(k) и кладут результат в кольцевой буфер из depth
+ * ячеек; пока счет занят элементом k, загружаются следующие (при depth = 2 — двойная
+ * буферизация). Загрузчик не обгоняет счет больше чем на depth элементов, поэтому
+ * в буфере не больше depth загруженных элементов. compute(k, item) вызывается в
+ * вызывающем потоке строго по порядку k. Первое исключение загрузки или счета останавливает
+ * конвейер и пробрасывается вызывающему.
+ *
+ * @tparam Load Тип вызываемого объекта `Item(size_t k)` (Item конструируется по умолчанию);
+ *              вызывается из нескольких потоков.
+ * @tparam Compute Тип вызываемого объекта `void(size_t k, Item& item)`.
+ * @param count Количество элементов.
+ * @param load Загрузка (чтение, распаковка, преобразование типа).
+ * @param compute Счет над загруженным элементом.
+ * @param ioThreads Количество потоков загрузки.
+ * @param depth Количество буферов.
+ * @return Замеры прогона.
+ */
+template <typename Load, typename Compute>
+PipelineStats runPrefetchPipeline(size_t count, Load&& load, Compute&& compute,
+                                  size_t ioThreads = PIPELINE_IO_THREADS, size_t depth = PIPELINE_DEPTH) {
+    using Item = std::decay_t<decltype(load(size_t{}))>;
+    using Clock = std::chrono::steady_clock;
+
+    ioThreads = std::max<size_t>(1, std::min(ioThreads, count));
+    depth = std::max<size_t>(1, depth);
+
+    std::vector<Item> slots(depth);
+    std::vector<size_t> ready(depth, count);   ///< Номер элемента в ячейке (count — ячейка пуста).
+    std::mutex mutex;
+    std::condition_variable loaded, consumed;
+    size_t nextLoad = 0;
+    size_t nextCompute = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+    PipelineStats stats;
+
+    auto loader = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            consumed.wait(lock, [&] { return stopping || nextLoad == count || nextLoad < nextCompute + depth; });
+            if (stopping || nextLoad == count) return;
+
+            const size_t k = nextLoad++;
+            lock.unlock();
+
+            const auto start = Clock::now();
+            Item item;
+            std::exception_ptr failure;
+            try {
+                item = load(k);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            lock.lock();
+            stats.loadSeconds += seconds;
+            if (failure) {
+                if (!error) error = failure;
+                stopping = true;
+            } else {
+                slots[k % depth] = std::move(item);
+                ready[k % depth] = k;
+            }
+            loaded.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < ioThreads; ++t) threads.emplace_back(loader);
+
+    for (size_t k = 0; k < count; ++k) {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            const auto start = Clock::now();
+            loaded.wait(lock, [&] { return stopping || ready[k % depth] == k; });
+            stats.stallSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+            if (stopping) break;
+
+            item = std::move(slots[k % depth]);
+            ready[k % depth] = count;
+            nextCompute = k + 1;
+        }
+        consumed.notify_all();
+
+        const auto start = Clock::now();
+        try {
+            compute(k, item);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+            stopping = true;
+        }
+        stats.computeSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) break;
+        ++stats.items;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    consumed.notify_all();
+    for (std::thread& thread : threads) thread.join();
+
+    if (error) std::rethrow_exception(error);
+    return stats;
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,131 @@
+/**
+ * @file task_graph.hpp
+ * @brief Граф задач с зависимостями по данным и динамическим планированием на TaskPool.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "task_pool.hpp"
+
+namespace matrix_lib {
+
+/**
+ * @brief Ациклический граф задач, построенный по порядку постановки и наборам данных.
+ *
+ * Каждая задача объявляет, какие объекты (например, номера плиток) она читает и пишет.
+ * Зависимости выводятся как при последовательном выполнении в порядке addTask():
+ * чтение после записи, запись после чтения и запись после записи. При выполнении задача
+ * ставится в пул, как только завершены все ее предшественники, поэтому независимые ветви
+ * (например, разные шаги факторизации) перекрываются.
+ */
+class TaskGraph {
+private:
+    struct Node {
+        std::function<void()> body;
+        std::vector<size_t> successors;
+        size_t dependencies = 0;
+        std::atomic<size_t> remaining{ 0 };
+    };
+
+    struct Access {
+        size_t writer = static_cast<size_t>(-1);  ///< Последняя задача, писавшая объект.
+        std::vector<size_t> readers;              ///< Задачи, читавшие объект после нее.
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::unordered_map<size_t, Access> accesses_;
+
+    void addEdge(size_t from, size_t to) {
+        if (from == to) return;
+
+        std::vector<size_t>& successors = nodes_[from]->successors;
+        if (!successors.empty() && successors.back() == to) return;
+
+        successors.push_back(to);
+        ++nodes_[to]->dependencies;
+    }
+
+    void release(TaskPool& pool, TaskGroup& group, size_t index) {
+        pool.submit(group, [this, &pool, &group, index] {
+            nodes_[index]->body();
+
+            for (size_t next : nodes_[index]->successors)
+                if (--nodes_[next]->remaining == 0) release(pool, group, next);
+        });
+    }
+
+public:
+    /**
+     * @brief Добавить задачу.
+     * @param body Тело задачи.
+     * @param reads Объекты, которые задача читает.
+     * @param writes Объекты, которые задача изменяет.
+     * @return Номер задачи.
+     */
+    size_t addTask(std::function<void()> body, const std::vector<size_t>& reads, const std::vector<size_t>& writes) {
+        const size_t index = nodes_.size();
+        nodes_.push_back(std::make_unique<Node>());
+        nodes_.back()->body = std::move(body);
+
+        for (size_t object : reads) {
+            Access& access = accesses_[object];
+            if (access.writer != static_cast<size_t>(-1)) addEdge(access.writer, index);
+            access.readers.push_back(index);
+        }
+
+        for (size_t object : writes) {
+            Access& access = accesses_[object];
+            if (access.writer != static_cast<size_t>(-1)) addEdge(access.writer, index);
+            for (size_t reader : access.readers) addEdge(reader, index);
+
+            access.writer = index;
+            access.readers.clear();
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief Количество задач.
+     * @return Количество задач.
+     */
+    size_t getTaskCount() const noexcept { return nodes_.size(); }
+
+    /**
+     * @brief Количество ребер зависимостей.
+     * @return Количество ребер.
+     */
+    size_t getEdgeCount() const noexcept {
+        size_t edges = 0;
+        for (const auto& node : nodes_) edges += node->dependencies;
+        return edges;
+    }
+
+    /**
+     * @brief Выполнить граф и дождаться завершения.
+     *
+     * Если задача бросает исключение, зависящие от нее задачи не запускаются; первое
+     * исключение пробрасывается вызывающему после завершения остальных задач.
+     *
+     * Граф ждет только свои задачи, поэтому пул может одновременно выполнять чужую работу.
+     *
+     * @param pool Пул потоков (вызов не должен выполняться из задачи этого пула).
+     */
+    void run(TaskPool& pool = sharedTaskPool()) {
+        for (auto& node : nodes_) node->remaining = node->dependencies;
+
+        TaskGroup group;
+        for (size_t index = 0; index < nodes_.size(); ++index)
+            if (nodes_[index]->dependencies == 0) release(pool, group, index);
+
+        pool.wait(group);
+    }
+};
+
+} // namespace matrix_lib
@@ -0,0 +1,238 @@
+/**
+ * @file task_pool.hpp
+ * @brief Пул потоков с локальными очередями задач и перехватом работы (work stealing).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "parallel_for.hpp"
+
+namespace matrix_lib {
+
+class TaskPool;
+
+/**
+ * @brief Группа задач пула со своим счетчиком и своим первым исключением.
+ *
+ * TaskPool::wait(group) ждет только задачи этой группы и пробрасывает только их исключение,
+ * поэтому несколько потоков могут одновременно пользоваться одним пулом, не дожидаясь чужих
+ * задач и не получая чужих ошибок. Группа должна жить, пока ее задачи не завершены.
+ */
+class TaskGroup {
+private:
+    friend class TaskPool;
+
+    std::mutex mutex_;
+    std::condition_variable idle_;   ///< Сигнал о завершении всех задач группы.
+    size_t pending_ = 0;             ///< Поставленные, но не завершенные задачи группы.
+    std::exception_ptr error_;
+
+    void add() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++pending_;
+    }
+
+    /**
+     * Уведомление под блокировкой: ожидающий поток не вернется из wait() (и не разрушит
+     * группу), пока завершающий поток не отпустит мьютекс.
+     */
+    void finish(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error && !error_) error_ = error;
+        if (--pending_ == 0) idle_.notify_all();
+    }
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+};
+
+/**
+ * @brief Пул потоков с перехватом работы.
+ *
+ * У каждого рабочего потока своя очередь: владелец берет задачи с конца (последние
+ * поставленные, «горячие» в кэше), простаивающий поток забирает задачи с начала чужой очереди.
+ * Задачи, поставленные из рабочего потока, попадают в его очередь, внешние задачи
+ * распределяются по очередям по кругу. Задача может ставить новые задачи, но не должна
+ * вызывать wait(). Библиотечные ядра ставят задачи в собственную TaskGroup и ждут только ее.
+ */
+class TaskPool {
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers_;
+    std::vector<Queue> queues_;
+    std::mutex mutex_;                   ///< Защищает ожидание новых задач.
+    std::condition_variable wake_;       ///< Сигнал о новых задачах.
+    std::atomic<size_t> queued_{ 0 };    ///< Задачи, лежащие в очередях.
+    std::atomic<size_t> next_{ 0 };      ///< Очередь для следующей внешней задачи.
+    TaskGroup group_;                    ///< Группа задач, поставленных без явной группы.
+    bool stop_ = false;
+
+    static size_t& workerIndex() noexcept {
+        thread_local size_t index = static_cast<size_t>(-1);
+        return index;
+    }
+
+    static TaskPool*& workerPool() noexcept {
+        thread_local TaskPool* pool = nullptr;
+        return pool;
+    }
+
+    bool takeTask(size_t self, std::function<void()>& task) {
+        {
+            std::lock_guard<std::mutex> lock(queues_[self].mutex);
+            if (!queues_[self].tasks.empty()) {
+                task = std::move(queues_[self].tasks.back());
+                queues_[self].tasks.pop_back();
+                --queued_;
+                return true;
+            }
+        }
+
+        for (size_t shift = 1; shift < queues_.size(); ++shift) {
+            Queue& victim = queues_[(self + shift) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                --queued_;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        workerIndex() = self;
+        workerPool() = this;
+        std::function<void()> task;
+
+        while (true) {
+            if (takeTask(self, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) return;
+        }
+    }
+
+public:
+    /**
+     * @brief Создать пул.
+     * @param threads Количество рабочих потоков (0 — по числу аппаратных потоков).
+     */
+    explicit TaskPool(size_t threads = 0) : queues_(threads == 0 ? hardwareThreads() : threads) {
+        workers_.reserve(queues_.size());
+        for (size_t t = 0; t < queues_.size(); ++t) workers_.emplace_back(&TaskPool::workerLoop, this, t);
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * @brief Дождаться выполнения задач и остановить потоки.
+     */
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+
+        for (auto& worker : workers_) worker.join();
+    }
+
+    /**
+     * @brief Количество рабочих потоков.
+     * @return Количество потоков.
+     */
+    size_t getThreadCount() const noexcept { return workers_.size(); }
+
+    /**
+     * @brief Поставить задачу группы в пул.
+     * @param group Группа, в которой учитываются задача и ее исключение.
+     * @param task Задача.
+     */
+    void submit(TaskGroup& group, std::function<void()> task) {
+        const size_t self = workerPool() == this ? workerIndex() : next_++ % queues_.size();
+        group.add();
+
+        {
+            std::lock_guard<std::mutex> lock(queues_[self].mutex);
+            queues_[self].tasks.push_back([&group, task = std::move(task)] {
+                std::exception_ptr error;
+                try {
+                    task();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                group.finish(error);
+            });
+            ++queued_;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_one();
+    }
+
+    /**
+     * @brief Поставить задачу в общую группу пула.
+     * @param task Задача.
+     */
+    void submit(std::function<void()> task) { submit(group_, std::move(task)); }
+
+    /**
+     * @brief Дождаться завершения задач группы.
+     *
+     * Первое исключение, брошенное задачей группы, пробрасывается вызывающему.
+     *
+     * @param group Группа.
+     */
+    void wait(TaskGroup& group) {
+        std::unique_lock<std::mutex> lock(group.mutex_);
+        group.idle_.wait(lock, [&group] { return group.pending_ == 0; });
+
+        if (group.error_) {
+            std::exception_ptr error = group.error_;
+            group.error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Дождаться завершения задач, поставленных без явной группы.
+     *
+     * Первое исключение, брошенное такой задачей, пробрасывается вызывающему.
+     */
+    void wait() { wait(group_); }
+};
+
+/**
+ * @brief Общий пул потоков библиотеки.
+ * @return Пул, создаваемый при первом обращении.
+ */
+inline TaskPool& sharedTaskPool() {
+    static TaskPool pool;
+    return pool;
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,381 @@
+/**
+ * @file diagonal_matrix.hpp
+ * @brief Диагональный (DIA) формат хранения для ленточных матриц и разностных шаблонов.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "sparse_matrix.hpp"
+
+#define DIA_MAX_DIAGONALS 32
+
+#define DIA_MIN_FILL 0.5
+
+#define DIA_ROW_GRAIN 1024
+
+namespace matrix_lib {
+
+/**
+ * @brief Разреженная матрица в формате DIA: смещения диагоналей и плотные массивы диагоналей.
+ *
+ * Диагональ со смещением k содержит элементы A(i, i + k) и хранится массивом длины getRows(),
+ * позиции за пределами матрицы заполнены нулями. Индексы отдельных элементов не хранятся,
+ * поэтому SpMV сводится к непрерывным проходам по диагоналям, которые компилятор векторизует.
+ *
+ * @tparam T Тип элементов матрицы.
+ */
+template <typename T>
+class DiagonalMatrix {
+private:
+    size_t rows_;                          ///< Количество строк.
+    size_t cols_;                          ///< Количество столбцов.
+    std::vector<std::ptrdiff_t> offsets_;  ///< Смещения диагоналей по возрастанию.
+    std::vector<T> diagonals_;             ///< Диагонали подряд: diagonals_[d * rows_ + i] = A(i, i + offsets_[d]).
+
+    /**
+     * @brief Диапазон строк [first, last), в которых диагональ пересекает матрицу.
+     * @param offset Смещение диагонали.
+     * @return Пара индексов строк.
+     */
+    std::pair<size_t, size_t> diagonalRange(std::ptrdiff_t offset) const noexcept;
+
+    /**
+     * @brief Номер диагонали с заданным смещением.
+     * @param offset Смещение.
+     * @return Номер диагонали или getDiagonalCount(), если диагональ не хранится.
+     */
+    size_t findDiagonal(std::ptrdiff_t offset) const noexcept;
+
+public:
+    /**
+     * @brief Конструктор матрицы с заданным набором нулевых диагоналей.
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param offsets Смещения диагоналей (столбец минус строка).
+     * @throw std::invalid_argument Если смещение повторяется или диагональ не пересекает матрицу.
+     */
+    DiagonalMatrix(size_t rows, size_t cols, std::vector<std::ptrdiff_t> offsets);
+
+    /**
+     * @brief Конструктор из разреженной матрицы (повторы разрешаются как в getValue()).
+     * @param matrix Исходная матрица.
+     */
+    explicit DiagonalMatrix(const SparseMatrix<T>& matrix);
+
+    /**
+     * @brief Количество различных диагоналей с ненулевыми элементами.
+     * @param matrix Разреженная матрица.
+     * @param limit Подсчет прекращается, как только количество превышает limit.
+     * @return Количество диагоналей (не больше limit + 1).
+     */
+    static size_t countDiagonals(const SparseMatrix<T>& matrix, size_t limit = DIA_MAX_DIAGONALS);
+
+    /**
+     * @brief Выгоден ли формат DIA для матрицы.
+     *
+     * Требуется не больше DIA_MAX_DIAGONALS диагоналей и доля ненулевых элементов среди хранимых
+     * позиций не меньше DIA_MIN_FILL.
+     *
+     * @param matrix Разреженная матрица.
+     * @return true, если формат DIA выгоден.
+     */
+    static bool isSuitable(const SparseMatrix<T>& matrix);
+
+    /**
+     * @brief Возвращает количество строк.
+     * @return Количество строк.
+     */
+    size_t getRows() const noexcept { return rows_; }
+
+    /**
+     * @brief Возвращает количество столбцов.
+     * @return Количество столбцов.
+     */
+    size_t getCols() const noexcept { return cols_; }
+
+    /**
+     * @brief Возвращает количество хранимых диагоналей.
+     * @return Количество диагоналей.
+     */
+    size_t getDiagonalCount() const noexcept { return offsets_.size(); }
+
+    /**
+     * @brief Смещения хранимых диагоналей.
+     * @return Смещения по возрастанию.
+     */
+    const std::vector<std::ptrdiff_t>& getOffsets() const noexcept { return offsets_; }
+
+    /**
+     * @brief Получить значение по индексу.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return Значение в указанной позиции.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    T getValue(const size_t row, const size_t col) const;
+
+    /**
+     * @brief Записать значение на одну из хранимых диагоналей.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @param value Новое значение.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     * @throw std::invalid_argument Если позиция не лежит на хранимой диагонали.
+     */
+    void setValue(const size_t row, const size_t col, const T value);
+
+    /**
+     * @brief Умножение на вектор y = A * x.
+     * @param vector Вектор длины getCols().
+     * @return Вектор-произведение.
+     * @throw std::invalid_argument Если размер вектора не совпадает с количеством столбцов.
+     */
+    std::vector<T> multiplyVectorDiagonalMatrix(const std::vector<T>& vector) const;
+
+    /**
+     * @brief Умножение транспонированной матрицы на вектор y = A^T * x без транспонирования.
+     * @param vector Вектор длины getRows().
+     * @return Вектор-произведение.
+     * @throw std::invalid_argument Если размер вектора не совпадает с количеством строк.
+     */
+    std::vector<T> multiplyTransposedVectorDiagonalMatrix(const std::vector<T>& vector) const;
+
+    /**
+     * @brief Умножение на плотную матрицу.
+     * @param dense Плотная матрица.
+     * @return Плотная матрица-произведение.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    Matrix<T> operator*(const Matrix<T>& dense) const;
+
+    /**
+     * @brief Преобразовать в разреженную матрицу (в порядке строк и столбцов, без нулей).
+     * @return Разреженная матрица.
+     */
+    SparseMatrix<T> toSparseMatrix() const;
+};
+
+template <typename T>
+std::pair<size_t, size_t> DiagonalMatrix<T>::diagonalRange(std::ptrdiff_t offset) const noexcept {
+    const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(rows_);
+    const std::ptrdiff_t cols = static_cast<std::ptrdiff_t>(cols_);
+    const std::ptrdiff_t first = std::max<std::ptrdiff_t>(0, -offset);
+    const std::ptrdiff_t last = std::min(rows, cols - offset);
+
+    return { static_cast<size_t>(first), static_cast<size_t>(std::max(first, last)) };
+}
+
+template <typename T>
+size_t DiagonalMatrix<T>::findDiagonal(std::ptrdiff_t offset) const noexcept {
+    auto it = std::lower_bound(offsets_.begin(), offsets_.end(), offset);
+    return (it != offsets_.end() && *it == offset) ? static_cast<size_t>(it - offsets_.begin()) : offsets_.size();
+}
+
+template <typename T>
+DiagonalMatrix<T>::DiagonalMatrix(size_t rows, size_t cols, std::vector<std::ptrdiff_t> offsets)
+    : rows_(rows), cols_(cols), offsets_(std::move(offsets)) {
+    std::sort(offsets_.begin(), offsets_.end());
+
+    for (size_t d = 0; d < offsets_.size(); ++d) {
+        if (d > 0 && offsets_[d] == offsets_[d - 1])
+            throw std::invalid_argument("Diagonal offsets must be unique");
+
+        const std::pair<size_t, size_t> range = diagonalRange(offsets_[d]);
+        if (range.first == range.second)
+            throw std::invalid_argument("Diagonal offset lies outside the matrix");
+    }
+
+    diagonals_.assign(offsets_.size() * rows_, static_cast<T>(0));
+}
+
+template <typename T>
+DiagonalMatrix<T>::DiagonalMatrix(const SparseMatrix<T>& matrix)
+    : rows_(matrix.rows_), cols_(matrix.cols_) {
+    std::vector<char> present(rows_ + cols_, 0);
+    for (size_t i = 0; i < matrix.values.size(); ++i) present[matrix.colsIndexes[i] + rows_ - matrix.rowsIndexes[i]] = 1;
+
+    for (size_t k = 0; k < present.size(); ++k)
+        if (present[k]) offsets_.push_back(static_cast<std::ptrdiff_t>(k) - static_cast<std::ptrdiff_t>(rows_));
+
+    diagonals_.assign(offsets_.size() * rows_, static_cast<T>(0));
+
+    const CompressedRows<T> csr = matrix.toCompressedRows();
+    parallelFor(0, rows_, [&](size_t i) {
+        size_t d = 0;
+        for (size_t p = csr.rowPtr[i]; p < csr.rowPtr[i + 1]; ++p) {
+            const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(csr.colIdx[p]) - static_cast<std::ptrdiff_t>(i);
+            while (offsets_[d] < offset) ++d;
+            diagonals_[d * rows_ + i] = csr.values[p];
+        }
+    }, DIA_ROW_GRAIN);
+}
+
+template <typename T>
+size_t DiagonalMatrix<T>::countDiagonals(const SparseMatrix<T>& matrix, size_t limit) {
+    std::vector<char> present(matrix.rows_ + matrix.cols_, 0);
+    size_t count = 0;
+
+    for (size_t i = 0; i < matrix.values.size() && count <= limit; ++i) {
+        char& seen = present[matrix.colsIndexes[i] + matrix.rows_ - matrix.rowsIndexes[i]];
+        if (!seen) {
+            seen = 1;
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+template <typename T>
+bool DiagonalMatrix<T>::isSuitable(const SparseMatrix<T>& matrix) {
+    const size_t count = countDiagonals(matrix);
+    if (count == 0 || count > DIA_MAX_DIAGONALS) return false;
+
+    return static_cast<double>(matrix.getNonZeroCount()) >= DIA_MIN_FILL * static_cast<double>(count * matrix.rows_);
+}
+
+template <typename T>
+T DiagonalMatrix<T>::getValue(const size_t row, const size_t col) const {
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of range");
+
+    const size_t d = findDiagonal(static_cast<std::ptrdiff_t>(col) - static_cast<std::ptrdiff_t>(row));
+    return d == offsets_.size() ? static_cast<T>(0) : diagonals_[d * rows_ + row];
+}
+
+template <typename T>
+void DiagonalMatrix<T>::setValue(const size_t row, const size_t col, const T value) {
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of range");
+
+    const size_t d = findDiagonal(static_cast<std::ptrdiff_t>(col) - static_cast<std::ptrdiff_t>(row));
+    if (d == offsets_.size())
+        throw std::invalid_argument("Position is not on a stored diagonal");
+
+    diagonals_[d * rows_ + row] = value;
+}
+
+template <typename T>
+std::vector<T> DiagonalMatrix<T>::multiplyVectorDiagonalMatrix(const std::vector<T>& vector) const {
+    if (vector.size() != cols_)
+        throw std::invalid_argument("Vector size must match the number of columns");
+
+    std::vector<T> result(rows_, static_cast<T>(0));
+    const size_t chunks = parallelChunks(rows_, DIA_ROW_GRAIN);
+    const size_t chunk = (rows_ + chunks - 1) / chunks;
+
+    parallelFor(0, chunks, [&](size_t c) {
+        const size_t from = c * chunk;
+        const size_t to = std::min(rows_, from + chunk);
+        T* y = result.data();
+
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            const std::pair<size_t, size_t> range = diagonalRange(offsets_[d]);
+            const size_t first = std::max(from, range.first);
+            const size_t last = std::min(to, range.second);
+            if (first >= last) continue;
+
+            const T* diagonal = diagonals_.data() + d * rows_ + first;
+            const T* x = vector.data() + (static_cast<std::ptrdiff_t>(first) + offsets_[d]);
+            T* out = y + first;
+
+            for (size_t i = 0; i < last - first; ++i) out[i] += diagonal[i] * x[i];
+        }
+    }, 1);
+
+    return result;
+}
+
+template <typename T>
+std::vector<T> DiagonalMatrix<T>::multiplyTransposedVectorDiagonalMatrix(const std::vector<T>& vector) const {
+    if (vector.size() != rows_)
+        throw std::invalid_argument("Vector size must match the number of rows");
+
+    std::vector<T> result(cols_, static_cast<T>(0));
+    const size_t chunks = parallelChunks(cols_, DIA_ROW_GRAIN);
+    const size_t chunk = (cols_ + chunks - 1) / chunks;
+
+    parallelFor(0, chunks, [&](size_t c) {
+        const std::ptrdiff_t from = static_cast<std::ptrdiff_t>(c * chunk);
+        const std::ptrdiff_t to = static_cast<std::ptrdiff_t>(std::min(cols_, c * chunk + chunk));
+
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            const std::ptrdiff_t offset = offsets_[d];
+            const std::pair<size_t, size_t> range = diagonalRange(offset);
+            const std::ptrdiff_t first = std::max(from - offset, static_cast<std::ptrdiff_t>(range.first));
+            const std::ptrdiff_t last = std::min(to - offset, static_cast<std::ptrdiff_t>(range.second));
+            if (first >= last) continue;
+
+            const T* diagonal = diagonals_.data() + d * rows_ + first;
+            const T* x = vector.data() + first;
+            T* y = result.data() + (first + offset);
+
+            for (std::ptrdiff_t i = 0; i < last - first; ++i) y[i] += diagonal[i] * x[i];
+        }
+    }, 1);
+
+    return result;
+}
+
+template <typename T>
+Matrix<T> DiagonalMatrix<T>::operator*(const Matrix<T>& dense) const {
+    if (cols_ != dense.getRows())
+        throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
+
+    const size_t width = dense.getCols();
+    Matrix<T> result(rows_, width);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        T* out = result.getRowData(i);
+
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            const std::pair<size_t, size_t> range = diagonalRange(offsets_[d]);
+            if (i < range.first || i >= range.second) continue;
+
+            const T value = diagonals_[d * rows_ + i];
+            if (value == static_cast<T>(0)) continue;
+
+            const T* in = dense.getRowData(static_cast<size_t>(static_cast<std::ptrdiff_t>(i) + offsets_[d]));
+            for (size_t j = 0; j < width; ++j) out[j] += value * in[j];
+        }
+    });
+
+    return result;
+}
+
+template <typename T>
+SparseMatrix<T> DiagonalMatrix<T>::toSparseMatrix() const {
+    CompressedRows<T> csr;
+    csr.rowPtr.assign(rows_ + 1, 0);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        size_t count = 0;
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            const std::pair<size_t, size_t> range = diagonalRange(offsets_[d]);
+            if (i >= range.first && i < range.second && diagonals_[d * rows_ + i] != static_cast<T>(0)) ++count;
+        }
+        csr.rowPtr[i + 1] = count;
+    }, DIA_ROW_GRAIN);
+
+    for (size_t i = 0; i < rows_; ++i) csr.rowPtr[i + 1] += csr.rowPtr[i];
+    csr.colIdx.resize(csr.rowPtr[rows_]);
+    csr.values.resize(csr.rowPtr[rows_]);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        size_t out = csr.rowPtr[i];
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            const std::pair<size_t, size_t> range = diagonalRange(offsets_[d]);
+            const T value = diagonals_[d * rows_ + i];
+            if (i < range.first || i >= range.second || value == static_cast<T>(0)) continue;
+
+            csr.colIdx[out] = static_cast<size_t>(static_cast<std::ptrdiff_t>(i) + offsets_[d]);
+            csr.values[out++] = value;
+        }
+    }, DIA_ROW_GRAIN);
+
+    return SparseMatrix<T>(rows_, cols_, csr);
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,393 @@
+/**
+ * @file dynamic_sparse_matrix.hpp
+ * @brief Разреженная матрица с буфером пакетных изменений поверх CSR.
+ */
+
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "sparse_matrix.hpp"
+
+#define DYNAMIC_BUFFER_CAPACITY 4096
+
+#define DYNAMIC_COMPACTION_RATIO 0.1
+
+namespace matrix_lib {
+
+/**
+ * @brief Отложенное изменение элемента динамической матрицы.
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct DeltaEntry {
+    size_t row;   ///< Индекс строки.
+    size_t col;   ///< Индекс столбца.
+    T value;      ///< Новое значение (T(0) — удаление элемента).
+};
+
+/**
+ * @brief Хеш позиции (строка, столбец) для индекса буфера вставок.
+ */
+struct DeltaKeyHash {
+    size_t operator()(const std::pair<size_t, size_t>& key) const noexcept {
+        return std::hash<size_t>()(key.first * 0x9E3779B97F4A7C15ULL ^ key.second);
+    }
+};
+
+/**
+ * @brief Разреженная матрица для потоковых обновлений.
+ *
+ * Данные хранятся в трех слоях: неизменяемая база в CSR, отсортированная по (строка, столбец)
+ * дельта без повторов и небольшой буфер вставок в порядке поступления. Запись — добавление в буфер
+ * за O(1); хеш-индекс буфера по позиции дает чтению последнее значение из буфера за O(1) вместо
+ * просмотра всего буфера. Заполненный буфер сортируется и сливается с дельтой; когда дельта превышает долю
+ * DYNAMIC_COMPACTION_RATIO от базы, выполняется параллельное слияние дельты с базой.
+ *
+ * Чтение видит объединенное представление: новое значение перекрывает старое, нулевое значение
+ * удаляет элемент. Одновременные запись и чтение из разных потоков не синхронизируются.
+ *
+ * @tparam T Тип элементов матрицы.
+ */
+template <typename T>
+class DynamicSparseMatrix {
+private:
+    size_t rows_;                        ///< Количество строк.
+    size_t cols_;                        ///< Количество столбцов.
+    CompressedRows<T> base_;             ///< База в CSR (столбцы в строке упорядочены).
+    std::vector<DeltaEntry<T>> delta_;   ///< Отсортированные изменения без повторов.
+    std::vector<DeltaEntry<T>> buffer_;  ///< Изменения в порядке поступления.
+    std::unordered_map<std::pair<size_t, size_t>, size_t, DeltaKeyHash> bufferIndex_;  ///< Последнее изменение позиции в буфере.
+    size_t bufferCapacity_;              ///< Размер буфера, после которого он сливается с дельтой.
+    double compactionRatio_;             ///< Доля дельты от базы, после которой выполняется уплотнение.
+
+    void checkIndex(const size_t row, const size_t col) const;
+    T baseValue(const size_t row, const size_t col) const;
+    std::vector<DeltaEntry<T>> mergedDelta() const;
+    CompressedRows<T> mergeRows(const std::vector<DeltaEntry<T>>& delta) const;
+    void maybeFlush();
+    void pushBuffer(const size_t row, const size_t col, const T value);
+
+public:
+    /**
+     * @brief Конструктор пустой матрицы.
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     */
+    DynamicSparseMatrix(size_t rows, size_t cols);
+
+    /**
+     * @brief Конструктор из разреженной матрицы (повторы разрешаются как в getValue()).
+     * @param matrix Исходная матрица.
+     */
+    explicit DynamicSparseMatrix(const SparseMatrix<T>& matrix);
+
+    /**
+     * @brief Возвращает количество строк.
+     * @return Количество строк.
+     */
+    size_t getRows() const noexcept { return rows_; }
+
+    /**
+     * @brief Возвращает количество столбцов.
+     * @return Количество столбцов.
+     */
+    size_t getCols() const noexcept { return cols_; }
+
+    /**
+     * @brief Задать размер буфера вставок и порог уплотнения.
+     * @param bufferCapacity Количество изменений в буфере до слияния с дельтой (не меньше 1).
+     * @param compactionRatio Доля дельты от количества элементов базы до уплотнения.
+     */
+    void setCompactionPolicy(size_t bufferCapacity, double compactionRatio);
+
+    /**
+     * @brief Записать значение элемента (нулевое значение удаляет элемент).
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @param value Новое значение.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    void setValue(const size_t row, const size_t col, const T value);
+
+    /**
+     * @brief Удалить элемент.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    void removeValue(const size_t row, const size_t col) { setValue(row, col, static_cast<T>(0)); }
+
+    /**
+     * @brief Пакетная запись значений; более поздние записи перекрывают ранние.
+     * @param rows Индексы строк.
+     * @param cols Индексы столбцов.
+     * @param values Новые значения.
+     * @throw std::invalid_argument Если размеры векторов не совпадают.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    void setValues(const std::vector<size_t>& rows, const std::vector<size_t>& cols, const std::vector<T>& values);
+
+    /**
+     * @brief Получить значение по индексу с учетом всех изменений.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return Значение в указанной позиции.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    T getValue(const size_t row, const size_t col) const;
+
+    /**
+     * @brief Количество изменений, еще не слитых с базой.
+     * @return Размер дельты и буфера.
+     */
+    size_t getPendingCount() const noexcept { return delta_.size() + buffer_.size(); }
+
+    /**
+     * @brief Количество ненулевых элементов с учетом всех изменений.
+     * @return Количество элементов.
+     */
+    size_t getNonZeroCount() const;
+
+    /**
+     * @brief Отсортировать буфер вставок и слить его с дельтой.
+     */
+    void flushDynamicSparseMatrix();
+
+    /**
+     * @brief Параллельно слить все изменения с базой.
+     */
+    void compactDynamicSparseMatrix();
+
+    /**
+     * @brief Умножение на вектор: SpMV по базе и поправки от дельты.
+     * @param vector Вектор длины getCols().
+     * @return Вектор-произведение.
+     * @throw std::invalid_argument Если размер вектора не совпадает с количеством столбцов.
+     */
+    std::vector<T> multiplyVectorDynamicSparseMatrix(const std::vector<T>& vector) const;
+
+    /**
+     * @brief Получить объединенные данные в виде SparseMatrix (в порядке строк и столбцов).
+     * @return Разреженная матрица.
+     */
+    SparseMatrix<T> toSparseMatrix() const;
+};
+
+template <typename T>
+DynamicSparseMatrix<T>::DynamicSparseMatrix(size_t rows, size_t cols)
+    : rows_(rows), cols_(cols), base_{ std::vector<size_t>(rows + 1, 0), {}, {} },
+      bufferCapacity_(DYNAMIC_BUFFER_CAPACITY), compactionRatio_(DYNAMIC_COMPACTION_RATIO) {}
+
+template <typename T>
+DynamicSparseMatrix<T>::DynamicSparseMatrix(const SparseMatrix<T>& matrix)
+    : rows_(matrix.getRowsSparseMatrix()), cols_(matrix.getColsSparseMatrix()), base_(matrix.toCompressedRows()),
+      bufferCapacity_(DYNAMIC_BUFFER_CAPACITY), compactionRatio_(DYNAMIC_COMPACTION_RATIO) {}
+
+template <typename T>
+void DynamicSparseMatrix<T>::setCompactionPolicy(size_t bufferCapacity, double compactionRatio) {
+    bufferCapacity_ = std::max<size_t>(bufferCapacity, 1);
+    compactionRatio_ = compactionRatio;
+    maybeFlush();
+}
+
+template <typename T>
+inline void DynamicSparseMatrix<T>::checkIndex(const size_t row, const size_t col) const {
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of range");
+}
+
+template <typename T>
+T DynamicSparseMatrix<T>::baseValue(const size_t row, const size_t col) const {
+    auto first = base_.colIdx.begin() + base_.rowPtr[row];
+    auto last = base_.colIdx.begin() + base_.rowPtr[row + 1];
+    auto it = std::lower_bound(first, last, col);
+
+    return (it != last && *it == col) ? base_.values[it - base_.colIdx.begin()] : static_cast<T>(0);
+}
+
+template <typename T>
+std::vector<DeltaEntry<T>> DynamicSparseMatrix<T>::mergedDelta() const {
+    auto less = [](const DeltaEntry<T>& a, const DeltaEntry<T>& b) {
+        return a.row < b.row || (a.row == b.row && a.col < b.col);
+    };
+
+    std::vector<DeltaEntry<T>> sorted(buffer_);
+    std::stable_sort(sorted.begin(), sorted.end(), less);
+
+    std::vector<DeltaEntry<T>> fresh;
+    fresh.reserve(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i)
+        if (i + 1 == sorted.size() || less(sorted[i], sorted[i + 1])) fresh.push_back(sorted[i]);
+
+    std::vector<DeltaEntry<T>> merged;
+    merged.reserve(delta_.size() + fresh.size());
+
+    size_t p = 0;
+    size_t q = 0;
+    while (p < delta_.size() || q < fresh.size()) {
+        if (q == fresh.size() || (p < delta_.size() && less(delta_[p], fresh[q]))) {
+            merged.push_back(delta_[p++]);
+        } else {
+            if (p < delta_.size() && !less(fresh[q], delta_[p])) ++p;
+            merged.push_back(fresh[q++]);
+        }
+    }
+
+    return merged;
+}
+
+template <typename T>
+CompressedRows<T> DynamicSparseMatrix<T>::mergeRows(const std::vector<DeltaEntry<T>>& delta) const {
+    std::vector<size_t> deltaPtr(rows_ + 1, 0);
+    for (const DeltaEntry<T>& entry : delta) ++deltaPtr[entry.row + 1];
+    for (size_t i = 0; i < rows_; ++i) deltaPtr[i + 1] += deltaPtr[i];
+
+    auto mergeRow = [&](size_t i, auto&& emit) {
+        size_t p = base_.rowPtr[i];
+        size_t q = deltaPtr[i];
+
+        while (p < base_.rowPtr[i + 1] || q < deltaPtr[i + 1]) {
+            if (q == deltaPtr[i + 1] || (p < base_.rowPtr[i + 1] && base_.colIdx[p] < delta[q].col)) {
+                emit(base_.colIdx[p], base_.values[p]);
+                ++p;
+            } else {
+                if (p < base_.rowPtr[i + 1] && base_.colIdx[p] == delta[q].col) ++p;
+                if (delta[q].value != static_cast<T>(0)) emit(delta[q].col, delta[q].value);
+                ++q;
+            }
+        }
+    };
+
+    CompressedRows<T> result;
+    result.rowPtr.assign(rows_ + 1, 0);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        size_t count = 0;
+        mergeRow(i, [&](size_t, T) { ++count; });
+        result.rowPtr[i + 1] = count;
+    });
+
+    for (size_t i = 0; i < rows_; ++i) result.rowPtr[i + 1] += result.rowPtr[i];
+
+    result.colIdx.resize(result.rowPtr[rows_]);
+    result.values.resize(result.rowPtr[rows_]);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        size_t out = result.rowPtr[i];
+        mergeRow(i, [&](size_t col, T value) {
+            result.colIdx[out] = col;
+            result.values[out++] = value;
+        });
+    });
+
+    return result;
+}
+
+template <typename T>
+void DynamicSparseMatrix<T>::maybeFlush() {
+    if (buffer_.size() >= bufferCapacity_) flushDynamicSparseMatrix();
+
+    if (delta_.size() >= bufferCapacity_ &&
+        static_cast<double>(delta_.size()) > compactionRatio_ * static_cast<double>(base_.colIdx.size()))
+        compactDynamicSparseMatrix();
+}
+
+template <typename T>
+inline void DynamicSparseMatrix<T>::pushBuffer(const size_t row, const size_t col, const T value) {
+    bufferIndex_[{ row, col }] = buffer_.size();
+    buffer_.push_back({ row, col, value });
+}
+
+template <typename T>
+void DynamicSparseMatrix<T>::setValue(const size_t row, const size_t col, const T value) {
+    checkIndex(row, col);
+
+    pushBuffer(row, col, value);
+    maybeFlush();
+}
+
+template <typename T>
+void DynamicSparseMatrix<T>::setValues(const std::vector<size_t>& rows, const std::vector<size_t>& cols,
+                                       const std::vector<T>& values) {
+    if (rows.size() != cols.size() || rows.size() != values.size())
+        throw std::invalid_argument("Index and value vectors must have the same size");
+
+    for (size_t i = 0; i < rows.size(); ++i) checkIndex(rows[i], cols[i]);
+
+    buffer_.reserve(buffer_.size() + rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) pushBuffer(rows[i], cols[i], values[i]);
+
+    maybeFlush();
+}
+
+template <typename T>
+T DynamicSparseMatrix<T>::getValue(const size_t row, const size_t col) const {
+    checkIndex(row, col);
+
+    auto buffered = bufferIndex_.find({ row, col });
+    if (buffered != bufferIndex_.end()) return buffer_[buffered->second].value;
+
+    auto it = std::lower_bound(delta_.begin(), delta_.end(), DeltaEntry<T>{ row, col, static_cast<T>(0) },
+                               [](const DeltaEntry<T>& a, const DeltaEntry<T>& b) {
+                                   return a.row < b.row || (a.row == b.row && a.col < b.col);
+                               });
+    if (it != delta_.end() && it->row == row && it->col == col) return it->value;
+
+    return baseValue(row, col);
+}
+
+template <typename T>
+size_t DynamicSparseMatrix<T>::getNonZeroCount() const {
+    size_t count = base_.colIdx.size();
+
+    for (const DeltaEntry<T>& entry : mergedDelta()) {
+        const bool before = baseValue(entry.row, entry.col) != static_cast<T>(0);
+        const bool after = entry.value != static_cast<T>(0);
+        if (before && !after) --count;
+        if (!before && after) ++count;
+    }
+
+    return count;
+}
+
+template <typename T>
+void DynamicSparseMatrix<T>::flushDynamicSparseMatrix() {
+    if (buffer_.empty()) return;
+
+    delta_ = mergedDelta();
+    buffer_.clear();
+    bufferIndex_.clear();
+}
+
+template <typename T>
+void DynamicSparseMatrix<T>::compactDynamicSparseMatrix() {
+    flushDynamicSparseMatrix();
+    if (delta_.empty()) return;
+
+    base_ = mergeRows(delta_);
+    delta_.clear();
+}
+
+template <typename T>
+std::vector<T> DynamicSparseMatrix<T>::multiplyVectorDynamicSparseMatrix(const std::vector<T>& vector) const {
+    if (vector.size() != cols_)
+        throw std::invalid_argument("Vector size must match the number of columns");
+
+    std::vector<T> result(rows_);
+    multiplyVectorCompressedRows<PlusTimes<T>>(base_, vector.data(), result.data());
+
+    for (const DeltaEntry<T>& entry : mergedDelta())
+        result[entry.row] += (entry.value - baseValue(entry.row, entry.col)) * vector[entry.col];
+
+    return result;
+}
+
+template <typename T>
+SparseMatrix<T> DynamicSparseMatrix<T>::toSparseMatrix() const {
+    return SparseMatrix<T>(rows_, cols_, mergeRows(mergedDelta()));
+}
+
+} // namespace matrix_lib
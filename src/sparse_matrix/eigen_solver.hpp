@@ -0,0 +1,771 @@
+/**
+ * @file eigen_solver.hpp
+ * @brief Итерационный поиск собственных пар разреженных матриц методами Ланцоша и Арнольди.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include "sparse_matrix.hpp"
+
+#define KRYLOV_MIN_DIMENSION 20
+
+#define KRYLOV_MAX_RESTARTS 300
+
+#define KRYLOV_VECTOR_GRAIN 4096
+
+namespace matrix_lib {
+
+/**
+ * @brief Какие собственные значения считаются искомыми.
+ */
+enum class EigenTarget {
+    LargestMagnitude,   ///< Наибольшие по модулю.
+    LargestAlgebraic,   ///< Наибольшие по (вещественной части) значению.
+    SmallestAlgebraic   ///< Наименьшие по (вещественной части) значению.
+};
+
+/**
+ * @brief Результат для симметричной матрицы: вещественные собственные пары.
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct SymmetricEigenResult {
+    std::vector<T> values;   ///< Собственные значения в порядке EigenTarget.
+    Matrix<T> vectors;       ///< Собственные векторы в столбцах (n x k).
+    size_t restarts;         ///< Количество выполненных перезапусков.
+    bool converged;          ///< Достигнута ли заданная точность для всех пар.
+};
+
+/**
+ * @brief Результат для несимметричной матрицы: комплексные собственные пары.
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct EigenResult {
+    std::vector<std::complex<T>> values;                ///< Собственные значения в порядке EigenTarget.
+    std::vector<std::vector<std::complex<T>>> vectors;  ///< Собственные векторы (по одному на значение).
+    size_t restarts;                                    ///< Количество выполненных перезапусков.
+    bool converged;                                     ///< Достигнута ли заданная точность для всех пар.
+};
+
+/**
+ * @brief Решатель частичной проблемы собственных значений в подпространствах Крылова.
+ *
+ * Для симметричных матриц используется неявно перезапускаемый метод Ланцоша,
+ * для несимметричных — неявно перезапускаемый метод Арнольди (точные сдвиги, двойные
+ * вещественные сдвиги для комплексно-сопряженных пар). Матрица один раз переводится в CSR,
+ * каждая итерация использует параллельное SpMV. Память ограничена базисом из krylovDim + 1
+ * векторов длины n и плотными матрицами размера krylovDim x krylovDim.
+ *
+ * @tparam T Вещественный тип элементов.
+ */
+template <typename T>
+class KrylovEigenSolver {
+    static_assert(std::is_floating_point<T>::value, "KrylovEigenSolver requires a floating point type.");
+
+private:
+    using Complex = std::complex<T>;
+
+    CompressedRows<T> csr_;   ///< Матрица оператора в CSR.
+    size_t n_;                ///< Размер матрицы.
+    size_t count_;            ///< Количество искомых пар.
+    size_t krylovDim_;        ///< Размерность подпространства Крылова.
+    EigenTarget target_;      ///< Критерий выбора пар.
+    T tolerance_;             ///< Относительная точность невязки.
+    size_t maxRestarts_;      ///< Предельное количество перезапусков.
+    bool symmetric_;          ///< Режим Ланцоша (симметричная трехдиагональная H).
+    Matrix<T> basis_;         ///< Базис Крылова: (krylovDim + 1) x n, векторы в строках.
+    Matrix<T> hessenberg_;    ///< Матрица Хессенберга: (krylovDim + 1) x krylovDim.
+    std::mt19937 generator_;  ///< Генератор начальных векторов.
+
+    void fillRandom(T* vector);
+    T dot(const T* x, const T* y) const;
+    void orthogonalize(T* vector, size_t count, std::vector<T>& coeffs) const;
+    void extendFactorization(size_t from);
+    void symmetrizeHessenberg();
+    bool precedes(const Complex& a, const Complex& b) const;
+    void applyShifts(const std::vector<Complex>& shifts, size_t keep);
+
+    static void jacobiEigen(std::vector<T>& a, size_t m, std::vector<T>& vectors);
+    static std::vector<Complex> hessenbergEigenvalues(const std::vector<T>& h, size_t m);
+    static std::vector<Complex> hessenbergEigenvector(const std::vector<T>& h, size_t m, const Complex& lambda);
+    static void householderQR(const std::vector<T>& a, size_t m, std::vector<T>& q);
+    static void givensShift(std::vector<T>& h, std::vector<T>& q, size_t m, T mu);
+
+    std::vector<T> leadingHessenberg() const;
+    template <typename Result>
+    void run(Result& result);
+
+public:
+    /**
+     * @brief Создать решатель для квадратной разреженной матрицы.
+     * @param matrix Матрица оператора.
+     * @param count Количество искомых собственных пар.
+     * @param target Критерий выбора собственных значений.
+     * @param krylovDim Размерность подпространства Крылова (0 — выбрать автоматически).
+     * @throw std::invalid_argument Если матрица не квадратная или параметры некорректны.
+     */
+    KrylovEigenSolver(const SparseMatrix<T>& matrix, size_t count,
+                      EigenTarget target = EigenTarget::LargestMagnitude, size_t krylovDim = 0);
+
+    /**
+     * @brief Задать относительную точность невязки собственных пар.
+     * @param tolerance Точность.
+     */
+    void setTolerance(T tolerance) noexcept { tolerance_ = tolerance; }
+
+    /**
+     * @brief Задать предельное количество перезапусков.
+     * @param maxRestarts Количество перезапусков.
+     */
+    void setMaxRestarts(size_t maxRestarts) noexcept { maxRestarts_ = maxRestarts; }
+
+    /**
+     * @brief Размерность подпространства Крылова.
+     * @return Количество базисных векторов.
+     */
+    size_t getKrylovDimension() const noexcept { return krylovDim_; }
+
+    /**
+     * @brief Метод Ланцоша для симметричной матрицы (симметричность не проверяется).
+     * @return Вещественные собственные пары.
+     */
+    SymmetricEigenResult<T> solveSymmetric();
+
+    /**
+     * @brief Метод Арнольди для матрицы общего вида.
+     * @return Комплексные собственные пары.
+     */
+    EigenResult<T> solveGeneral();
+};
+
+template <typename T>
+KrylovEigenSolver<T>::KrylovEigenSolver(const SparseMatrix<T>& matrix, size_t count, EigenTarget target, size_t krylovDim)
+    : csr_(matrix.toCompressedRows()), n_(matrix.getRowsSparseMatrix()), count_(count), krylovDim_(krylovDim),
+      target_(target), tolerance_(std::sqrt(std::numeric_limits<T>::epsilon())), maxRestarts_(KRYLOV_MAX_RESTARTS),
+      symmetric_(false), basis_(0, 0), hessenberg_(0, 0), generator_(static_cast<unsigned>(n_)) {
+    if (!matrix.isSquareSparseMatrix())
+        throw std::invalid_argument("Matrix must be square");
+
+    if (count_ == 0 || count_ > n_)
+        throw std::invalid_argument("Eigenpair count must be between 1 and the matrix size");
+
+    if (krylovDim_ == 0) krylovDim_ = std::max<size_t>(2 * count_ + 1, KRYLOV_MIN_DIMENSION);
+    krylovDim_ = std::min(krylovDim_, n_);
+
+    if (krylovDim_ <= count_ && krylovDim_ < n_)
+        throw std::invalid_argument("Krylov dimension must exceed the eigenpair count");
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::fillRandom(T* vector) {
+    std::uniform_real_distribution<T> dist(static_cast<T>(-1), static_cast<T>(1));
+    for (size_t i = 0; i < n_; ++i) vector[i] = dist(generator_);
+}
+
+template <typename T>
+T KrylovEigenSolver<T>::dot(const T* x, const T* y) const {
+    const size_t chunks = parallelChunks(n_, KRYLOV_VECTOR_GRAIN);
+    const size_t chunk = (n_ + chunks - 1) / chunks;
+    std::vector<T> partial(chunks, static_cast<T>(0));
+
+    parallelFor(0, chunks, [&](size_t c) {
+        const size_t to = std::min(n_, (c + 1) * chunk);
+        T sum = static_cast<T>(0);
+        for (size_t i = c * chunk; i < to; ++i) sum += x[i] * y[i];
+        partial[c] = sum;
+    }, 1);
+
+    return std::accumulate(partial.begin(), partial.end(), static_cast<T>(0));
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::orthogonalize(T* vector, size_t count, std::vector<T>& coeffs) const {
+    coeffs.assign(count, static_cast<T>(0));
+    std::vector<T> pass(count);
+
+    const size_t chunks = parallelChunks(n_, KRYLOV_VECTOR_GRAIN);
+    const size_t chunk = (n_ + chunks - 1) / chunks;
+
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        std::vector<T> partial(chunks * count, static_cast<T>(0));
+
+        parallelFor(0, chunks, [&](size_t c) {
+            const size_t to = std::min(n_, (c + 1) * chunk);
+            for (size_t j = 0; j < count; ++j) {
+                const T* v = basis_.getRowData(j);
+                T sum = static_cast<T>(0);
+                for (size_t i = c * chunk; i < to; ++i) sum += v[i] * vector[i];
+                partial[c * count + j] = sum;
+            }
+        }, 1);
+
+        for (size_t j = 0; j < count; ++j) {
+            pass[j] = static_cast<T>(0);
+            for (size_t c = 0; c < chunks; ++c) pass[j] += partial[c * count + j];
+            coeffs[j] += pass[j];
+        }
+
+        parallelFor(0, chunks, [&](size_t c) {
+            const size_t to = std::min(n_, (c + 1) * chunk);
+            for (size_t j = 0; j < count; ++j) {
+                const T* v = basis_.getRowData(j);
+                for (size_t i = c * chunk; i < to; ++i) vector[i] -= pass[j] * v[i];
+            }
+        }, 1);
+    }
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::extendFactorization(size_t from) {
+    std::vector<T> coeffs;
+
+    for (size_t j = from; j < krylovDim_; ++j) {
+        T* w = basis_.getRowData(j + 1);
+        multiplyVectorCompressedRows<PlusTimes<T>>(csr_, basis_.getRowData(j), w);
+
+        const T scale = std::sqrt(dot(w, w));
+        orthogonalize(w, j + 1, coeffs);
+        for (size_t i = 0; i <= j; ++i) hessenberg_(i, j) = coeffs[i];
+
+        T beta = std::sqrt(dot(w, w));
+
+        if (beta <= std::numeric_limits<T>::epsilon() * scale || beta == static_cast<T>(0)) {
+            beta = static_cast<T>(0);
+
+            if (j + 1 < n_) {
+                fillRandom(w);
+                orthogonalize(w, j + 1, coeffs);
+                const T norm = std::sqrt(dot(w, w));
+                for (size_t i = 0; i < n_; ++i) w[i] /= norm;
+            } else {
+                std::fill(w, w + n_, static_cast<T>(0));
+            }
+        } else {
+            for (size_t i = 0; i < n_; ++i) w[i] /= beta;
+        }
+
+        hessenberg_(j + 1, j) = beta;
+    }
+
+    if (symmetric_) symmetrizeHessenberg();
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::symmetrizeHessenberg() {
+    for (size_t j = 0; j < krylovDim_; ++j) {
+        for (size_t i = 0; i < krylovDim_; ++i)
+            if (i + 1 < j || i > j + 1) hessenberg_(i, j) = static_cast<T>(0);
+
+        if (j + 1 < krylovDim_) hessenberg_(j, j + 1) = hessenberg_(j + 1, j);
+    }
+}
+
+template <typename T>
+bool KrylovEigenSolver<T>::precedes(const Complex& a, const Complex& b) const {
+    switch (target_) {
+        case EigenTarget::LargestAlgebraic: return a.real() > b.real();
+        case EigenTarget::SmallestAlgebraic: return a.real() < b.real();
+        default: return std::abs(a) > std::abs(b);
+    }
+}
+
+template <typename T>
+std::vector<T> KrylovEigenSolver<T>::leadingHessenberg() const {
+    std::vector<T> h(krylovDim_ * krylovDim_);
+    for (size_t i = 0; i < krylovDim_; ++i)
+        for (size_t j = 0; j < krylovDim_; ++j) h[i * krylovDim_ + j] = hessenberg_(i, j);
+
+    return h;
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::householderQR(const std::vector<T>& a, size_t m, std::vector<T>& q) {
+    std::vector<T> r(a);
+    q.assign(m * m, static_cast<T>(0));
+    for (size_t i = 0; i < m; ++i) q[i * m + i] = static_cast<T>(1);
+
+    std::vector<T> v(m);
+    for (size_t k = 0; k + 1 < m; ++k) {
+        T norm = static_cast<T>(0);
+        for (size_t i = k; i < m; ++i) norm += r[i * m + k] * r[i * m + k];
+        norm = std::sqrt(norm);
+        if (norm == static_cast<T>(0)) continue;
+
+        const T alpha = r[k * m + k] > 0 ? -norm : norm;
+        for (size_t i = 0; i < m; ++i) v[i] = i < k ? static_cast<T>(0) : r[i * m + k];
+        v[k] -= alpha;
+
+        T vv = static_cast<T>(0);
+        for (size_t i = k; i < m; ++i) vv += v[i] * v[i];
+        if (vv == static_cast<T>(0)) continue;
+
+        for (size_t j = 0; j < m; ++j) {
+            T s = static_cast<T>(0);
+            for (size_t i = k; i < m; ++i) s += v[i] * r[i * m + j];
+            s = 2 * s / vv;
+            for (size_t i = k; i < m; ++i) r[i * m + j] -= s * v[i];
+        }
+
+        for (size_t i = 0; i < m; ++i) {
+            T s = static_cast<T>(0);
+            for (size_t l = k; l < m; ++l) s += q[i * m + l] * v[l];
+            s = 2 * s / vv;
+            for (size_t l = k; l < m; ++l) q[i * m + l] -= s * v[l];
+        }
+    }
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::givensShift(std::vector<T>& h, std::vector<T>& q, size_t m, T mu) {
+    std::vector<T> cs(m, static_cast<T>(1));
+    std::vector<T> sn(m, static_cast<T>(0));
+
+    for (size_t i = 0; i < m; ++i) h[i * m + i] -= mu;
+
+    for (size_t j = 0; j + 1 < m; ++j) {
+        const T x = h[j * m + j];
+        const T y = h[(j + 1) * m + j];
+        const T r = std::hypot(x, y);
+        if (r == static_cast<T>(0)) continue;
+
+        cs[j] = x / r;
+        sn[j] = y / r;
+        for (size_t k = j; k < m; ++k) {
+            const T top = h[j * m + k];
+            const T bottom = h[(j + 1) * m + k];
+            h[j * m + k] = cs[j] * top + sn[j] * bottom;
+            h[(j + 1) * m + k] = -sn[j] * top + cs[j] * bottom;
+        }
+    }
+
+    for (size_t j = 0; j + 1 < m; ++j) {
+        for (size_t k = 0; k <= std::min(j + 1, m - 1); ++k) {
+            const T left = h[k * m + j];
+            const T right = h[k * m + j + 1];
+            h[k * m + j] = cs[j] * left + sn[j] * right;
+            h[k * m + j + 1] = -sn[j] * left + cs[j] * right;
+        }
+        for (size_t k = 0; k < m; ++k) {
+            const T left = q[k * m + j];
+            const T right = q[k * m + j + 1];
+            q[k * m + j] = cs[j] * left + sn[j] * right;
+            q[k * m + j + 1] = -sn[j] * left + cs[j] * right;
+        }
+    }
+
+    for (size_t i = 0; i < m; ++i) h[i * m + i] += mu;
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::applyShifts(const std::vector<Complex>& shifts, size_t keep) {
+    const size_t m = krylovDim_;
+    const T eps = std::numeric_limits<T>::epsilon();
+
+    std::vector<T> h = leadingHessenberg();
+    std::vector<T> q(m * m, static_cast<T>(0));
+    for (size_t i = 0; i < m; ++i) q[i * m + i] = static_cast<T>(1);
+
+    std::vector<bool> used(shifts.size(), false);
+    std::vector<T> shifted(m * m);
+    std::vector<T> step;
+    std::vector<T> tmp(m * m);
+
+    for (size_t s = 0; s < shifts.size(); ++s) {
+        if (used[s]) continue;
+        const Complex mu = shifts[s];
+
+        if (std::abs(mu.imag()) > eps * std::abs(mu)) {
+            size_t partner = s + 1;
+            while (partner < shifts.size() && (used[partner] || std::abs(shifts[partner] - std::conj(mu)) > std::sqrt(eps) * std::abs(mu)))
+                ++partner;
+            if (partner == shifts.size()) continue;
+            used[partner] = true;
+
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < m; ++j) {
+                    T sum = static_cast<T>(0);
+                    for (size_t l = 0; l < m; ++l) sum += h[i * m + l] * h[l * m + j];
+                    shifted[i * m + j] = sum - 2 * mu.real() * h[i * m + j] + (i == j ? std::norm(mu) : static_cast<T>(0));
+                }
+        } else {
+            givensShift(h, q, m, mu.real());
+            continue;
+        }
+
+        householderQR(shifted, m, step);
+
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < m; ++j) {
+                T sum = static_cast<T>(0);
+                for (size_t l = 0; l < m; ++l) sum += h[i * m + l] * step[l * m + j];
+                tmp[i * m + j] = sum;
+            }
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < m; ++j) {
+                T sum = static_cast<T>(0);
+                for (size_t l = 0; l < m; ++l) sum += step[l * m + i] * tmp[l * m + j];
+                h[i * m + j] = (i > j + 1) ? static_cast<T>(0) : sum;
+            }
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < m; ++j) {
+                T sum = static_cast<T>(0);
+                for (size_t l = 0; l < m; ++l) sum += q[i * m + l] * step[l * m + j];
+                tmp[i * m + j] = sum;
+            }
+        q.swap(tmp);
+    }
+
+    Matrix<T> updated(keep + 1, n_);
+    parallelFor(0, n_, [&](size_t col) {
+        for (size_t j = 0; j <= keep; ++j) {
+            T sum = static_cast<T>(0);
+            for (size_t i = 0; i < m; ++i) sum += basis_(i, col) * q[i * m + j];
+            updated(j, col) = sum;
+        }
+    }, KRYLOV_VECTOR_GRAIN);
+
+    const T residualScale = hessenberg_(m, m - 1) * q[(m - 1) * m + keep - 1];
+    const T* last = basis_.getRowData(m);
+    T* f = updated.getRowData(keep);
+    for (size_t i = 0; i < n_; ++i) f[i] = f[i] * h[keep * m + keep - 1] + last[i] * residualScale;
+
+    for (size_t j = 0; j < keep; ++j) std::copy(updated.getRowData(j), updated.getRowData(j) + n_, basis_.getRowData(j));
+
+    for (size_t i = 0; i <= m; ++i)
+        for (size_t j = 0; j < m; ++j) hessenberg_(i, j) = (i < m && j < keep) ? h[i * m + j] : static_cast<T>(0);
+
+    T* next = basis_.getRowData(keep);
+    std::copy(f, f + n_, next);
+    std::vector<T> coeffs;
+    orthogonalize(next, keep, coeffs);
+
+    T beta = std::sqrt(dot(next, next));
+    if (beta == static_cast<T>(0)) {
+        fillRandom(next);
+        orthogonalize(next, keep, coeffs);
+        const T norm = std::sqrt(dot(next, next));
+        for (size_t i = 0; i < n_; ++i) next[i] /= norm;
+    } else {
+        for (size_t i = 0; i < n_; ++i) next[i] /= beta;
+    }
+
+    for (size_t i = keep + 1; i < m; ++i) hessenberg_(i, keep - 1) = static_cast<T>(0);
+    hessenberg_(keep, keep - 1) = beta;
+    if (symmetric_) symmetrizeHessenberg();
+}
+
+template <typename T>
+void KrylovEigenSolver<T>::jacobiEigen(std::vector<T>& a, size_t m, std::vector<T>& vectors) {
+    vectors.assign(m * m, static_cast<T>(0));
+    for (size_t i = 0; i < m; ++i) vectors[i * m + i] = static_cast<T>(1);
+
+    const T eps = std::numeric_limits<T>::epsilon();
+
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        T off = static_cast<T>(0);
+        T total = static_cast<T>(0);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < m; ++j) {
+                total += a[i * m + j] * a[i * m + j];
+                if (i != j) off += a[i * m + j] * a[i * m + j];
+            }
+        if (off == static_cast<T>(0) || off <= eps * eps * total) break;
+
+        for (size_t p = 0; p + 1 < m; ++p) {
+            for (size_t q = p + 1; q < m; ++q) {
+                const T apq = a[p * m + q];
+                if (std::abs(apq) <= eps * (std::abs(a[p * m + p]) + std::abs(a[q * m + q]))) {
+                    a[p * m + q] = a[q * m + p] = static_cast<T>(0);
+                    continue;
+                }
+
+                const T theta = (a[q * m + q] - a[p * m + p]) / (2 * apq);
+                const T t = (theta >= 0 ? static_cast<T>(1) : static_cast<T>(-1)) /
+                            (std::abs(theta) + std::sqrt(theta * theta + 1));
+                const T c = 1 / std::sqrt(t * t + 1);
+                const T s = t * c;
+
+                for (size_t k = 0; k < m; ++k) {
+                    const T akp = a[k * m + p];
+                    const T akq = a[k * m + q];
+                    a[k * m + p] = c * akp - s * akq;
+                    a[k * m + q] = s * akp + c * akq;
+                }
+                for (size_t k = 0; k < m; ++k) {
+                    const T apk = a[p * m + k];
+                    const T aqk = a[q * m + k];
+                    a[p * m + k] = c * apk - s * aqk;
+                    a[q * m + k] = s * apk + c * aqk;
+                }
+                for (size_t k = 0; k < m; ++k) {
+                    const T vkp = vectors[k * m + p];
+                    const T vkq = vectors[k * m + q];
+                    vectors[k * m + p] = c * vkp - s * vkq;
+                    vectors[k * m + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+std::vector<std::complex<T>> KrylovEigenSolver<T>::hessenbergEigenvalues(const std::vector<T>& h, size_t m) {
+    std::vector<Complex> a(h.begin(), h.end());
+    std::vector<Complex> eigenvalues;
+    std::vector<T> cs(m);
+    std::vector<Complex> sn(m);
+    const T eps = std::numeric_limits<T>::epsilon();
+
+    size_t hi = m - 1;
+    size_t iterations = 0;
+
+    while (true) {
+        if (hi == 0) {
+            eigenvalues.push_back(a[0]);
+            break;
+        }
+
+        size_t lo = hi;
+        while (lo > 0) {
+            if (std::abs(a[lo * m + lo - 1]) <= eps * (std::abs(a[(lo - 1) * m + lo - 1]) + std::abs(a[lo * m + lo]))) {
+                a[lo * m + lo - 1] = Complex(0);
+                break;
+            }
+            --lo;
+        }
+
+        if (lo == hi || iterations > 100 * m) {
+            eigenvalues.push_back(a[hi * m + hi]);
+            --hi;
+            iterations = 0;
+            continue;
+        }
+        ++iterations;
+
+        const Complex p = a[(hi - 1) * m + hi - 1];
+        const Complex q = a[(hi - 1) * m + hi];
+        const Complex r = a[hi * m + hi - 1];
+        const Complex d = a[hi * m + hi];
+        const Complex half = (p + d) / static_cast<T>(2);
+        const Complex disc = std::sqrt(half * half - (p * d - q * r));
+        Complex mu = std::abs(half + disc - d) < std::abs(half - disc - d) ? half + disc : half - disc;
+        if (iterations % 11 == 10) mu = d + std::abs(r);
+
+        for (size_t i = lo; i <= hi; ++i) a[i * m + i] -= mu;
+
+        for (size_t j = lo; j < hi; ++j) {
+            const Complex x = a[j * m + j];
+            const Complex y = a[(j + 1) * m + j];
+            const T norm = std::sqrt(std::norm(x) + std::norm(y));
+
+            if (norm == static_cast<T>(0)) {
+                cs[j] = static_cast<T>(1);
+                sn[j] = Complex(0);
+                continue;
+            }
+            if (std::abs(x) == static_cast<T>(0)) {
+                cs[j] = static_cast<T>(0);
+                sn[j] = Complex(1);
+            } else {
+                cs[j] = std::abs(x) / norm;
+                sn[j] = (x / std::abs(x)) * std::conj(y) / norm;
+            }
+
+            for (size_t k = j; k <= hi; ++k) {
+                const Complex top = a[j * m + k];
+                const Complex bottom = a[(j + 1) * m + k];
+                a[j * m + k] = cs[j] * top + sn[j] * bottom;
+                a[(j + 1) * m + k] = -std::conj(sn[j]) * top + cs[j] * bottom;
+            }
+        }
+
+        for (size_t j = lo; j < hi; ++j) {
+            for (size_t k = lo; k <= std::min(j + 2, hi); ++k) {
+                const Complex left = a[k * m + j];
+                const Complex right = a[k * m + j + 1];
+                a[k * m + j] = left * cs[j] + right * std::conj(sn[j]);
+                a[k * m + j + 1] = -left * sn[j] + right * cs[j];
+            }
+        }
+
+        for (size_t i = lo; i <= hi; ++i) a[i * m + i] += mu;
+    }
+
+    return eigenvalues;
+}
+
+template <typename T>
+std::vector<std::complex<T>> KrylovEigenSolver<T>::hessenbergEigenvector(const std::vector<T>& h, size_t m, const Complex& lambda) {
+    T scale = static_cast<T>(0);
+    for (T value : h) scale = std::max(scale, std::abs(value));
+    const T delta = std::numeric_limits<T>::epsilon() * std::max(scale, static_cast<T>(1));
+
+    std::vector<Complex> lu(m * m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j) lu[i * m + j] = Complex(h[i * m + j]) - (i == j ? lambda + delta : Complex(0));
+
+    std::vector<size_t> pivot(m);
+    for (size_t k = 0; k < m; ++k) {
+        size_t best = k;
+        for (size_t i = k + 1; i < m; ++i)
+            if (std::abs(lu[i * m + k]) > std::abs(lu[best * m + k])) best = i;
+        pivot[k] = best;
+        if (best != k)
+            for (size_t j = 0; j < m; ++j) std::swap(lu[k * m + j], lu[best * m + j]);
+
+        if (std::abs(lu[k * m + k]) < delta) lu[k * m + k] = Complex(delta);
+
+        for (size_t i = k + 1; i < m; ++i) {
+            lu[i * m + k] /= lu[k * m + k];
+            for (size_t j = k + 1; j < m; ++j) lu[i * m + j] -= lu[i * m + k] * lu[k * m + j];
+        }
+    }
+
+    std::vector<Complex> y(m, Complex(1));
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        for (size_t k = 0; k < m; ++k) std::swap(y[k], y[pivot[k]]);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < i; ++j) y[i] -= lu[i * m + j] * y[j];
+        for (size_t i = m; i-- > 0;) {
+            for (size_t j = i + 1; j < m; ++j) y[i] -= lu[i * m + j] * y[j];
+            y[i] /= lu[i * m + i];
+        }
+
+        T norm = static_cast<T>(0);
+        for (const Complex& value : y) norm += std::norm(value);
+        norm = std::sqrt(norm);
+        for (Complex& value : y) value /= norm;
+    }
+
+    return y;
+}
+
+template <typename T>
+template <typename Result>
+void KrylovEigenSolver<T>::run(Result& result) {
+    const size_t m = krylovDim_;
+    const T eps = std::numeric_limits<T>::epsilon();
+
+    basis_ = Matrix<T>(m + 1, n_);
+    hessenberg_ = Matrix<T>(m + 1, m);
+
+    T* start = basis_.getRowData(0);
+    fillRandom(start);
+    const T norm = std::sqrt(dot(start, start));
+    for (size_t i = 0; i < n_; ++i) start[i] /= norm;
+
+    extendFactorization(0);
+
+    std::vector<size_t> order(m);
+    std::vector<Complex> theta;
+    std::vector<T> ritzVectors;
+    std::vector<std::vector<Complex>> wanted(count_);
+
+    result.converged = false;
+    for (result.restarts = 0;; ++result.restarts) {
+        std::vector<T> h = leadingHessenberg();
+        const T beta = std::abs(hessenberg_(m, m - 1));
+
+        if (symmetric_) {
+            jacobiEigen(h, m, ritzVectors);
+            theta.assign(m, Complex(0));
+            for (size_t i = 0; i < m; ++i) theta[i] = Complex(h[i * m + i]);
+        } else {
+            theta = hessenbergEigenvalues(h, m);
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return precedes(theta[a], theta[b]); });
+
+        if (!symmetric_) h = leadingHessenberg();
+
+        bool converged = true;
+        for (size_t i = 0; i < count_; ++i) {
+            if (symmetric_) {
+                wanted[i].assign(m, Complex(0));
+                for (size_t j = 0; j < m; ++j) wanted[i][j] = Complex(ritzVectors[j * m + order[i]]);
+            } else {
+                wanted[i] = hessenbergEigenvector(h, m, theta[order[i]]);
+            }
+
+            const T residual = beta * std::abs(wanted[i][m - 1]);
+            if (residual > tolerance_ * std::max(std::abs(theta[order[i]]), std::pow(eps, static_cast<T>(2) / 3)))
+                converged = false;
+        }
+
+        if (converged || m == n_) {
+            result.converged = true;
+            break;
+        }
+        if (result.restarts >= maxRestarts_) break;
+
+        size_t keep = count_;
+        if (!symmetric_ && std::abs(theta[order[keep - 1]].imag()) > 0 &&
+            std::abs(theta[order[keep]] - std::conj(theta[order[keep - 1]])) <= std::sqrt(eps) * std::abs(theta[order[keep - 1]]) &&
+            keep + 1 < m)
+            ++keep;
+
+        std::vector<Complex> shifts;
+        for (size_t i = keep; i < m; ++i) shifts.push_back(theta[order[i]]);
+
+        applyShifts(shifts, keep);
+        extendFactorization(keep);
+    }
+
+    result.values.clear();
+    for (size_t i = 0; i < count_; ++i) {
+        if constexpr (std::is_same<Result, SymmetricEigenResult<T>>::value) result.values.push_back(theta[order[i]].real());
+        else result.values.push_back(theta[order[i]]);
+    }
+
+    if constexpr (std::is_same<Result, SymmetricEigenResult<T>>::value) {
+        result.vectors = Matrix<T>(n_, count_);
+        parallelFor(0, n_, [&](size_t row) {
+            T* out = result.vectors.getRowData(row);
+            for (size_t i = 0; i < count_; ++i) {
+                T sum = static_cast<T>(0);
+                for (size_t j = 0; j < m; ++j) sum += basis_(j, row) * wanted[i][j].real();
+                out[i] = sum;
+            }
+        }, KRYLOV_VECTOR_GRAIN);
+    } else {
+        result.vectors.assign(count_, std::vector<Complex>(n_));
+        parallelFor(0, n_, [&](size_t row) {
+            for (size_t i = 0; i < count_; ++i) {
+                Complex sum(0);
+                for (size_t j = 0; j < m; ++j) sum += basis_(j, row) * wanted[i][j];
+                result.vectors[i][row] = sum;
+            }
+        }, KRYLOV_VECTOR_GRAIN);
+    }
+
+    basis_ = Matrix<T>(0, 0);
+    hessenberg_ = Matrix<T>(0, 0);
+}
+
+template <typename T>
+SymmetricEigenResult<T> KrylovEigenSolver<T>::solveSymmetric() {
+    symmetric_ = true;
+    SymmetricEigenResult<T> result{ {}, Matrix<T>(0, 0), 0, false };
+    run(result);
+
+    return result;
+}
+
+template <typename T>
+EigenResult<T> KrylovEigenSolver<T>::solveGeneral() {
+    symmetric_ = false;
+    EigenResult<T> result{ {}, {}, 0, false };
+    run(result);
+
+    return result;
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,187 @@
+/**
+ * @file matrix_market.hpp
+ * @brief Чтение разреженных матриц в координатном формате Matrix Market.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "sparse_matrix.hpp"
+#include "symmetric_sparse_matrix.hpp"
+
+namespace matrix_lib {
+
+/**
+ * @brief Описание файла Matrix Market из заголовка и строки размеров.
+ */
+struct MatrixMarketHeader {
+    bool pattern;    ///< Значения не хранятся (все элементы равны 1).
+    bool symmetric;  ///< Записан только нижний треугольник симметричной матрицы.
+    size_t rows;     ///< Количество строк.
+    size_t cols;     ///< Количество столбцов.
+    size_t entries;  ///< Количество записей в файле.
+};
+
+/**
+ * @brief Прочитать заголовок и строку размеров файла Matrix Market.
+ *
+ * Поддерживается формат coordinate с полями real, integer и pattern и симметрией general
+ * или symmetric.
+ *
+ * @param in Входной поток, установленный на начало файла.
+ * @return Описание файла.
+ * @throw std::invalid_argument Если заголовок некорректен или формат не поддерживается.
+ */
+inline MatrixMarketHeader readMatrixMarketHeader(std::istream& in) {
+    std::string line;
+    if (!std::getline(in, line))
+        throw std::invalid_argument("Missing Matrix Market header");
+
+    std::transform(line.begin(), line.end(), line.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    std::istringstream banner(line);
+    std::string magic, object, format, field, symmetry;
+    banner >> magic >> object >> format >> field >> symmetry;
+
+    if (magic != "%%matrixmarket" || object != "matrix" || format != "coordinate")
+        throw std::invalid_argument("Unsupported Matrix Market format");
+
+    if (field != "real" && field != "integer" && field != "pattern")
+        throw std::invalid_argument("Unsupported Matrix Market field");
+
+    if (symmetry != "general" && symmetry != "symmetric")
+        throw std::invalid_argument("Unsupported Matrix Market symmetry");
+
+    MatrixMarketHeader header{ field == "pattern", symmetry == "symmetric", 0, 0, 0 };
+
+    while (std::getline(in, line))
+        if (!line.empty() && line[0] != '%') break;
+
+    std::istringstream sizes(line);
+    if (!(sizes >> header.rows >> header.cols >> header.entries))
+        throw std::invalid_argument("Invalid Matrix Market size line");
+
+    if (header.symmetric && header.rows != header.cols)
+        throw std::invalid_argument("Symmetric Matrix Market matrix must be square");
+
+    return header;
+}
+
+/**
+ * @brief Прочитать записи файла Matrix Market (индексы переводятся в нумерацию с нуля).
+ * @tparam T Тип элементов.
+ * @tparam Emit Тип вызываемого объекта `void(size_t row, size_t col, T value)`.
+ * @param in Входной поток после заголовка.
+ * @param header Описание файла.
+ * @param emit Обработчик записи.
+ * @throw std::invalid_argument Если запись некорректна или индекс вне матрицы.
+ */
+template <typename T, typename Emit>
+void readMatrixMarketEntries(std::istream& in, const MatrixMarketHeader& header, Emit&& emit) {
+    for (size_t k = 0; k < header.entries; ++k) {
+        size_t row = 0;
+        size_t col = 0;
+        T value = static_cast<T>(1);
+
+        if (!(in >> row >> col) || (!header.pattern && !(in >> value)))
+            throw std::invalid_argument("Invalid Matrix Market entry");
+
+        if (row == 0 || col == 0 || row > header.rows || col > header.cols)
+            throw std::invalid_argument("Matrix Market entry is out of range");
+
+        emit(row - 1, col - 1, value);
+    }
+}
+
+/**
+ * @brief Загрузить файл Matrix Market в SparseMatrix (симметричный файл разворачивается).
+ * @tparam T Тип элементов.
+ * @param in Входной поток.
+ * @return Разреженная матрица.
+ * @throw std::invalid_argument Если файл некорректен.
+ */
+template <typename T>
+SparseMatrix<T> readMatrixMarketSparseMatrix(std::istream& in) {
+    const MatrixMarketHeader header = readMatrixMarketHeader(in);
+    SparseMatrix<T> result(header.rows, header.cols);
+
+    readMatrixMarketEntries<T>(in, header, [&](size_t row, size_t col, T value) {
+        result.addValue(row, col, value);
+        if (header.symmetric && row != col) result.addValue(col, row, value);
+    });
+
+    return result;
+}
+
+/**
+ * @brief Загрузить симметричный файл Matrix Market сразу в SymmetricSparseMatrix.
+ *
+ * Записанный в файле треугольник сохраняется без разворачивания.
+ *
+ * @tparam T Тип элементов.
+ * @param in Входной поток.
+ * @return Симметричная разреженная матрица.
+ * @throw std::invalid_argument Если файл некорректен или не помечен как symmetric.
+ */
+template <typename T>
+SymmetricSparseMatrix<T> readMatrixMarketSymmetricSparseMatrix(std::istream& in) {
+    const MatrixMarketHeader header = readMatrixMarketHeader(in);
+    if (!header.symmetric)
+        throw std::invalid_argument("Matrix Market file is not symmetric");
+
+    std::vector<size_t> rows, cols;
+    std::vector<T> values;
+    rows.reserve(header.entries);
+    cols.reserve(header.entries);
+    values.reserve(header.entries);
+
+    readMatrixMarketEntries<T>(in, header, [&](size_t row, size_t col, T value) {
+        rows.push_back(row);
+        cols.push_back(col);
+        values.push_back(value);
+    });
+
+    return SymmetricSparseMatrix<T>(header.rows, rows, cols, values);
+}
+
+/**
+ * @brief Загрузить файл Matrix Market в SparseMatrix.
+ * @tparam T Тип элементов.
+ * @param path Путь к файлу.
+ * @return Разреженная матрица.
+ * @throw std::runtime_error Если файл не удается открыть.
+ * @throw std::invalid_argument Если файл некорректен.
+ */
+template <typename T>
+SparseMatrix<T> readMatrixMarketSparseMatrix(const std::string& path) {
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Cannot open file: " + path);
+
+    return readMatrixMarketSparseMatrix<T>(in);
+}
+
+/**
+ * @brief Загрузить симметричный файл Matrix Market в SymmetricSparseMatrix.
+ * @tparam T Тип элементов.
+ * @param path Путь к файлу.
+ * @return Симметричная разреженная матрица.
+ * @throw std::runtime_error Если файл не удается открыть.
+ * @throw std::invalid_argument Если файл некорректен или не помечен как symmetric.
+ */
+template <typename T>
+SymmetricSparseMatrix<T> readMatrixMarketSymmetricSparseMatrix(const std::string& path) {
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Cannot open file: " + path);
+
+    return readMatrixMarketSymmetricSparseMatrix<T>(in);
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,377 @@
+/**
+ * @file pattern_matrix.hpp
+ * @brief Разреженная матрица без значений (только структура) для графовых алгоритмов.
+ */
+
+#pragma once
+
+#include <limits>
+
+#include "sparse_matrix.hpp"
+
+#define PATTERN_BFS_PULL_DIVISOR 20
+
+namespace matrix_lib {
+
+/**
+ * @brief Структура разреженной матрицы без значений: CSR из смещений строк и индексов столбцов.
+ *
+ * Каждый хранимый элемент считается равным 1, поэтому все операции выполняются в булевом
+ * полукольце (or, and) и не читают массив значений. Строка i задает исходящие ребра вершины i.
+ * Векторы-маски хранятся как std::vector<char> (0 или 1), чтобы потоки могли писать
+ * соседние элементы независимо.
+ */
+class PatternMatrix {
+private:
+    size_t rows_;                  ///< Количество строк.
+    size_t cols_;                  ///< Количество столбцов.
+    std::vector<size_t> rowPtr_;   ///< Смещения начала строк (размер rows + 1).
+    std::vector<size_t> colIdx_;   ///< Упорядоченные индексы столбцов без повторов.
+
+public:
+    /**
+     * @brief Конструктор пустой структуры.
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     */
+    PatternMatrix(size_t rows, size_t cols);
+
+    /**
+     * @brief Конструктор из списка позиций (повторы удаляются).
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param rowIndexes Индексы строк.
+     * @param colIndexes Индексы столбцов.
+     * @throw std::invalid_argument Если размеры векторов не совпадают.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    PatternMatrix(size_t rows, size_t cols, const std::vector<size_t>& rowIndexes, const std::vector<size_t>& colIndexes);
+
+    /**
+     * @brief Структура ненулевых элементов разреженной матрицы.
+     * @tparam T Тип элементов исходной матрицы.
+     * @param matrix Исходная матрица.
+     */
+    template <typename T>
+    explicit PatternMatrix(const SparseMatrix<T>& matrix);
+
+    /**
+     * @brief Возвращает количество строк.
+     * @return Количество строк.
+     */
+    size_t getRows() const noexcept { return rows_; }
+
+    /**
+     * @brief Возвращает количество столбцов.
+     * @return Количество столбцов.
+     */
+    size_t getCols() const noexcept { return cols_; }
+
+    /**
+     * @brief Количество хранимых позиций.
+     * @return Количество элементов.
+     */
+    size_t getNonZeroCount() const noexcept { return colIdx_.size(); }
+
+    /**
+     * @brief Есть ли элемент в позиции.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return true, если позиция хранится.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    bool hasValue(const size_t row, const size_t col) const;
+
+    /**
+     * @brief Исходящая степень вершины (количество элементов строки).
+     * @param row Индекс строки.
+     * @return Количество элементов.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    size_t getOutDegree(const size_t row) const;
+
+    /**
+     * @brief Исходящие степени всех вершин.
+     * @return Вектор длины getRows().
+     */
+    std::vector<size_t> outDegreesPatternMatrix() const;
+
+    /**
+     * @brief Входящие степени всех вершин (количество элементов столбцов).
+     * @return Вектор длины getCols().
+     */
+    std::vector<size_t> inDegreesPatternMatrix() const;
+
+    /**
+     * @brief Транспонированная структура.
+     * @return Структура размера getCols() x getRows().
+     */
+    PatternMatrix transposePatternMatrix() const;
+
+    /**
+     * @brief Умножение на булев вектор в полукольце (or, and) с необязательной маской.
+     *
+     * y[i] = !mask[i] && OR_j (A(i, j) && x[j]); проход по строке прекращается на первом совпадении.
+     *
+     * @param vector Вектор длины getCols().
+     * @param mask Исключаемые строки (пустой вектор — без маски).
+     * @return Булев вектор длины getRows().
+     * @throw std::invalid_argument Если размеры векторов не совпадают с матрицей.
+     */
+    std::vector<char> multiplyVectorPatternMatrix(const std::vector<char>& vector, const std::vector<char>& mask = {}) const;
+
+    /**
+     * @brief Произведение структур в полукольце (or, and).
+     * @param other Правый множитель.
+     * @return Структура произведения.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    PatternMatrix multiplyPatternMatrix(const PatternMatrix& other) const;
+
+    /**
+     * @brief Поиск в ширину по исходящим ребрам.
+     *
+     * Фронт хранится списком вершин. Пока он меньше getRows() / PATTERN_BFS_PULL_DIVISOR,
+     * уровень проходит исходящие ребра вершин фронта (push), поэтому весь поиск по графу с
+     * большим диаметром стоит O(nnz). Для большого фронта уровень — маскированное SpMV по
+     * транспонированной структуре (pull), которая строится при первом таком уровне: следующий
+     * фронт состоит из непосещенных вершин, у которых есть входящее ребро из текущего фронта.
+     *
+     * @param source Начальная вершина.
+     * @return Уровень каждой вершины (std::numeric_limits<size_t>::max() для недостижимых).
+     * @throw std::invalid_argument Если матрица не квадратная.
+     * @throw std::out_of_range Если начальная вершина вне матрицы.
+     */
+    std::vector<size_t> breadthFirstSearchPatternMatrix(const size_t source) const;
+
+    /**
+     * @brief Преобразовать в разреженную матрицу со значениями 1.
+     * @tparam T Тип элементов результата.
+     * @return Разреженная матрица.
+     */
+    template <typename T>
+    SparseMatrix<T> toSparseMatrix() const;
+};
+
+inline PatternMatrix::PatternMatrix(size_t rows, size_t cols) : rows_(rows), cols_(cols), rowPtr_(rows + 1, 0) {}
+
+inline PatternMatrix::PatternMatrix(size_t rows, size_t cols, const std::vector<size_t>& rowIndexes,
+                                    const std::vector<size_t>& colIndexes)
+    : rows_(rows), cols_(cols), rowPtr_(rows + 1, 0) {
+    if (rowIndexes.size() != colIndexes.size())
+        throw std::invalid_argument("Index vectors must have the same size");
+
+    for (size_t k = 0; k < rowIndexes.size(); ++k) {
+        if (rowIndexes[k] >= rows_ || colIndexes[k] >= cols_)
+            throw std::out_of_range("Index out of range");
+        ++rowPtr_[rowIndexes[k] + 1];
+    }
+    for (size_t i = 0; i < rows_; ++i) rowPtr_[i + 1] += rowPtr_[i];
+
+    std::vector<size_t> buckets(rowIndexes.size());
+    std::vector<size_t> next(rowPtr_.begin(), rowPtr_.end() - 1);
+    for (size_t k = 0; k < rowIndexes.size(); ++k) buckets[next[rowIndexes[k]]++] = colIndexes[k];
+
+    std::vector<size_t> counts(rows_ + 1, 0);
+    parallelFor(0, rows_, [&](size_t i) {
+        auto first = buckets.begin() + rowPtr_[i];
+        auto last = buckets.begin() + rowPtr_[i + 1];
+        std::sort(first, last);
+        counts[i + 1] = static_cast<size_t>(std::unique(first, last) - first);
+    });
+    for (size_t i = 0; i < rows_; ++i) counts[i + 1] += counts[i];
+
+    colIdx_.resize(counts[rows_]);
+    parallelFor(0, rows_, [&](size_t i) {
+        std::copy(buckets.begin() + rowPtr_[i], buckets.begin() + rowPtr_[i] + (counts[i + 1] - counts[i]),
+                  colIdx_.begin() + counts[i]);
+    });
+
+    rowPtr_.swap(counts);
+}
+
+template <typename T>
+PatternMatrix::PatternMatrix(const SparseMatrix<T>& matrix)
+    : rows_(matrix.getRowsSparseMatrix()), cols_(matrix.getColsSparseMatrix()) {
+    CompressedRows<T> csr = matrix.toCompressedRows();
+    rowPtr_.swap(csr.rowPtr);
+    colIdx_.swap(csr.colIdx);
+}
+
+inline bool PatternMatrix::hasValue(const size_t row, const size_t col) const {
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of range");
+
+    return std::binary_search(colIdx_.begin() + rowPtr_[row], colIdx_.begin() + rowPtr_[row + 1], col);
+}
+
+inline size_t PatternMatrix::getOutDegree(const size_t row) const {
+    if (row >= rows_)
+        throw std::out_of_range("Index out of range");
+
+    return rowPtr_[row + 1] - rowPtr_[row];
+}
+
+inline std::vector<size_t> PatternMatrix::outDegreesPatternMatrix() const {
+    std::vector<size_t> degrees(rows_);
+    parallelFor(0, rows_, [&](size_t i) { degrees[i] = rowPtr_[i + 1] - rowPtr_[i]; });
+
+    return degrees;
+}
+
+inline std::vector<size_t> PatternMatrix::inDegreesPatternMatrix() const {
+    const size_t chunks = parallelChunks(colIdx_.size(), PARALLEL_MIN_GRAIN * PARALLEL_MIN_GRAIN);
+    const size_t chunk = (colIdx_.size() + chunks - 1) / chunks;
+    std::vector<std::vector<size_t>> partial(chunks);
+
+    parallelFor(0, chunks, [&](size_t c) {
+        partial[c].assign(cols_, 0);
+        const size_t to = std::min(colIdx_.size(), (c + 1) * chunk);
+        for (size_t p = c * chunk; p < to; ++p) ++partial[c][colIdx_[p]];
+    }, 1);
+
+    std::vector<size_t> degrees(cols_, 0);
+    parallelFor(0, cols_, [&](size_t j) {
+        for (size_t c = 0; c < chunks; ++c) degrees[j] += partial[c][j];
+    });
+
+    return degrees;
+}
+
+inline PatternMatrix PatternMatrix::transposePatternMatrix() const {
+    PatternMatrix result(cols_, rows_);
+
+    for (size_t col : colIdx_) ++result.rowPtr_[col + 1];
+    for (size_t j = 0; j < cols_; ++j) result.rowPtr_[j + 1] += result.rowPtr_[j];
+
+    result.colIdx_.resize(colIdx_.size());
+    std::vector<size_t> next(result.rowPtr_.begin(), result.rowPtr_.end() - 1);
+    for (size_t i = 0; i < rows_; ++i)
+        for (size_t p = rowPtr_[i]; p < rowPtr_[i + 1]; ++p) result.colIdx_[next[colIdx_[p]]++] = i;
+
+    return result;
+}
+
+inline std::vector<char> PatternMatrix::multiplyVectorPatternMatrix(const std::vector<char>& vector,
+                                                                   const std::vector<char>& mask) const {
+    if (vector.size() != cols_ || (!mask.empty() && mask.size() != rows_))
+        throw std::invalid_argument("Vector size must match the matrix dimensions");
+
+    std::vector<char> result(rows_, 0);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        if (!mask.empty() && mask[i]) return;
+
+        for (size_t p = rowPtr_[i]; p < rowPtr_[i + 1]; ++p)
+            if (vector[colIdx_[p]]) {
+                result[i] = 1;
+                break;
+            }
+    });
+
+    return result;
+}
+
+inline PatternMatrix PatternMatrix::multiplyPatternMatrix(const PatternMatrix& other) const {
+    if (cols_ != other.rows_)
+        throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
+
+    const size_t chunks = parallelChunks(rows_);
+    const size_t chunk = (rows_ + chunks - 1) / chunks;
+    std::vector<std::vector<size_t>> partCols(chunks);
+    std::vector<size_t> counts(rows_ + 1, 0);
+
+    parallelFor(0, chunks, [&](size_t c) {
+        std::vector<size_t> marker(other.cols_, rows_);
+        const size_t to = std::min(rows_, (c + 1) * chunk);
+
+        for (size_t i = c * chunk; i < to; ++i) {
+            const size_t start = partCols[c].size();
+
+            for (size_t p = rowPtr_[i]; p < rowPtr_[i + 1]; ++p) {
+                const size_t k = colIdx_[p];
+                for (size_t q = other.rowPtr_[k]; q < other.rowPtr_[k + 1]; ++q) {
+                    const size_t j = other.colIdx_[q];
+                    if (marker[j] != i) {
+                        marker[j] = i;
+                        partCols[c].push_back(j);
+                    }
+                }
+            }
+
+            std::sort(partCols[c].begin() + start, partCols[c].end());
+            counts[i + 1] = partCols[c].size() - start;
+        }
+    }, 1);
+
+    PatternMatrix result(rows_, other.cols_);
+    for (size_t i = 0; i < rows_; ++i) counts[i + 1] += counts[i];
+    result.rowPtr_ = counts;
+    result.colIdx_.resize(counts[rows_]);
+
+    parallelFor(0, chunks, [&](size_t c) {
+        std::copy(partCols[c].begin(), partCols[c].end(), result.colIdx_.begin() + counts[std::min(rows_, c * chunk)]);
+    }, 1);
+
+    return result;
+}
+
+inline std::vector<size_t> PatternMatrix::breadthFirstSearchPatternMatrix(const size_t source) const {
+    if (rows_ != cols_)
+        throw std::invalid_argument("Matrix must be square");
+
+    if (source >= rows_)
+        throw std::out_of_range("Index out of range");
+
+    PatternMatrix incoming(0, 0);
+    bool transposed = false;
+    std::vector<size_t> levels(rows_, std::numeric_limits<size_t>::max());
+    std::vector<char> visited(rows_, 0);
+    std::vector<size_t> frontier{ source }, next;
+
+    visited[source] = 1;
+    levels[source] = 0;
+
+    for (size_t level = 1; !frontier.empty(); ++level) {
+        next.clear();
+
+        if (frontier.size() * PATTERN_BFS_PULL_DIVISOR < rows_) {
+            for (size_t u : frontier)
+                for (size_t p = rowPtr_[u]; p < rowPtr_[u + 1]; ++p) {
+                    const size_t v = colIdx_[p];
+                    if (visited[v]) continue;
+
+                    visited[v] = 1;
+                    levels[v] = level;
+                    next.push_back(v);
+                }
+        } else {
+            if (!transposed) {
+                incoming = transposePatternMatrix();
+                transposed = true;
+            }
+
+            std::vector<char> dense(rows_, 0);
+            for (size_t u : frontier) dense[u] = 1;
+
+            const std::vector<char> found = incoming.multiplyVectorPatternMatrix(dense, visited);
+            for (size_t v = 0; v < rows_; ++v)
+                if (found[v]) {
+                    visited[v] = 1;
+                    levels[v] = level;
+                    next.push_back(v);
+                }
+        }
+
+        frontier.swap(next);
+    }
+
+    return levels;
+}
+
+template <typename T>
+SparseMatrix<T> PatternMatrix::toSparseMatrix() const {
+    return SparseMatrix<T>(rows_, cols_, CompressedRows<T>{ rowPtr_, colIdx_, std::vector<T>(colIdx_.size(), static_cast<T>(1)) });
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,84 @@
+/**
+ * @file semiring.hpp
+ * @brief Полукольца для обобщенных разреженных ядер (в стиле GraphBLAS).
+ *
+ * Полукольцо задается структурой со статическими функциями `zero()`, `add(a, b)` и
+ * `multiply(a, b)`. Ядра SparseMatrix параметризуются полукольцом как шаблонным аргументом,
+ * поэтому для каждого полукольца компилируется отдельное ядро без виртуальных вызовов.
+ * Пользовательское полукольцо достаточно описать структурой с теми же функциями.
+ *
+ * Отсутствующий элемент матрицы всегда трактуется как `zero()` полукольца. Ядра над
+ * полукольцом отбрасывают результаты, равные `zero()`, и хранят `T(0)` как обычное значение,
+ * если `zero() != T(0)` (например, путь длины 0 в MinPlus). addValue() и конструктор из
+ * CompressedRows по-прежнему не хранят `T(0)`, поэтому нулевые веса во входных матрицах таких
+ * полуколец задавать нельзя.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+namespace matrix_lib {
+
+/**
+ * @brief Обычное полукольцо (+, ×).
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct PlusTimes {
+    static constexpr T zero() noexcept { return static_cast<T>(0); }
+    static constexpr T add(const T a, const T b) noexcept { return a + b; }
+    static constexpr T multiply(const T a, const T b) noexcept { return a * b; }
+};
+
+/**
+ * @brief Тропическое полукольцо (min, +) для поиска кратчайших путей.
+ *
+ * Нулем полукольца служит максимальное значение типа (или бесконечность),
+ * умножение с нулем дает ноль, поэтому переполнение не возникает.
+ *
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct MinPlus {
+    static constexpr T zero() noexcept {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::max();
+    }
+    static constexpr T add(const T a, const T b) noexcept { return std::min(a, b); }
+    static constexpr T multiply(const T a, const T b) noexcept {
+        return (a == zero() || b == zero()) ? zero() : a + b;
+    }
+};
+
+/**
+ * @brief Полукольцо (max, ×) над неотрицательными значениями (наиболее надежный путь).
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct MaxTimes {
+    static constexpr T zero() noexcept { return static_cast<T>(0); }
+    static constexpr T add(const T a, const T b) noexcept { return std::max(a, b); }
+    static constexpr T multiply(const T a, const T b) noexcept { return a * b; }
+};
+
+/**
+ * @brief Булево полукольцо (or, and) для обхода в ширину и достижимости.
+ *
+ * Любое ненулевое значение считается истиной, результат равен 0 или 1.
+ *
+ * @tparam T Тип элементов.
+ */
+template <typename T>
+struct OrAnd {
+    static constexpr T zero() noexcept { return static_cast<T>(0); }
+    static constexpr T add(const T a, const T b) noexcept {
+        return (a != zero() || b != zero()) ? static_cast<T>(1) : zero();
+    }
+    static constexpr T multiply(const T a, const T b) noexcept {
+        return (a != zero() && b != zero()) ? static_cast<T>(1) : zero();
+    }
+};
+
+} // namespace matrix_lib
@@ -6,8 +6,29 @@
 #include <utility>
 #include <algorithm>
 
+#include "../matrix/matrix.hpp"
+#include "../parallel/parallel_for.hpp"
+#include "semiring.hpp"
+
+#define SPMM_COLUMN_BLOCK 8
+
 namespace matrix_lib {
 
+/**
+ * @brief Сжатое построчное (CSR) представление разреженной матрицы.
+ *
+ * Элементы строки `i` занимают диапазон `[rowPtr[i], rowPtr[i + 1])`
+ * массивов `colIdx` и `values` и упорядочены по возрастанию столбца.
+ *
+ * @tparam T Тип элементов матрицы.
+ */
+template <typename T>
+struct CompressedRows {
+    std::vector<size_t> rowPtr;   ///< Смещения начала строк (размер rows + 1)
+    std::vector<size_t> colIdx;   ///< Индексы столбцов ненулевых элементов
+    std::vector<T> values;        ///< Ненулевые значения
+};
+
 /**
  * @brief Класс для представления разреженной матрицы.
  *
@@ -27,6 +48,19 @@ private:
     size_t rows_;                      ///< Количество строк
     size_t cols_;                      ///< Количество столбцов
 
+    template <typename U>
+    friend class SpGemmPlan;
+
+    template <typename U>
+    friend class DiagonalMatrix;
+
+    /**
+     * @brief Сгруппировать элементы по строкам подсчетом (без сортировки по столбцам).
+     * @param rowPtr Смещения начала строк в массиве order (размер rows + 1).
+     * @param order Индексы элементов, упорядоченные по строкам с сохранением порядка добавления.
+     */
+    void bucketByRows(std::vector<size_t>& rowPtr, std::vector<size_t>& order) const;
+
 public:
     /**
      * @brief Конструктор по умолчанию. Создает пустую разреженную матрицу.
@@ -40,6 +74,28 @@ public:
      */
     SparseMatrix(size_t rows, size_t cols) : rows_(rows), cols_(cols) {}
 
+    /**
+     * @brief Конструктор преобразования из плотной матрицы.
+     *
+     * Строки плотной матрицы просматриваются один раз, параллельно по полосам строк;
+     * ненулевые элементы сохраняются в порядке строк и столбцов.
+     *
+     * @param dense Исходная плотная матрица.
+     */
+    explicit SparseMatrix(const Matrix<T>& dense);
+
+    /**
+     * @brief Конструктор из CSR-представления.
+     *
+     * Нулевые значения не сохраняются, как и в addValue().
+     *
+     * @param rows Количество строк.
+     * @param cols Количество столбцов.
+     * @param csr Сжатое построчное представление (rowPtr размера rows + 1).
+     * @throw std::invalid_argument Если rowPtr не соответствует количеству строк.
+     */
+    SparseMatrix(size_t rows, size_t cols, const CompressedRows<T>& csr);
+
     /**
      * @brief Конструктор копирования.
      * @param other Другой объект SparseMatrix для копирования.
@@ -111,6 +167,18 @@ public:
      */
     SparseMatrix operator*(const T scalar) const;
 
+    /**
+     * @brief Оператор умножения разреженной матрицы на плотную (SpMM).
+     *
+     * Строки результата вычисляются параллельно, столбцы плотной матрицы
+     * обрабатываются полосами по SPMM_COLUMN_BLOCK, чтобы накопители оставались в регистрах.
+     *
+     * @param dense Плотная матрица.
+     * @return Плотная матрица-произведение.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    Matrix<T> operator*(const Matrix<T>& dense) const;
+
     /**
      * @brief Оператор присваивания сложения.
      * @param other Другой объект SparseMatrix.
@@ -118,6 +186,62 @@ public:
      */
     SparseMatrix& operator+=(const SparseMatrix& other);
 
+    /**
+     * @brief Умножение на вектор над полукольцом (SpMV).
+     *
+     * y[i] = ⊕_j this(i, j) ⊗ x[j] по хранимым элементам; строки обрабатываются параллельно.
+     *
+     * @tparam Semiring Полукольцо (по умолчанию обычное (+, ×)).
+     * @param vector Вектор длины cols.
+     * @return Вектор длины rows.
+     * @throw std::invalid_argument Если длина вектора не равна количеству столбцов.
+     */
+    template <typename Semiring = PlusTimes<T>>
+    std::vector<T> multiplyVectorSparseMatrix(const std::vector<T>& vector) const;
+
+    /**
+     * @brief Умножение разреженных матриц над полукольцом (SpGEMM).
+     *
+     * Алгоритм Густавсона: строки результата накапливаются в плотном аккумуляторе,
+     * порции строк обрабатываются параллельно, у каждого потока свой аккумулятор.
+     * В результат не попадают элементы, равные Semiring::zero(); значение T(0) при
+     * zero() != T(0) хранится как обычный элемент.
+     *
+     * @tparam Semiring Полукольцо (по умолчанию обычное (+, ×)).
+     * @param other Правый множитель.
+     * @return Произведение, упорядоченное по строкам и столбцам.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    template <typename Semiring = PlusTimes<T>>
+    SparseMatrix multiplySparseMatrix(const SparseMatrix& other) const;
+
+    /**
+     * @brief Маскированное умножение: (this * other) .* mask.
+     *
+     * Произведение вычисляется только в позициях ненулевых элементов маски
+     * (скалярным произведением строки this и столбца other) и умножается на значение маски.
+     * Строки маски обрабатываются параллельно.
+     *
+     * @param other Правый множитель.
+     * @param mask Маска размера rows x other.cols.
+     * @return Разреженная матрица с ненулевыми элементами только в позициях маски.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    SparseMatrix maskedMultiplySparseMatrix(const SparseMatrix& other, const SparseMatrix& mask) const;
+
+    /**
+     * @brief Выборочное произведение плотных матриц (SDDMM): (left * right) .* this.
+     *
+     * Текущая матрица служит маской: скалярные произведения строк left и столбцов right
+     * вычисляются только в позициях ее ненулевых элементов, параллельно по строкам.
+     *
+     * @param left Левая плотная матрица размера rows x k.
+     * @param right Правая плотная матрица размера k x cols.
+     * @return Разреженная матрица с ненулевыми элементами только в позициях маски.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    SparseMatrix sampledDenseProductSparseMatrix(const Matrix<T>& left, const Matrix<T>& right) const;
+
     /**
      * @brief Оператор присваивания вычитания.
      * @param other Другой объект SparseMatrix.
@@ -249,6 +373,33 @@ public:
      */
     std::pair<size_t, size_t> sizeSparseMatrix() const;
 
+    /**
+     * @brief Построить CSR-представление матрицы.
+     *
+     * Элементы упорядочиваются по строкам и столбцам. Для повторно добавленных позиций
+     * сохраняется первое значение, как и в getValue().
+     *
+     * @return Сжатое построчное представление.
+     */
+    CompressedRows<T> toCompressedRows() const;
+
+    /**
+     * @brief Построить CSR-представление и запомнить происхождение элементов.
+     * @param source Для каждой позиции CSR — индекс элемента в порядке добавления.
+     * @return Сжатое построчное представление.
+     */
+    CompressedRows<T> toCompressedRows(std::vector<size_t>& source) const;
+
+    /**
+     * @brief Преобразовать разреженную матрицу в плотную.
+     *
+     * Строки результата заполняются параллельно. Для повторно добавленных позиций
+     * сохраняется первое значение, как и в getValue().
+     *
+     * @return Плотная матрица с теми же значениями.
+     */
+    Matrix<T> toDenseMatrix() const;
+
     /**
      * @brief Вычислить плотность разреженной матрицы.
      * @return Плотность матрицы (отношение ненулевых элементов к общему количеству элементов).
@@ -333,6 +484,75 @@ public:
     SparseMatrix<T> inverseSparseMatrix() const;
 };
 
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const Matrix<T>& dense) : rows_(dense.getRows()), cols_(dense.getCols()) {
+    const size_t chunks = parallelChunks(rows_);
+    const size_t chunkRows = (rows_ + chunks - 1) / chunks;
+
+    std::vector<SparseMatrix> parts(chunks, SparseMatrix(rows_, cols_));
+
+    parallelFor(0, chunks, [&](size_t c) {
+        SparseMatrix& part = parts[c];
+        const size_t to = std::min(rows_, (c + 1) * chunkRows);
+
+        for (size_t i = c * chunkRows; i < to; ++i) {
+            const T* row = dense.getRowData(i);
+            for (size_t j = 0; j < cols_; ++j) {
+                if (row[j] == static_cast<T>(0)) continue;
+
+                part.rowsIndexes.push_back(i);
+                part.colsIndexes.push_back(j);
+                part.values.push_back(row[j]);
+            }
+        }
+    }, 1);
+
+    std::vector<size_t> offsets(chunks + 1, 0);
+    for (size_t c = 0; c < chunks; ++c) offsets[c + 1] = offsets[c] + parts[c].values.size();
+
+    rowsIndexes.resize(offsets[chunks]);
+    colsIndexes.resize(offsets[chunks]);
+    values.resize(offsets[chunks]);
+
+    parallelFor(0, chunks, [&](size_t c) {
+        std::copy(parts[c].rowsIndexes.begin(), parts[c].rowsIndexes.end(), rowsIndexes.begin() + offsets[c]);
+        std::copy(parts[c].colsIndexes.begin(), parts[c].colsIndexes.end(), colsIndexes.begin() + offsets[c]);
+        std::copy(parts[c].values.begin(), parts[c].values.end(), values.begin() + offsets[c]);
+    }, 1);
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(size_t rows, size_t cols, const CompressedRows<T>& csr) : rows_(rows), cols_(cols) {
+    if (csr.rowPtr.size() != rows_ + 1)
+        throw std::invalid_argument("Row pointer size does not match the number of rows");
+
+    rowsIndexes.reserve(csr.values.size());
+    colsIndexes.reserve(csr.values.size());
+    values.reserve(csr.values.size());
+
+    for (size_t i = 0; i < rows_; ++i) {
+        for (size_t p = csr.rowPtr[i]; p < csr.rowPtr[i + 1]; ++p) {
+            if (csr.values[p] == static_cast<T>(0)) continue;
+
+            rowsIndexes.push_back(i);
+            colsIndexes.push_back(csr.colIdx[p]);
+            values.push_back(csr.values[p]);
+        }
+    }
+}
+
+template <typename T>
+void SparseMatrix<T>::bucketByRows(std::vector<size_t>& rowPtr, std::vector<size_t>& order) const {
+    rowPtr.assign(rows_ + 1, 0);
+
+    for (size_t row : rowsIndexes) ++rowPtr[row + 1];
+    for (size_t i = 0; i < rows_; ++i) rowPtr[i + 1] += rowPtr[i];
+
+    order.resize(values.size());
+    std::vector<size_t> next(rowPtr.begin(), rowPtr.end() - 1);
+    for (size_t i = 0; i < values.size(); ++i) order[next[rowsIndexes[i]]++] = i;
+}
+
 template <typename T>
 SparseMatrix<T>& SparseMatrix<T>::operator=(const SparseMatrix& other) {
     if (this != &other) {
@@ -457,23 +677,111 @@ SparseMatrix<T> SparseMatrix<T>::operator-(const SparseMatrix& other) const {
 }
 
 template <typename T>
-SparseMatrix<T> SparseMatrix<T>::operator*(const SparseMatrix& other) const {
-    if (cols_ != other.rows_) 
+inline SparseMatrix<T> SparseMatrix<T>::operator*(const SparseMatrix& other) const {
+    return multiplySparseMatrix<PlusTimes<T>>(other);
+}
+
+/**
+ * @brief Умножение CSR-матрицы на вектор над полукольцом.
+ *
+ * Базовое ядро SpMV, которое можно вызывать повторно без перестроения CSR.
+ * Строки обрабатываются параллельно.
+ *
+ * @tparam Semiring Полукольцо.
+ * @tparam T Тип элементов.
+ * @param a Матрица в CSR-представлении.
+ * @param x Входной вектор (длины не меньше количества столбцов).
+ * @param y Выходной вектор (длины rowPtr.size() - 1).
+ */
+template <typename Semiring, typename T>
+void multiplyVectorCompressedRows(const CompressedRows<T>& a, const T* x, T* y) {
+    parallelFor(0, a.rowPtr.size() - 1, [&](size_t i) {
+        T sum = Semiring::zero();
+        for (size_t p = a.rowPtr[i]; p < a.rowPtr[i + 1]; ++p)
+            sum = Semiring::add(sum, Semiring::multiply(a.values[p], x[a.colIdx[p]]));
+
+        y[i] = sum;
+    });
+}
+
+template <typename T>
+template <typename Semiring>
+std::vector<T> SparseMatrix<T>::multiplyVectorSparseMatrix(const std::vector<T>& vector) const {
+    if (vector.size() != cols_)
+        throw std::invalid_argument("Vector size does not match the number of columns");
+
+    std::vector<T> result(rows_, Semiring::zero());
+    multiplyVectorCompressedRows<Semiring>(toCompressedRows(), vector.data(), result.data());
+
+    return result;
+}
+
+template <typename T>
+template <typename Semiring>
+SparseMatrix<T> SparseMatrix<T>::multiplySparseMatrix(const SparseMatrix& other) const {
+    if (cols_ != other.rows_)
         throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
-    
-    SparseMatrix result(rows_, other.cols_);
 
-    for (size_t i = 0; i < values.size(); ++i) {
-        int row = rowsIndexes[i];
-        T value = values[i];
-
-        for (size_t j = 0; j < other.values.size(); ++j) {
-            if (other.rowsIndexes[j] == colsIndexes[i]) { 
-                int col = other.colsIndexes[j];
-                T product = value * other.values[j];
-                result.addValue(row, col, result.getValue(row, col) + product);
+    const CompressedRows<T> a = toCompressedRows();
+    const CompressedRows<T> b = other.toCompressedRows();
+
+    const size_t chunks = parallelChunks(rows_);
+    const size_t chunkRows = (rows_ + chunks - 1) / chunks;
+    std::vector<CompressedRows<T>> parts(chunks);
+
+    parallelFor(0, chunks, [&](size_t c) {
+        CompressedRows<T>& part = parts[c];
+        std::vector<T> accumulator(other.cols_, Semiring::zero());
+        std::vector<size_t> marker(other.cols_, rows_);
+        std::vector<size_t> touched;
+
+        const size_t from = std::min(rows_, c * chunkRows);
+        const size_t to = std::min(rows_, from + chunkRows);
+        part.rowPtr.push_back(0);
+
+        for (size_t i = from; i < to; ++i) {
+            touched.clear();
+
+            for (size_t p = a.rowPtr[i]; p < a.rowPtr[i + 1]; ++p) {
+                const size_t k = a.colIdx[p];
+                const T left = a.values[p];
+
+                for (size_t q = b.rowPtr[k]; q < b.rowPtr[k + 1]; ++q) {
+                    const size_t j = b.colIdx[q];
+                    const T product = Semiring::multiply(left, b.values[q]);
+
+                    if (marker[j] != i) {
+                        marker[j] = i;
+                        accumulator[j] = product;
+                        touched.push_back(j);
+                    } else {
+                        accumulator[j] = Semiring::add(accumulator[j], product);
+                    }
+                }
             }
+
+            std::sort(touched.begin(), touched.end());
+            for (size_t j : touched) {
+                if (accumulator[j] == Semiring::zero()) continue;
+
+                part.colIdx.push_back(j);
+                part.values.push_back(accumulator[j]);
+            }
+            part.rowPtr.push_back(part.colIdx.size());
         }
+    }, 1);
+
+    // Без конструктора из CompressedRows: он отбрасывает T(0), а для полукольца с
+    // zero() != T(0) (например, MinPlus) это настоящее значение.
+    SparseMatrix result(rows_, other.cols_);
+    size_t row = 0;
+    for (const CompressedRows<T>& part : parts) {
+        for (size_t r = 0; r + 1 < part.rowPtr.size(); ++r, ++row)
+            for (size_t p = part.rowPtr[r]; p < part.rowPtr[r + 1]; ++p) {
+                result.rowsIndexes.push_back(row);
+                result.colsIndexes.push_back(part.colIdx[p]);
+                result.values.push_back(part.values[p]);
+            }
     }
 
     return result;
@@ -488,6 +796,129 @@ inline SparseMatrix<T> SparseMatrix<T>::operator*(const T scalar) const {
     return result;
 }
 
+template <typename T>
+Matrix<T> SparseMatrix<T>::operator*(const Matrix<T>& dense) const {
+    if (cols_ != dense.getRows())
+        throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
+
+    const CompressedRows<T> csr = toCompressedRows();
+    const size_t width = dense.getCols();
+    Matrix<T> result(rows_, width);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        T* out = result.getRowData(i);
+
+        for (size_t j0 = 0; j0 < width; j0 += SPMM_COLUMN_BLOCK) {
+            const size_t jw = std::min<size_t>(SPMM_COLUMN_BLOCK, width - j0);
+            T acc[SPMM_COLUMN_BLOCK] = {};
+
+            for (size_t p = csr.rowPtr[i]; p < csr.rowPtr[i + 1]; ++p) {
+                const T a = csr.values[p];
+                const T* b = dense.getRowData(csr.colIdx[p]) + j0;
+                for (size_t jj = 0; jj < jw; ++jj) acc[jj] += a * b[jj];
+            }
+
+            for (size_t jj = 0; jj < jw; ++jj) out[j0 + jj] = acc[jj];
+        }
+    });
+
+    return result;
+}
+
+/**
+ * @brief Оператор умножения плотной матрицы на разреженную.
+ *
+ * Каждая строка результата собирается независимо как линейная комбинация
+ * строк разреженной матрицы, строки обрабатываются параллельно.
+ *
+ * @tparam T Тип элементов матриц.
+ * @param dense Плотная матрица.
+ * @param sparse Разреженная матрица.
+ * @return Плотная матрица-произведение.
+ * @throw std::invalid_argument Если размеры матриц несовместимы.
+ */
+template <typename T>
+Matrix<T> operator*(const Matrix<T>& dense, const SparseMatrix<T>& sparse) {
+    if (dense.getCols() != sparse.getRowsSparseMatrix())
+        throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
+
+    const CompressedRows<T> csr = sparse.toCompressedRows();
+    const size_t inner = dense.getCols();
+    Matrix<T> result(dense.getRows(), sparse.getColsSparseMatrix());
+
+    parallelFor(0, dense.getRows(), [&](size_t i) {
+        const T* a = dense.getRowData(i);
+        T* out = result.getRowData(i);
+
+        for (size_t k = 0; k < inner; ++k) {
+            const T scale = a[k];
+            if (scale == static_cast<T>(0)) continue;
+
+            for (size_t p = csr.rowPtr[k]; p < csr.rowPtr[k + 1]; ++p)
+                out[csr.colIdx[p]] += scale * csr.values[p];
+        }
+    });
+
+    return result;
+}
+
+template <typename T>
+SparseMatrix<T> SparseMatrix<T>::maskedMultiplySparseMatrix(const SparseMatrix& other, const SparseMatrix& mask) const {
+    if (cols_ != other.rows_ || mask.rows_ != rows_ || mask.cols_ != other.cols_)
+        throw std::invalid_argument("Matrices have incompatible dimensions for masked multiplication");
+
+    const CompressedRows<T> a = toCompressedRows();
+    const CompressedRows<T> bt = other.transposeSparseMatrix().toCompressedRows();
+    CompressedRows<T> c = mask.toCompressedRows();
+
+    parallelFor(0, rows_, [&](size_t i) {
+        for (size_t p = c.rowPtr[i]; p < c.rowPtr[i + 1]; ++p) {
+            const size_t j = c.colIdx[p];
+            size_t x = a.rowPtr[i];
+            size_t y = bt.rowPtr[j];
+            T sum = static_cast<T>(0);
+
+            while (x < a.rowPtr[i + 1] && y < bt.rowPtr[j + 1]) {
+                if (a.colIdx[x] < bt.colIdx[y]) {
+                    ++x;
+                } else if (a.colIdx[x] > bt.colIdx[y]) {
+                    ++y;
+                } else {
+                    sum += a.values[x++] * bt.values[y++];
+                }
+            }
+
+            c.values[p] *= sum;
+        }
+    });
+
+    return SparseMatrix(rows_, other.cols_, c);
+}
+
+template <typename T>
+SparseMatrix<T> SparseMatrix<T>::sampledDenseProductSparseMatrix(const Matrix<T>& left, const Matrix<T>& right) const {
+    if (left.getRows() != rows_ || right.getCols() != cols_ || left.getCols() != right.getRows())
+        throw std::invalid_argument("Matrices have incompatible dimensions for sampled multiplication");
+
+    const size_t inner = left.getCols();
+    const Matrix<T> rightT = right.transposeMatrix();
+    CompressedRows<T> c = toCompressedRows();
+
+    parallelFor(0, rows_, [&](size_t i) {
+        const T* x = left.getRowData(i);
+
+        for (size_t p = c.rowPtr[i]; p < c.rowPtr[i + 1]; ++p) {
+            const T* y = rightT.getRowData(c.colIdx[p]);
+            T sum = static_cast<T>(0);
+            for (size_t k = 0; k < inner; ++k) sum += x[k] * y[k];
+
+            c.values[p] *= sum;
+        }
+    });
+
+    return SparseMatrix(rows_, cols_, c);
+}
+
 template <typename T>
 inline void SparseMatrix<T>::scaleSparseMatrix(T scalar) {
     for (auto& value : values) value *= scalar;
@@ -547,6 +978,63 @@ void SparseMatrix<T>::printSparseMatrix() const {
 template <typename T>
 inline std::pair<size_t, size_t> SparseMatrix<T>::sizeSparseMatrix() const { return { rows_, cols_ }; }
 
+template <typename T>
+inline CompressedRows<T> SparseMatrix<T>::toCompressedRows() const {
+    std::vector<size_t> source;
+    return toCompressedRows(source);
+}
+
+template <typename T>
+CompressedRows<T> SparseMatrix<T>::toCompressedRows(std::vector<size_t>& source) const {
+    CompressedRows<T> csr;
+    std::vector<size_t> order;
+    bucketByRows(csr.rowPtr, order);
+
+    csr.colIdx.reserve(values.size());
+    csr.values.reserve(values.size());
+    source.clear();
+    source.reserve(values.size());
+
+    size_t rowStart = 0;
+    for (size_t i = 0; i < rows_; ++i) {
+        auto first = order.begin() + csr.rowPtr[i];
+        auto last = order.begin() + csr.rowPtr[i + 1];
+        std::stable_sort(first, last, [&](size_t a, size_t b) { return colsIndexes[a] < colsIndexes[b]; });
+
+        csr.rowPtr[i] = rowStart;
+        for (auto it = first; it != last; ++it) {
+            if (it != first && colsIndexes[*it] == colsIndexes[*(it - 1)]) continue;
+
+            csr.colIdx.push_back(colsIndexes[*it]);
+            csr.values.push_back(values[*it]);
+            source.push_back(*it);
+        }
+        rowStart = csr.colIdx.size();
+    }
+    csr.rowPtr[rows_] = rowStart;
+
+    return csr;
+}
+
+template <typename T>
+Matrix<T> SparseMatrix<T>::toDenseMatrix() const {
+    std::vector<size_t> rowPtr;
+    std::vector<size_t> order;
+    bucketByRows(rowPtr, order);
+
+    Matrix<T> result(rows_, cols_);
+
+    parallelFor(0, rows_, [&](size_t i) {
+        T* out = result.getRowData(i);
+        for (size_t p = rowPtr[i + 1]; p > rowPtr[i]; --p) {
+            const size_t k = order[p - 1];
+            out[colsIndexes[k]] = values[k];
+        }
+    });
+
+    return result;
+}
+
 template <typename T>
 double SparseMatrix<T>::densitySparseMatrix() const { return static_cast<double>(values.size()) / (rows_ * cols_); }
 
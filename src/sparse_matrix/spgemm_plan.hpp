@@ -0,0 +1,170 @@
+/**
+ * @file spgemm_plan.hpp
+ * @brief План умножения разреженных матриц с разделением на символьную и численную фазы.
+ */
+
+#pragma once
+
+#include "sparse_matrix.hpp"
+
+namespace matrix_lib {
+
+/**
+ * @brief План SpGEMM для многократного умножения матриц с неизменной структурой.
+ *
+ * Символьная фаза (конструктор) один раз строит структуру произведения A * B и для каждого
+ * элементарного произведения a(i, k) * b(k, j) запоминает позицию в результате. Численная фаза
+ * (multiplyNumeric) только пересчитывает значения в заранее созданную матрицу: без выделения
+ * памяти и без поиска позиций, параллельно по строкам результата.
+ *
+ * Матрицы, передаваемые в численную фазу, должны иметь те же размеры и ту же последовательность
+ * добавленных позиций, что и при построении плана; меняться могут только значения.
+ *
+ * @tparam T Тип элементов матриц.
+ */
+template <typename T>
+class SpGemmPlan {
+private:
+    size_t rows_;                    ///< Количество строк результата.
+    size_t cols_;                    ///< Количество столбцов результата.
+    size_t inner_;                   ///< Общая размерность множителей.
+    size_t nonZerosA_;               ///< Количество элементов A при построении плана.
+    size_t nonZerosB_;               ///< Количество элементов B при построении плана.
+    std::vector<size_t> aRowPtr_;    ///< CSR-смещения строк A.
+    std::vector<size_t> aColIdx_;    ///< CSR-столбцы A.
+    std::vector<size_t> aSource_;    ///< Индекс значения A для каждой позиции CSR.
+    std::vector<size_t> bRowPtr_;    ///< CSR-смещения строк B.
+    std::vector<size_t> bSource_;    ///< Индекс значения B для каждой позиции CSR.
+    std::vector<size_t> cRowPtr_;    ///< CSR-смещения строк результата.
+    std::vector<size_t> cColIdx_;    ///< CSR-столбцы результата.
+    std::vector<size_t> flopPtr_;    ///< Смещения элементарных произведений по строкам.
+    std::vector<size_t> slots_;      ///< Позиция в результате для каждого элементарного произведения.
+
+public:
+    /**
+     * @brief Символьная фаза: построить структуру произведения.
+     * @param a Левый множитель.
+     * @param b Правый множитель.
+     * @throw std::invalid_argument Если размеры матриц несовместимы.
+     */
+    SpGemmPlan(const SparseMatrix<T>& a, const SparseMatrix<T>& b);
+
+    /**
+     * @brief Количество ненулевых позиций результата.
+     * @return Количество позиций.
+     */
+    size_t getNonZeroCount() const noexcept { return cColIdx_.size(); }
+
+    /**
+     * @brief Количество элементарных произведений в численной фазе.
+     * @return Количество умножений-сложений.
+     */
+    size_t getFlopCount() const noexcept { return slots_.size(); }
+
+    /**
+     * @brief Создать матрицу результата со структурой плана и нулевыми значениями.
+     * @return Заранее выделенная матрица результата.
+     */
+    SparseMatrix<T> createResultSparseMatrix() const;
+
+    /**
+     * @brief Численная фаза: пересчитать значения result = a * b.
+     * @param a Левый множитель с той же структурой, что и при построении плана.
+     * @param b Правый множитель с той же структурой, что и при построении плана.
+     * @param result Матрица, созданная createResultSparseMatrix().
+     * @throw std::invalid_argument Если размеры или количество элементов не соответствуют плану.
+     */
+    void multiplyNumeric(const SparseMatrix<T>& a, const SparseMatrix<T>& b, SparseMatrix<T>& result) const;
+};
+
+template <typename T>
+SpGemmPlan<T>::SpGemmPlan(const SparseMatrix<T>& a, const SparseMatrix<T>& b)
+    : rows_(a.rows_), cols_(b.cols_), inner_(a.cols_),
+      nonZerosA_(a.values.size()), nonZerosB_(b.values.size()) {
+    if (a.cols_ != b.rows_)
+        throw std::invalid_argument("Matrices have incompatible dimensions for multiplication");
+
+    const CompressedRows<T> csrA = a.toCompressedRows(aSource_);
+    const CompressedRows<T> csrB = b.toCompressedRows(bSource_);
+    aRowPtr_ = csrA.rowPtr;
+    aColIdx_ = csrA.colIdx;
+    bRowPtr_ = csrB.rowPtr;
+
+    std::vector<size_t> position(cols_, 0);
+    std::vector<size_t> marker(cols_, rows_);
+    std::vector<size_t> touched;
+
+    cRowPtr_.push_back(0);
+    flopPtr_.push_back(0);
+
+    for (size_t i = 0; i < rows_; ++i) {
+        touched.clear();
+
+        for (size_t p = aRowPtr_[i]; p < aRowPtr_[i + 1]; ++p) {
+            const size_t k = aColIdx_[p];
+            for (size_t q = bRowPtr_[k]; q < bRowPtr_[k + 1]; ++q) {
+                const size_t j = csrB.colIdx[q];
+                if (marker[j] != i) {
+                    marker[j] = i;
+                    touched.push_back(j);
+                }
+            }
+        }
+
+        std::sort(touched.begin(), touched.end());
+        for (size_t j : touched) {
+            position[j] = cColIdx_.size();
+            cColIdx_.push_back(j);
+        }
+
+        for (size_t p = aRowPtr_[i]; p < aRowPtr_[i + 1]; ++p) {
+            const size_t k = aColIdx_[p];
+            for (size_t q = bRowPtr_[k]; q < bRowPtr_[k + 1]; ++q) slots_.push_back(position[csrB.colIdx[q]]);
+        }
+
+        cRowPtr_.push_back(cColIdx_.size());
+        flopPtr_.push_back(slots_.size());
+    }
+}
+
+template <typename T>
+SparseMatrix<T> SpGemmPlan<T>::createResultSparseMatrix() const {
+    SparseMatrix<T> result(rows_, cols_);
+
+    result.rowsIndexes.resize(cColIdx_.size());
+    for (size_t i = 0; i < rows_; ++i)
+        std::fill(result.rowsIndexes.begin() + cRowPtr_[i], result.rowsIndexes.begin() + cRowPtr_[i + 1], i);
+
+    result.colsIndexes = cColIdx_;
+    result.values.assign(cColIdx_.size(), static_cast<T>(0));
+
+    return result;
+}
+
+template <typename T>
+void SpGemmPlan<T>::multiplyNumeric(const SparseMatrix<T>& a, const SparseMatrix<T>& b, SparseMatrix<T>& result) const {
+    if (a.rows_ != rows_ || a.cols_ != inner_ || b.rows_ != inner_ || b.cols_ != cols_ ||
+        a.values.size() != nonZerosA_ || b.values.size() != nonZerosB_)
+        throw std::invalid_argument("Matrices do not match the multiplication plan");
+
+    if (result.rows_ != rows_ || result.cols_ != cols_ || result.values.size() != cColIdx_.size())
+        throw std::invalid_argument("Result matrix was not created by this multiplication plan");
+
+    const T* valuesA = a.values.data();
+    const T* valuesB = b.values.data();
+    T* out = result.values.data();
+
+    parallelFor(0, rows_, [&](size_t i) {
+        std::fill(out + cRowPtr_[i], out + cRowPtr_[i + 1], static_cast<T>(0));
+
+        const size_t* slot = slots_.data() + flopPtr_[i];
+        for (size_t p = aRowPtr_[i]; p < aRowPtr_[i + 1]; ++p) {
+            const T left = valuesA[aSource_[p]];
+            const size_t k = aColIdx_[p];
+
+            for (size_t q = bRowPtr_[k]; q < bRowPtr_[k + 1]; ++q) out[*slot++] += left * valuesB[bSource_[q]];
+        }
+    });
+}
+
+} // namespace matrix_lib
@@ -0,0 +1,265 @@
+/**
+ * @file symmetric_sparse_matrix.hpp
+ * @brief Симметричная разреженная матрица с хранением только верхнего треугольника.
+ */
+
+#pragma once
+
+#include "sparse_matrix.hpp"
+
+#define SYMMETRIC_SPMV_GRAIN 4096
+
+namespace matrix_lib {
+
+/**
+ * @brief Симметричная разреженная матрица: хранится верхний треугольник в CSR.
+ *
+ * Элемент a(i, j) при i <= j хранится один раз и обслуживает обе позиции (i, j) и (j, i),
+ * что вдвое сокращает память и объем чтения при SpMV.
+ *
+ * @tparam T Тип элементов матрицы.
+ */
+template <typename T>
+class SymmetricSparseMatrix {
+private:
+    size_t size_;              ///< Порядок матрицы.
+    CompressedRows<T> upper_;  ///< Верхний треугольник (столбец >= строки), столбцы в строке упорядочены.
+
+public:
+    /**
+     * @brief Конструктор нулевой матрицы.
+     * @param size Порядок матрицы.
+     */
+    explicit SymmetricSparseMatrix(size_t size);
+
+    /**
+     * @brief Конструктор из элементов одного треугольника.
+     *
+     * Позиции (i, j) и (j, i) считаются одной позицией; при повторе используется первое значение.
+     *
+     * @param size Порядок матрицы.
+     * @param rows Индексы строк.
+     * @param cols Индексы столбцов.
+     * @param values Значения.
+     * @throw std::invalid_argument Если размеры векторов не совпадают.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    SymmetricSparseMatrix(size_t size, const std::vector<size_t>& rows, const std::vector<size_t>& cols,
+                          const std::vector<T>& values);
+
+    /**
+     * @brief Конструктор из симметричной разреженной матрицы.
+     * @param matrix Исходная матрица (повторы разрешаются как в getValue()).
+     * @throw std::invalid_argument Если матрица не квадратная или не симметричная.
+     */
+    explicit SymmetricSparseMatrix(const SparseMatrix<T>& matrix);
+
+    /**
+     * @brief Возвращает порядок матрицы.
+     * @return Количество строк (и столбцов).
+     */
+    size_t getSize() const noexcept { return size_; }
+
+    /**
+     * @brief Количество хранимых элементов верхнего треугольника.
+     * @return Количество элементов.
+     */
+    size_t getStoredCount() const noexcept { return upper_.colIdx.size(); }
+
+    /**
+     * @brief Количество ненулевых элементов полной матрицы.
+     * @return Количество элементов с учетом обоих треугольников.
+     */
+    size_t getNonZeroCount() const;
+
+    /**
+     * @brief Получить значение по индексу.
+     * @param row Индекс строки.
+     * @param col Индекс столбца.
+     * @return Значение в указанной позиции.
+     * @throw std::out_of_range Если индекс выходит за пределы матрицы.
+     */
+    T getValue(const size_t row, const size_t col) const;
+
+    /**
+     * @brief Умножение на вектор за один проход по треугольнику.
+     *
+     * Строки делятся на порции с равным числом элементов. Вклад a(i, j) * x[j] поток записывает
+     * в свои строки, а вклад a(i, j) * x[i] в строки других порций накапливает в собственном
+     * буфере, которые затем параллельно суммируются, поэтому гонок записи нет.
+     *
+     * @param vector Вектор длины getSize().
+     * @return Вектор-произведение.
+     * @throw std::invalid_argument Если размер вектора не совпадает с порядком матрицы.
+     */
+    std::vector<T> multiplyVectorSymmetricSparseMatrix(const std::vector<T>& vector) const;
+
+    /**
+     * @brief Преобразовать в разреженную матрицу с обоими треугольниками.
+     * @return Разреженная матрица.
+     */
+    SparseMatrix<T> toSparseMatrix() const;
+};
+
+template <typename T>
+SymmetricSparseMatrix<T>::SymmetricSparseMatrix(size_t size)
+    : size_(size), upper_{ std::vector<size_t>(size + 1, 0), {}, {} } {}
+
+template <typename T>
+SymmetricSparseMatrix<T>::SymmetricSparseMatrix(size_t size, const std::vector<size_t>& rows,
+                                                const std::vector<size_t>& cols, const std::vector<T>& values)
+    : size_(size) {
+    if (rows.size() != cols.size() || rows.size() != values.size())
+        throw std::invalid_argument("Index and value vectors must have the same size");
+
+    SparseMatrix<T> triangle(size_, size_);
+    for (size_t i = 0; i < rows.size(); ++i)
+        triangle.addValue(std::min(rows[i], cols[i]), std::max(rows[i], cols[i]), values[i]);
+
+    upper_ = triangle.toCompressedRows();
+}
+
+template <typename T>
+SymmetricSparseMatrix<T>::SymmetricSparseMatrix(const SparseMatrix<T>& matrix) : size_(matrix.getRowsSparseMatrix()) {
+    if (!matrix.isSquareSparseMatrix())
+        throw std::invalid_argument("Matrix must be square");
+
+    const CompressedRows<T> csr = matrix.toCompressedRows();
+    upper_.rowPtr.assign(size_ + 1, 0);
+
+    size_t mirrored = 0;
+    for (size_t i = 0; i < size_; ++i) {
+        for (size_t p = csr.rowPtr[i]; p < csr.rowPtr[i + 1]; ++p) {
+            const size_t j = csr.colIdx[p];
+
+            if (j >= i) {
+                upper_.colIdx.push_back(j);
+                upper_.values.push_back(csr.values[p]);
+                if (j > i) ++mirrored;
+                continue;
+            }
+
+            auto first = csr.colIdx.begin() + csr.rowPtr[j];
+            auto last = csr.colIdx.begin() + csr.rowPtr[j + 1];
+            auto it = std::lower_bound(first, last, i);
+            if (it == last || *it != i || csr.values[it - csr.colIdx.begin()] != csr.values[p])
+                throw std::invalid_argument("Matrix is not symmetric");
+
+            --mirrored;
+        }
+        upper_.rowPtr[i + 1] = upper_.colIdx.size();
+    }
+
+    if (mirrored != 0)
+        throw std::invalid_argument("Matrix is not symmetric");
+}
+
+template <typename T>
+size_t SymmetricSparseMatrix<T>::getNonZeroCount() const {
+    size_t diagonal = 0;
+    for (size_t i = 0; i < size_; ++i)
+        if (upper_.rowPtr[i] < upper_.rowPtr[i + 1] && upper_.colIdx[upper_.rowPtr[i]] == i) ++diagonal;
+
+    return 2 * upper_.colIdx.size() - diagonal;
+}
+
+template <typename T>
+T SymmetricSparseMatrix<T>::getValue(const size_t row, const size_t col) const {
+    if (row >= size_ || col >= size_)
+        throw std::out_of_range("Index out of range");
+
+    const size_t i = std::min(row, col);
+    const size_t j = std::max(row, col);
+    auto first = upper_.colIdx.begin() + upper_.rowPtr[i];
+    auto last = upper_.colIdx.begin() + upper_.rowPtr[i + 1];
+    auto it = std::lower_bound(first, last, j);
+
+    return (it != last && *it == j) ? upper_.values[it - upper_.colIdx.begin()] : static_cast<T>(0);
+}
+
+template <typename T>
+std::vector<T> SymmetricSparseMatrix<T>::multiplyVectorSymmetricSparseMatrix(const std::vector<T>& vector) const {
+    if (vector.size() != size_)
+        throw std::invalid_argument("Vector size must match the matrix size");
+
+    const size_t stored = upper_.colIdx.size();
+    const size_t chunks = parallelChunks(stored, SYMMETRIC_SPMV_GRAIN);
+
+    std::vector<size_t> bounds(chunks + 1, size_);
+    bounds[0] = 0;
+    for (size_t c = 1; c < chunks; ++c)
+        bounds[c] = std::lower_bound(upper_.rowPtr.begin(), upper_.rowPtr.end(), c * stored / chunks) - upper_.rowPtr.begin();
+
+    std::vector<T> result(size_, static_cast<T>(0));
+    std::vector<std::vector<T>> spill(chunks);
+    const T* x = vector.data();
+
+    parallelFor(0, chunks, [&](size_t c) {
+        const size_t from = std::min(bounds[c], size_);
+        const size_t to = std::max(from, std::min(bounds[c + 1], size_));
+        spill[c].assign(size_ - to, static_cast<T>(0));
+        T* y = result.data();
+        T* outside = spill[c].data();
+
+        for (size_t i = from; i < to; ++i) {
+            T sum = static_cast<T>(0);
+            const T xi = x[i];
+
+            for (size_t p = upper_.rowPtr[i]; p < upper_.rowPtr[i + 1]; ++p) {
+                const size_t j = upper_.colIdx[p];
+                const T value = upper_.values[p];
+                sum += value * x[j];
+
+                if (j == i) continue;
+                if (j < to) y[j] += value * xi;
+                else outside[j - to] += value * xi;
+            }
+            y[i] += sum;
+        }
+    }, 1);
+
+    parallelFor(0, size_, [&](size_t j) {
+        for (size_t c = 0; c < chunks; ++c) {
+            const size_t to = std::max(std::min(bounds[c], size_), std::min(bounds[c + 1], size_));
+            if (j >= to) result[j] += spill[c][j - to];
+        }
+    }, SYMMETRIC_SPMV_GRAIN);
+
+    return result;
+}
+
+template <typename T>
+SparseMatrix<T> SymmetricSparseMatrix<T>::toSparseMatrix() const {
+    CompressedRows<T> csr;
+    csr.rowPtr.assign(size_ + 1, 0);
+
+    for (size_t i = 0; i < size_; ++i)
+        for (size_t p = upper_.rowPtr[i]; p < upper_.rowPtr[i + 1]; ++p) {
+            ++csr.rowPtr[i + 1];
+            if (upper_.colIdx[p] != i) ++csr.rowPtr[upper_.colIdx[p] + 1];
+        }
+    for (size_t i = 0; i < size_; ++i) csr.rowPtr[i + 1] += csr.rowPtr[i];
+
+    csr.colIdx.resize(csr.rowPtr[size_]);
+    csr.values.resize(csr.rowPtr[size_]);
+    std::vector<size_t> next(csr.rowPtr.begin(), csr.rowPtr.end() - 1);
+
+    for (size_t i = 0; i < size_; ++i)
+        for (size_t p = upper_.rowPtr[i]; p < upper_.rowPtr[i + 1]; ++p) {
+            const size_t j = upper_.colIdx[p];
+            if (j == i) continue;
+
+            csr.colIdx[next[j]] = i;
+            csr.values[next[j]++] = upper_.values[p];
+        }
+
+    for (size_t i = 0; i < size_; ++i)
+        for (size_t p = upper_.rowPtr[i]; p < upper_.rowPtr[i + 1]; ++p) {
+            csr.colIdx[next[i]] = upper_.colIdx[p];
+            csr.values[next[i]++] = upper_.values[p];
+        }
+
+    return SparseMatrix<T>(size_, size_, csr);
+}
+
+} // namespace matrix_lib
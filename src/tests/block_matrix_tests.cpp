@@ -0,0 +1,775 @@
+#include "../block_matrix/block_matrix.hpp"
+#include "../block_matrix/out_of_core_block_matrix.hpp"
+#include "../block_matrix/shared_block_matrix.hpp"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace matrix_lib {
+
+// Плитки лежат в одной выровненной области и доступны по индексу блока
+TEST(BlockMatrixTest, ContiguousAlignedTiles) {
+    BlockMatrix<double> blocks(10, 7, 4, 3);
+    EXPECT_EQ(blocks.getNumBlocksRow(), 3);
+    EXPECT_EQ(blocks.getNumBlocksCol(), 3);
+    EXPECT_EQ(blocks.getBlockCount(), 9);
+
+    for (size_t i = 0; i < blocks.getNumBlocksRow(); ++i)
+        for (size_t j = 0; j < blocks.getNumBlocksCol(); ++j)
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blocks.getBlockData(i, j)) % TILE_ALIGNMENT, 0u);
+
+    const ptrdiff_t stride = blocks.getBlockData(0, 1) - blocks.getBlockData(0, 0);
+    EXPECT_EQ(blocks.getBlockData(1, 0) - blocks.getBlockData(0, 0), 3 * stride);
+
+    blocks.setValue(9, 6, 5.0);
+    EXPECT_EQ(blocks.getBlockData(2, 2)[1 * 3 + 0], 5.0);
+    EXPECT_EQ(blocks.getBlock(2, 2).getRows(), 2);
+    EXPECT_EQ(blocks.getBlock(2, 2).getCols(), 1);
+    EXPECT_THROW(blocks.getBlockData(3, 0), std::out_of_range);
+    EXPECT_THROW(BlockMatrix<double>(4, 4, 0, 2), std::invalid_argument);
+
+    BlockMatrix<double> copy(blocks);
+    EXPECT_EQ(copy, blocks);
+    copy.setValue(0, 0, 1.0);
+    EXPECT_NE(copy, blocks);
+}
+
+// Блочные операции совпадают с операциями над обычной матрицей
+TEST(BlockMatrixTest, MatchesDenseOperations) {
+    Matrix<int> a(7, 5);
+    Matrix<int> b(5, 6);
+    for (size_t i = 0; i < 7; ++i)
+        for (size_t j = 0; j < 5; ++j) a(i, j) = static_cast<int>(i * 5 + j) % 7 - 3;
+    for (size_t i = 0; i < 5; ++i)
+        for (size_t j = 0; j < 6; ++j) b(i, j) = static_cast<int>(i + 2 * j) % 5 - 2;
+
+    BlockMatrix<int> blockA(a, 3, 2);
+    BlockMatrix<int> blockB(b, 2, 4);
+    EXPECT_EQ(blockA.toMatrix(), a);
+    EXPECT_EQ((blockA * blockB).toMatrix(), a * b);
+    EXPECT_EQ((blockA + blockA).toMatrix(), a * 2);
+    int squares = 0;
+    for (size_t i = 0; i < 7; ++i)
+        for (size_t j = 0; j < 5; ++j) squares += a(i, j) * a(i, j);
+    EXPECT_EQ(blockA.dotProduct(blockA), squares);
+    EXPECT_EQ(blockA.findMinElementBlockMatrix(), -3);
+    EXPECT_EQ(blockA.findMaxElementBlockMatrix(), 3);
+    EXPECT_THROW(blockA * blockA, std::invalid_argument);
+
+    Matrix<int> tile(3, 1);
+    tile(0, 0) = 42;
+    tile(1, 0) = 43;
+    tile(2, 0) = 44;
+    blockA.setBlock(1, 2, tile);
+    EXPECT_EQ(blockA.getBlock(1, 2), tile);
+    EXPECT_EQ(blockA.getValue(4, 4), 43);
+
+    const Matrix<int>& constA = a;
+    const Matrix<int> dense = a * constA.transposeMatrix();
+    BlockMatrix<int> square(dense, 3, 3);
+    BlockMatrix<int> squared = square.powBlockMatrix(2);
+    EXPECT_EQ(squared.toMatrix(), dense * dense);
+    EXPECT_TRUE(square.isSymmetric());
+}
+
+// Параллельное умножение по плиткам накапливает произведение в результат
+TEST(BlockMatrixTest, ParallelTiledMultiplyAccumulates) {
+    Matrix<double> a(45, 38);
+    Matrix<double> b(38, 29);
+    for (size_t i = 0; i < 45; ++i)
+        for (size_t j = 0; j < 38; ++j) a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+    for (size_t i = 0; i < 38; ++i)
+        for (size_t j = 0; j < 29; ++j) b(i, j) = static_cast<double>((i * 5 + j) % 9) - 4.0;
+
+    BlockMatrix<double> blockA(a, 10, 9);
+    BlockMatrix<double> blockB(b, 9, 12);
+    Matrix<double> expected = a * b;
+    EXPECT_EQ((blockA * blockB).toMatrix(), expected);
+
+    BlockMatrix<double> accumulated(expected, 10, 12);
+    accumulated.multiplyAddBlockMatrix(blockA, blockB);
+    EXPECT_EQ(accumulated.toMatrix(), expected * 2.0);
+    EXPECT_THROW(accumulated.multiplyAddBlockMatrix(blockB, blockA), std::invalid_argument);
+}
+
+// Размер плиток по умолчанию берется из профиля, замеры сохраняются в профиль
+TEST(BlockMatrixTest, TileShapeFromProfile) {
+    TileAutotuner& tuner = TileAutotuner::instance();
+    const std::string previous = tuner.getProfilePath();
+    const std::string path = testing::TempDir() + "block_matrix_tiles.profile";
+
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "# operation type rows cols\nmultiply i4 5 3\n";
+    }
+    tuner.setProfilePath(path);
+
+    BlockMatrix<int> tuned(20, 10);
+    EXPECT_EQ(tuned.getBlockRows(), 5);
+    EXPECT_EQ(tuned.getBlockCols(), 3);
+
+    BlockMatrix<int> small(Matrix<int>(2, 2));
+    EXPECT_EQ(small.getBlockRows(), 2);
+    EXPECT_EQ(small.getBlockCols(), 2);
+
+    const TileShape calibrated = tuner.calibrate<short>(TileOperation::Multiply, 48);
+    EXPECT_EQ(48 % calibrated.rows, 0u);
+    EXPECT_EQ(48 % calibrated.cols, 0u);
+    EXPECT_THROW(tuner.setTileShape<int>(TileOperation::Multiply, TileShape{ 0, 4 }), std::invalid_argument);
+
+    tuner.setProfilePath(path);
+    EXPECT_EQ(tuner.getTileShape<short>(TileOperation::Multiply).rows, calibrated.rows);
+    EXPECT_EQ(tuner.getTileShape<short>(TileOperation::Multiply).cols, calibrated.cols);
+    EXPECT_EQ(tuner.getTileShape<int>(TileOperation::Multiply).cols, 3);
+
+    tuner.setProfilePath(previous);
+    std::remove(path.c_str());
+}
+
+// Произведение матриц с одинаковыми прямоугольными блоками переразбивает правый множитель
+TEST(BlockMatrixTest, MultiplyRectangularTiles) {
+    Matrix<double> a(10, 9), b(9, 7);
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t j = 0; j < 9; ++j) a(i, j) = static_cast<double>((i * 5 + j * 3) % 7) - 3.0;
+    for (size_t i = 0; i < 9; ++i)
+        for (size_t j = 0; j < 7; ++j) b(i, j) = static_cast<double>((i + 4 * j) % 5);
+
+    const BlockMatrix<double> blockA(a, 5, 3), blockB(b, 5, 3);
+    const BlockMatrix<double> product = blockA * blockB;
+    EXPECT_EQ(product.getBlockRows(), 5);
+    EXPECT_EQ(product.getBlockCols(), 3);
+    EXPECT_EQ(product.toMatrix(), a * b);
+
+    BlockMatrix<double> direct(10, 7, 5, 3);
+    EXPECT_THROW(direct.multiplyAddBlockMatrix(blockA, blockB), std::invalid_argument);
+}
+
+// Блочные LU и Холецкий, выполненные графом задач, восстанавливают исходную матрицу
+TEST(BlockMatrixTest, TiledFactorizations) {
+    const size_t n = 37;
+    Matrix<double> a(n, n);
+    Matrix<double> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            a(i, j) = static_cast<double>((i * 3 + j * 7) % 10) - 4.5 + (i == j ? 4.0 * n : 0.0);
+            m(i, j) = static_cast<double>((i + 2 * j) % 6) - 2.5;
+        }
+
+    BlockMatrix<double> lu(a, 8, 8);
+    lu.factorizeLUBlockMatrix();
+    Matrix<double> lower(n, n), upper(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            if (i > j) lower(i, j) = lu.getValue(i, j);
+            else upper(i, j) = lu.getValue(i, j);
+        }
+    for (size_t i = 0; i < n; ++i) lower(i, i) = 1.0;
+
+    Matrix<double> restored = lower * upper;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) EXPECT_NEAR(restored(i, j), a(i, j), 1e-9);
+
+    const Matrix<double>& constM = m;
+    Matrix<double> spd = m * constM.transposeMatrix();
+    for (size_t i = 0; i < n; ++i) spd(i, i) += static_cast<double>(n);
+
+    BlockMatrix<double> cholesky(spd, 8, 8);
+    cholesky.factorizeCholeskyBlockMatrix();
+    const Matrix<double> factor = cholesky.toMatrix();
+    EXPECT_EQ(factor(0, n - 1), 0.0);
+    Matrix<double> product = factor * factor.transposeMatrix();
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) EXPECT_NEAR(product(i, j), spd(i, j), 1e-9);
+
+    BlockMatrix<double> negative(Matrix<double>(n, n) - spd, 8, 8);
+    EXPECT_THROW(negative.factorizeCholeskyBlockMatrix(), std::domain_error);
+    EXPECT_THROW(BlockMatrix<double>(a, 8, 4).factorizeLUBlockMatrix(), std::invalid_argument);
+}
+
+// Нулевые и единичные блоки не занимают память и пропускаются в операциях
+TEST(BlockMatrixTest, BlockSparseTiles) {
+    const size_t n = 37;
+    Matrix<double> a(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t block = i / 8;
+        for (size_t j = block * 8; j < std::min(n, block * 8 + 8); ++j)
+            a(i, j) = block == 1 ? (i == j ? 1.0 : 0.0) : static_cast<double>((i * 3 + j) % 7) - 3.0;
+    }
+    for (size_t i = 32; i < n; ++i)
+        for (size_t j = 32; j < n; ++j) a(i, j) = i == j ? 1.0 : 0.0;
+
+    BlockMatrix<double> blocks(a, 8, 8);
+    EXPECT_EQ(blocks.getTileKind(0, 1), TileKind::Zero);
+    EXPECT_EQ(blocks.getTileKind(1, 1), TileKind::Identity);
+    EXPECT_EQ(blocks.getTileKind(4, 4), TileKind::Identity);
+    EXPECT_EQ(blocks.getTileKind(2, 2), TileKind::Dense);
+    EXPECT_EQ(blocks.getDenseTileCount(), 3u);
+    EXPECT_EQ(blocks.getBlockData(0, 1) == nullptr, false);
+    blocks.clearBlock(0, 1);
+    EXPECT_EQ(static_cast<const BlockMatrix<double>&>(blocks).getBlockData(0, 1), nullptr);
+
+    const BlockMatrix<double> product = blocks * blocks;
+    EXPECT_EQ(product.toMatrix(), a * a);
+    EXPECT_EQ(product.getDenseTileCount(), 3u);
+    EXPECT_EQ(product.getTileKind(1, 1), TileKind::Identity);
+    EXPECT_EQ(product.getTileKind(3, 0), TileKind::Zero);
+    EXPECT_EQ((blocks + blocks).toMatrix(), a * 2.0);
+    EXPECT_EQ((blocks - blocks).frobeniusNorm(), 0.0);
+    EXPECT_NEAR(blocks.frobeniusNorm(), std::sqrt(a.frobeniusNorm() * a.frobeniusNorm()), 1e-9);
+    EXPECT_NEAR(blocks.dotProduct(blocks), blocks.frobeniusNorm() * blocks.frobeniusNorm(), 1e-9);
+
+    BlockMatrix<double> edited(blocks);
+    edited.setValue(33, 34, 2.0);
+    EXPECT_EQ(edited.getTileKind(4, 4), TileKind::Dense);
+    EXPECT_EQ(edited.getValue(36, 36), 1.0);
+    EXPECT_EQ(edited.getBlockData(4, 4)[5 * 8 + 5], 0.0);
+    edited.setValue(33, 34, 0.0);
+    BlockMatrix<double> difference = edited - blocks;
+    difference.compressBlockMatrix();
+    EXPECT_EQ(difference.getDenseTileCount(), 0u);
+    edited.compressBlockMatrix();
+    EXPECT_EQ(edited.getTileKind(4, 4), TileKind::Identity);
+    EXPECT_EQ(edited, blocks);
+}
+
+// Разреженные и малоранговые блоки хранятся в своих форматах и умножаются без расширения
+TEST(BlockMatrixTest, HeterogeneousTiles) {
+    const size_t n = 20;
+    Matrix<double> a(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) a(i, j) = static_cast<double>((i * 5 + j * 3) % 7) - 3.0;
+
+    Matrix<double> sparse(8, 8);
+    sparse(0, 3) = 2.0;
+    sparse(5, 1) = -1.0;
+    sparse(7, 7) = 4.0;
+
+    Matrix<double> u(8, 2), v(4, 2);
+    for (size_t r = 0; r < 8; ++r) {
+        u(r, 0) = static_cast<double>(r % 3);
+        u(r, 1) = 1.0;
+    }
+    for (size_t r = 0; r < 4; ++r) {
+        v(r, 0) = static_cast<double>(r) - 1.0;
+        v(r, 1) = 2.0;
+    }
+
+    BlockMatrix<double> blocks(a, 8, 8);
+    blocks.setSparseBlock(0, 1, SparseMatrix<double>(sparse));
+    blocks.setLowRankBlock(1, 2, u, v);
+    EXPECT_EQ(blocks.getTileKind(0, 1), TileKind::Sparse);
+    EXPECT_EQ(blocks.getTileKind(1, 2), TileKind::LowRank);
+    EXPECT_THROW(blocks.setLowRankBlock(1, 2, u, u), std::invalid_argument);
+    EXPECT_THROW(blocks.setSparseBlock(0, 2, SparseMatrix<double>(sparse)), std::invalid_argument);
+
+    Matrix<double> expected = a;
+    const Matrix<double>& vRef = v;
+    const Matrix<double> lowRank = u * vRef.transposeMatrix();
+    for (size_t r = 0; r < 8; ++r) {
+        for (size_t c = 0; c < 8; ++c) expected(r, 8 + c) = sparse(r, c);
+        for (size_t c = 0; c < 4; ++c) expected(8 + r, 16 + c) = lowRank(r, c);
+    }
+
+    EXPECT_EQ(blocks.toMatrix(), expected);
+    EXPECT_EQ(blocks.getValue(13, 18), lowRank(5, 2));
+    EXPECT_EQ(blocks.getValue(5, 9), -1.0);
+    EXPECT_EQ(blocks.getBlock(1, 2), lowRank);
+    EXPECT_EQ((blocks * blocks).toMatrix(), expected * expected);
+    EXPECT_EQ((blocks * 2.0).toMatrix(), expected * 2.0);
+    EXPECT_EQ((blocks + blocks).toMatrix(), expected * 2.0);
+    EXPECT_NEAR(blocks.frobeniusNorm(), expected.frobeniusNorm(), 1e-9);
+    BlockMatrix<double> sparseOnly(n, n, 8, 8);
+    sparseOnly.setSparseBlock(0, 1, SparseMatrix<double>(sparse));
+    EXPECT_EQ(sparseOnly.findMaxElementBlockMatrix(), 4.0);
+    EXPECT_EQ(sparseOnly.findMinElementBlockMatrix(), -1.0);
+
+    BlockMatrix<double> transposed(blocks);
+    transposed.transposeBlockMatrix();
+    const Matrix<double>& expectedRef = expected;
+    EXPECT_EQ(transposed.toMatrix(), expectedRef.transposeMatrix());
+    EXPECT_EQ(transposed.getTileKind(2, 1), TileKind::LowRank);
+
+    BlockMatrix<double> dense(expected, 8, 8);
+    dense.compressBlockMatrix();
+    EXPECT_EQ(dense.getTileKind(0, 1), TileKind::Sparse);
+    EXPECT_EQ(dense, blocks);
+    dense.setValue(0, 8, 1.0);
+    EXPECT_EQ(dense.getTileKind(0, 1), TileKind::Dense);
+    EXPECT_EQ(dense.getValue(0, 11), 2.0);
+}
+
+// Допустимые блоки ядра сжимаются крестовой аппроксимацией, умножение на вектор и приближенное LU сохраняют точность
+TEST(BlockMatrixTest, HierarchicalCompression) {
+    const size_t n = 500;
+    auto kernel = [n](size_t i, size_t j) {
+        const double distance = std::fabs(static_cast<double>(i) - static_cast<double>(j)) / static_cast<double>(n);
+        return 1.0 / (1.0 + 10.0 * distance) + (i == j ? 2.0 : 0.0);
+    };
+
+    Matrix<double> dense(n, n);
+    std::vector<double> x(n), expected(n, 0.0);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<double>(i % 7) - 3.0;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            dense(i, j) = kernel(i, j);
+            expected[i] += dense(i, j) * x[j];
+        }
+
+    BlockMatrix<double> compressed(n, n, 32, 32, kernel, 1e-10);
+    EXPECT_EQ(compressed.getTileKind(0, 15), TileKind::LowRank);
+    EXPECT_EQ(compressed.getTileKind(3, 3), TileKind::Dense);
+    EXPECT_LT(compressed.getStoredElementCount(), n * n / 2);
+    EXPECT_LT((compressed.toMatrix() - dense).frobeniusNorm(), 1e-8 * dense.frobeniusNorm());
+    EXPECT_THROW(BlockMatrix<double>(n, n, 32, 32, kernel, -1.0), std::invalid_argument);
+
+    const std::vector<double> y = compressed.multiplyVectorBlockMatrix(x);
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(y[i], expected[i], 1e-7);
+    EXPECT_THROW(compressed.multiplyVectorBlockMatrix(std::vector<double>(n + 1)), std::invalid_argument);
+
+    BlockMatrix<double> approximate(compressed);
+    approximate.factorizeApproximateLUBlockMatrix(1e-10);
+    EXPECT_EQ(approximate.getTileKind(15, 0), TileKind::LowRank);
+    EXPECT_LT(approximate.getStoredElementCount(), n * n / 2);
+    const std::vector<double> solution = approximate.solveLUBlockMatrix(expected);
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(solution[i], x[i], 1e-6);
+
+    BlockMatrix<double> exact(dense, 32, 32);
+    exact.factorizeLUBlockMatrix();
+    const std::vector<double> exactSolution = exact.solveLUBlockMatrix(expected);
+    for (size_t i = 0; i < n; ++i) EXPECT_NEAR(exactSolution[i], x[i], 1e-9);
+}
+
+// Плитки в файле подкачки: кэш не превышает бюджет, умножение и LU совпадают с BlockMatrix
+TEST(BlockMatrixTest, OutOfCoreTiles) {
+    const size_t n = 45;
+    Matrix<double> a(n, n), b(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0 + (i == j ? 60.0 : 0.0);
+            b(i, j) = static_cast<double>((i + 2 * j) % 5) - 2.0;
+        }
+
+    const std::string dir = testing::TempDir();
+    const size_t tileBytes = 8 * 8 * sizeof(double);
+    {
+        OutOfCoreBlockMatrix<double> left(BlockMatrix<double>(a, 8, 8), dir + "matrix_lib_left.tiles", 4 * tileBytes);
+        OutOfCoreBlockMatrix<double> right(BlockMatrix<double>(b, 8, 8), dir + "matrix_lib_right.tiles", 4 * tileBytes);
+        OutOfCoreBlockMatrix<double> product(n, n, 8, 8, dir + "matrix_lib_product.tiles", 4 * tileBytes);
+        EXPECT_EQ(left.getTileStore().getCapacity(), 4u);
+        EXPECT_TRUE(std::ifstream(dir + "matrix_lib_left.tiles").good());
+
+        product.multiplyAddBlockMatrix(left, right);
+        EXPECT_EQ(product.toBlockMatrix().toMatrix(), a * b);
+        EXPECT_GT(left.getTileStore().getEvictionCount(), 0u);
+        EXPECT_THROW(product.multiplyAddBlockMatrix(product, right), std::invalid_argument);
+
+        product.setValue(44, 44, 7.0);
+        EXPECT_EQ(product.getValue(44, 44), 7.0);
+        EXPECT_THROW(product.getValue(n, 0), std::out_of_range);
+
+        BlockMatrix<double> expected(a, 8, 8);
+        expected.factorizeLUBlockMatrix();
+        left.factorizeLUBlockMatrix();
+        const Matrix<double> factors = left.toBlockMatrix().toMatrix();
+        EXPECT_LT((factors - expected.toMatrix()).frobeniusNorm(), 1e-10 * factors.frobeniusNorm());
+        EXPECT_GT(left.getTileStore().getMissCount(), left.getTileStore().getTileCount());
+    }
+    EXPECT_FALSE(std::ifstream(dir + "matrix_lib_left.tiles").good());
+    EXPECT_THROW(OutOfCoreBlockMatrix<double>(n, n, 8, 8, dir + "missing_dir/matrix_lib.tiles"), std::runtime_error);
+}
+
+// Неудачное чтение плитки не остается в кэше: следующее закрепление читает файл заново
+TEST(BlockMatrixTest, TileStoreRetriesFailedRead) {
+    const std::string path = testing::TempDir() + "matrix_lib_retry.tiles";
+    TileStore<double> store(path, 4, 8, 2 * 8 * sizeof(double));
+    {
+        TileStore<double>::Pin pin(store, 1, true);
+        pin.data()[3] = 5.0;
+    }
+    store.flush();
+
+    ASSERT_EQ(truncate(path.c_str(), 0), 0);
+    EXPECT_THROW(store.pin(2), std::runtime_error);
+    EXPECT_THROW(store.pin(2), std::runtime_error);
+
+    ASSERT_EQ(truncate(path.c_str(), static_cast<off_t>(4 * 8 * sizeof(double))), 0);
+    {
+        TileStore<double>::Pin pin(store, 2, false);
+        EXPECT_EQ(pin.data()[0], 0.0);
+    }
+    TileStore<double>::Pin pin(store, 1, false);
+    EXPECT_EQ(pin.data()[3], 5.0);
+}
+
+// Внешняя матрица читает плитки через конвейер предзагрузки
+TEST(BlockMatrixTest, OutOfCorePrefetch) {
+    const size_t n = 29;
+    Matrix<double> a(n, n);
+    std::vector<double> x(n), expected(n, 0.0);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<double>(i % 4) - 1.0;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            a(i, j) = static_cast<double>((i * 3 + j) % 7) - 3.0;
+            expected[i] += a(i, j) * x[j];
+        }
+
+    OutOfCoreBlockMatrix<double> stored(BlockMatrix<double>(a, 8, 8), testing::TempDir() + "matrix_lib_stream.tiles", 2 * 64 * sizeof(double));
+    EXPECT_EQ(stored.multiplyVectorBlockMatrix(x), expected);
+    EXPECT_EQ(stored.getPipelineStats().items, 16u);
+    EXPECT_EQ(stored.toBlockMatrix().toMatrix(), a);
+}
+
+// Транспонирование прямоугольной матрицы с прямоугольными блоками и умножение на транспонированный множитель
+TEST(BlockMatrixTest, TransposeAnyShape) {
+    const size_t rows = 13, cols = 21;
+    Matrix<double> a(rows, cols), b(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j) {
+            a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+            b(i, j) = static_cast<double>((i * 2 + j * 5) % 9) - 4.0;
+        }
+    const Matrix<double>& bRef = b;
+
+    Matrix<double> sparse(4, 6);
+    sparse(1, 4) = 3.0;
+    sparse(3, 0) = -2.0;
+    Matrix<double> u(4, 1), v(6, 1);
+    for (size_t r = 0; r < 4; ++r) u(r, 0) = static_cast<double>(r) + 1.0;
+    for (size_t r = 0; r < 6; ++r) v(r, 0) = static_cast<double>(r % 3) - 1.0;
+
+    BlockMatrix<double> blocks(a, 4, 6);
+    blocks.setSparseBlock(0, 1, SparseMatrix<double>(sparse));
+    blocks.setLowRankBlock(2, 0, u, v);
+    blocks.setBlock(1, 2, Matrix<double>(4, 6));
+    const Matrix<double> dense = blocks.toMatrix();
+    const Matrix<double> expected = dense.transposeMatrix();
+
+    const BlockMatrix<double> copy = blocks.transposedBlockMatrix();
+    EXPECT_EQ(copy.getRowsBlockMatrix(), cols);
+    EXPECT_EQ(copy.getBlockRows(), 6u);
+    EXPECT_EQ(copy.getTileKind(1, 0), TileKind::Sparse);
+    EXPECT_EQ(copy.getTileKind(0, 2), TileKind::LowRank);
+    EXPECT_EQ(copy.toMatrix(), expected);
+
+    BlockMatrix<double> inPlace = blocks;
+    inPlace.transposeBlockMatrix();
+    EXPECT_EQ(inPlace.toMatrix(), expected);
+    inPlace.transposeBlockMatrix();
+    EXPECT_EQ(inPlace.toMatrix(), dense);
+
+    const BlockMatrix<double> right(b, 4, 6);
+    BlockMatrix<double> gram(cols, cols, 6, 6);
+    gram.multiplyAddBlockMatrix(blocks, right, true);
+    EXPECT_EQ(gram.toMatrix(), expected * b);
+
+    BlockMatrix<double> outer(rows, rows, 4, 4);
+    outer.multiplyAddBlockMatrix(blocks, right, false, true);
+    EXPECT_EQ(outer.toMatrix(), dense * bRef.transposeMatrix());
+    EXPECT_THROW(outer.multiplyAddBlockMatrix(blocks, right, true, true), std::invalid_argument);
+}
+
+// Разбиение области плоского буфера на блоки и доступ к плиткам арены без копирования
+TEST(BlockMatrixTest, MatrixViews) {
+    Matrix<double> flat(10, 12);
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t j = 0; j < 12; ++j) flat(i, j) = static_cast<double>(i * 12 + j);
+
+    const Matrix<double>& flatRef = flat;
+    const MatrixView<const double> region = flatRef.view().subView(1, 2, 7, 9);
+    BlockMatrix<double> blocks(region, 3, 4);
+    EXPECT_EQ(blocks.toMatrix(), Matrix<double>(region));
+
+    MatrixView<double> tile = blocks.getBlockView(2, 2);
+    EXPECT_EQ(tile.getRows(), 1u);
+    EXPECT_EQ(tile.getCols(), 1u);
+    EXPECT_EQ(tile.getRowData(0), blocks.getBlockData(2, 2));
+    tile(0, 0) = -5.0;
+    EXPECT_EQ(blocks.getValue(6, 8), -5.0);
+
+    blocks.setBlock(0, 0, Matrix<double>(3, 4));
+    const BlockMatrix<double>& blocksRef = blocks;
+    EXPECT_THROW(blocksRef.getBlockView(0, 0), std::invalid_argument);
+    EXPECT_EQ(blocksRef.getBlockView(1, 1)(0, 0), flat(4, 6));
+
+    blocks.setBlock(1, 0, flatRef.view().tile(0, 0, 3, 4));
+    EXPECT_EQ(blocks.getValue(4, 3), flat(1, 3));
+
+    Matrix<double> target = flat;
+    blocks.copyToView(target.view().subView(1, 2, 7, 9));
+    EXPECT_EQ(target(1, 2), 0.0);
+    EXPECT_EQ(target(7, 10), -5.0);
+    EXPECT_EQ(target(0, 0), flat(0, 0));
+    EXPECT_EQ(Matrix<double>(target.view().subView(1, 2, 7, 9)), blocks.toMatrix());
+    EXPECT_THROW(blocks.copyToView(target.view()), std::invalid_argument);
+}
+
+// Сборка [[A, B], [C, D]] из плиток частей без копирования и копирование при записи
+TEST(BlockMatrixTest, AssembleSharesTiles) {
+    auto filled = [](size_t rows, size_t cols, int seed) {
+        Matrix<double> matrix(rows, cols);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j) matrix(i, j) = static_cast<double>((i * 3 + j * 5 + seed) % 7) + 1.0;
+        return matrix;
+    };
+
+    const Matrix<double> a = filled(8, 12, 0), b = filled(8, 6, 1), c = filled(5, 12, 2);
+    Matrix<double> d(5, 6);
+    d(4, 5) = 3.0;
+
+    BlockMatrix<double> blockA(a, 4, 4);
+    const BlockMatrix<double> blockB(b, 4, 4), blockC(c, 4, 4), blockD(d, 4, 4);
+    const size_t sharedSource = blockA.getDenseTileCount() + blockB.getDenseTileCount() + blockC.getDenseTileCount();
+
+    Matrix<double> expected(13, 18);
+    auto place = [&](const Matrix<double>& part, size_t row, size_t col) {
+        for (size_t i = 0; i < part.getRows(); ++i)
+            for (size_t j = 0; j < part.getCols(); ++j) expected(row + i, col + j) = part(i, j);
+    };
+    place(a, 0, 0);
+    place(b, 0, 12);
+    place(c, 8, 0);
+    place(d, 8, 12);
+
+    BlockMatrix<double> assembled = BlockMatrix<double>::assembleBlockMatrix({ { blockA, blockB }, { blockC, blockD } });
+    EXPECT_EQ(assembled.toMatrix(), expected);
+    EXPECT_EQ(assembled.getDenseTileCount(), 0u);
+    EXPECT_EQ(assembled.getSharedTileCount(), sharedSource + blockD.getDenseTileCount());
+    EXPECT_EQ(assembled.getTileKind(0, 0), TileKind::Shared);
+    EXPECT_EQ((assembled * 2.0).toMatrix(), expected * 2.0);
+    EXPECT_NEAR(assembled.frobeniusNorm(), expected.frobeniusNorm(), 1e-9);
+
+    assembled.setValue(0, 0, 100.0);
+    EXPECT_EQ(blockA.getValue(0, 0), a(0, 0));
+    EXPECT_EQ(assembled.getTileKind(0, 0), TileKind::Dense);
+
+    blockA.setValue(1, 1, -7.0);
+    EXPECT_EQ(assembled.getValue(1, 1), a(1, 1));
+    expected(0, 0) = 100.0;
+    EXPECT_EQ(assembled.toMatrix(), expected);
+
+    const BlockMatrix<double> horizontal = blockA.concat(blockB);
+    EXPECT_EQ(horizontal.getSharedTileCount(),
+              blockA.getDenseTileCount() + blockA.getSharedTileCount() + blockB.getDenseTileCount());
+    EXPECT_EQ(horizontal.getValue(1, 1), -7.0);
+    EXPECT_EQ(horizontal.getValue(5, 17), b(5, 5));
+
+    const BlockMatrix<double> unaligned = blockC.concat(blockC, false);
+    EXPECT_EQ(unaligned.getRowsBlockMatrix(), 10u);
+    EXPECT_EQ(unaligned.getValue(9, 11), c(4, 11));
+    EXPECT_EQ(unaligned.getSharedTileCount(), 0u);
+
+    EXPECT_THROW(BlockMatrix<double>::assembleBlockMatrix({ { blockA, blockC } }), std::invalid_argument);
+    EXPECT_THROW(blockA.concat(blockD, false), std::invalid_argument);
+}
+
+// Запись в исходную матрицу после concat копирует только изменяемые блоки
+TEST(BlockMatrixTest, SharedTilesCopyOnWrite) {
+    Matrix<double> a(8, 12), b(8, 4);
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 12; ++j) a(i, j) = static_cast<double>(i * 12 + j) + 1.0;
+        for (size_t j = 0; j < 4; ++j) b(i, j) = static_cast<double>(i + j) + 2.0;
+    }
+
+    BlockMatrix<double> blockA(a, 4, 4);
+    const BlockMatrix<double> blockB(b, 4, 4);
+    const BlockMatrix<double> joined = blockA.concat(blockB);
+    ASSERT_EQ(blockA.getDenseTileCount(), 6u);
+
+    blockA.setValue(5, 9, -1.0);
+    EXPECT_EQ(blockA.getDenseTileCount(), 1u);
+    EXPECT_EQ(blockA.getSharedTileCount(), 5u);
+    EXPECT_EQ(blockA.getTileKind(1, 2), TileKind::Dense);
+    EXPECT_EQ(blockA.getTileKind(0, 0), TileKind::Shared);
+    EXPECT_EQ(blockA.getValue(5, 9), -1.0);
+    EXPECT_EQ(blockA.getValue(0, 0), a(0, 0));
+
+    blockA.clearBlock(0, 1);
+    EXPECT_EQ(blockA.getSharedTileCount(), 4u);
+    Matrix<double> identity(8, 8);
+    for (size_t i = 0; i < 8; ++i) identity(i, i) = 1.0;
+    blockA.multiplyAddBlockMatrix(BlockMatrix<double>(identity, 4, 4), BlockMatrix<double>(a, 4, 4));
+    EXPECT_EQ(blockA.getSharedTileCount(), 0u);
+    EXPECT_EQ(blockA.getDenseTileCount(), 6u);
+    EXPECT_EQ(blockA.getValue(0, 0), 2.0 * a(0, 0));
+    EXPECT_EQ(blockA.getValue(0, 5), a(0, 5));
+
+    Matrix<double> expected(8, 16);
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 12; ++j) expected(i, j) = a(i, j);
+        for (size_t j = 0; j < 4; ++j) expected(i, 12 + j) = b(i, j);
+    }
+    EXPECT_EQ(joined.toMatrix(), expected);
+    EXPECT_EQ(joined.getSharedTileCount(), 8u);
+}
+
+// Порядок Morton не меняет значений и результатов операций, а четверти сетки лежат в памяти подряд
+TEST(BlockMatrixTest, MortonLayout) {
+    Matrix<double> a(14, 14), b(14, 10);
+    for (size_t i = 0; i < 14; ++i) {
+        for (size_t j = 0; j < 14; ++j) a(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+        for (size_t j = 0; j < 10; ++j) b(i, j) = static_cast<double>((i + 2 * j) % 5);
+        a(i, i) += 40.0;
+    }
+
+    const BlockMatrix<double> rowMajorA(a, 4, 4), rowMajorB(b, 4, 4);
+    BlockMatrix<double> mortonA(a, 4, 4), mortonB(b, 4, 4);
+    mortonA.setTileLayout(TileLayout::Morton);
+    mortonB.setTileLayout(TileLayout::Morton);
+    EXPECT_EQ(mortonA.getTileLayout(), TileLayout::Morton);
+
+    EXPECT_EQ(mortonA.toMatrix(), a);
+    EXPECT_EQ(mortonA.getBlock(2, 1), rowMajorA.getBlock(2, 1));
+    EXPECT_EQ(mortonA.getValue(13, 5), a(13, 5));
+    EXPECT_EQ(mortonA * mortonB, rowMajorA * rowMajorB);
+    EXPECT_EQ((mortonA * mortonB).getTileLayout(), TileLayout::Morton);
+    EXPECT_EQ((mortonA + rowMajorA).toMatrix(), a * 2.0);
+    EXPECT_EQ(mortonB.transposedBlockMatrix().toMatrix(), rowMajorB.transposedBlockMatrix().toMatrix());
+    EXPECT_EQ(mortonB.transposedBlockMatrix().getTileLayout(), TileLayout::Morton);
+
+    BlockMatrix<double> transposed(mortonB);
+    transposed.transposeBlockMatrix();
+    EXPECT_EQ(transposed.toMatrix(), rowMajorB.transposedBlockMatrix().toMatrix());
+    EXPECT_EQ(mortonA.concat(mortonB).toMatrix(), rowMajorA.concat(rowMajorB).toMatrix());
+
+    std::vector<double> rhs(14, 1.0);
+    BlockMatrix<double> luRowMajor(a, 4, 4), luMorton(mortonA);
+    luRowMajor.factorizeLUBlockMatrix();
+    luMorton.factorizeLUBlockMatrix();
+    const std::vector<double> expected = luRowMajor.solveLUBlockMatrix(rhs), actual = luMorton.solveLUBlockMatrix(rhs);
+    for (size_t i = 0; i < rhs.size(); ++i) EXPECT_NEAR(actual[i], expected[i], 1e-9);
+
+    const double* origin = mortonA.getBlockView(0, 0).getRowData(0);
+    const std::ptrdiff_t tile = mortonA.getBlockView(0, 1).getRowData(0) - origin;
+    EXPECT_EQ(mortonA.getBlockView(1, 0).getRowData(0) - origin, 2 * tile);
+    EXPECT_EQ(mortonA.getBlockView(1, 1).getRowData(0) - origin, 3 * tile);
+    EXPECT_EQ(mortonA.getBlockView(0, 2).getRowData(0) - origin, 4 * tile);
+    EXPECT_EQ(mortonA.getBlockView(2, 0).getRowData(0) - origin, 8 * tile);
+
+    mortonA.setTileLayout(TileLayout::RowMajor);
+    EXPECT_EQ(mortonA.toMatrix(), a);
+    EXPECT_EQ(mortonA.getBlockView(1, 0).getRowData(0) - mortonA.getBlockView(0, 0).getRowData(0), 4 * tile);
+}
+
+// Произведение по Штрассену — Винограду совпадает с плиточным на сетках любой формы
+TEST(BlockMatrixTest, StrassenProduct) {
+    Matrix<double> a(37, 29), b(29, 23);
+    for (size_t i = 0; i < a.getRows(); ++i)
+        for (size_t j = 0; j < a.getCols(); ++j) a(i, j) = static_cast<double>((i * 5 + j * 3) % 13) - 6.0;
+    for (size_t i = 0; i < b.getRows(); ++i)
+        for (size_t j = 0; j < b.getCols(); ++j) b(i, j) = (i + j) % 4 == 0 ? static_cast<double>((i * j) % 7) : 0.0;
+
+    const BlockMatrix<double> blockA(a, 4, 3), blockB(b, 3, 5);
+    const Matrix<double> expected = (blockA * blockB).toMatrix();
+
+    for (size_t crossover : { 1, 2, 3, 10 }) {
+        const Matrix<double> actual = blockA.multiplyStrassenBlockMatrix(blockB, crossover).toMatrix();
+        ASSERT_EQ(actual.getRows(), expected.getRows());
+        ASSERT_EQ(actual.getCols(), expected.getCols());
+        for (size_t i = 0; i < expected.getRows(); ++i)
+            for (size_t j = 0; j < expected.getCols(); ++j) EXPECT_NEAR(actual(i, j), expected(i, j), 1e-9);
+    }
+
+    BlockMatrix<double> identity(16, 16, 4, 4);
+    for (size_t i = 0; i < 16; ++i) identity.setValue(i, i, 1.0);
+    const BlockMatrix<double> square(a.view().subView(0, 0, 16, 16), 4, 4);
+    EXPECT_EQ(square.multiplyStrassenBlockMatrix(identity, 1), square);
+    EXPECT_EQ(square.multiplyStrassenBlockMatrix(BlockMatrix<double>(16, 16, 4, 4), 1).getDenseTileCount(), 0u);
+
+    EXPECT_THROW(blockA.multiplyStrassenBlockMatrix(blockA), std::invalid_argument);
+    EXPECT_THROW(blockA.multiplyStrassenBlockMatrix(BlockMatrix<double>(b, 4, 5)), std::invalid_argument);
+    EXPECT_THROW(blockA.multiplyStrassenBlockMatrix(blockB, 0), std::invalid_argument);
+}
+
+// Процессы читают плитки из общего сегмента без копий и умножают каждый свою полосу строк
+TEST(BlockMatrixTest, SharedMemoryTiles) {
+    const size_t n = 29;
+    Matrix<double> a(n, n), b(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            a(i, j) = i / 8 == 1 ? 0.0 : static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+            b(i, j) = static_cast<double>((i + 2 * j) % 5) - 2.0;
+        }
+
+    const std::string prefix = "/matrix_lib_" + std::to_string(getpid());
+    const SharedBlockMatrix<double> left(BlockMatrix<double>(a, 8, 8), prefix + "_left");
+    const SharedBlockMatrix<double> right(BlockMatrix<double>(b, 8, 8), prefix + "_right");
+    SharedBlockMatrix<double> product(n, n, 8, 8, prefix + "_product");
+    EXPECT_EQ(left.getStoredTileCount(), 12u);
+    EXPECT_EQ(left.getTileKind(1, 2), TileKind::Zero);
+
+    {
+        const SharedBlockMatrix<double> attached(prefix + "_left");
+        EXPECT_FALSE(attached.isWritable());
+        EXPECT_EQ(attached.toBlockMatrix().toMatrix(), a);
+        EXPECT_EQ(attached.getBlock(3, 3), left.getBlock(3, 3));
+        EXPECT_NE(attached.getBlockView(0, 0).getRowData(0), left.getBlockView(0, 0).getRowData(0));
+        EXPECT_THROW(attached.getBlockView(1, 0), std::invalid_argument);
+    }
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        int status = 1;
+        try {
+            const SharedBlockMatrix<double> sharedA(prefix + "_left"), sharedB(prefix + "_right");
+            SharedBlockMatrix<double> sharedC(prefix + "_product", true);
+            try {
+                sharedC.multiplyAddRowBand(sharedA, sharedB, 1, 2);
+                sharedC.finishRowBand();
+                status = 0;
+            } catch (...) {
+                sharedC.failRowBand();
+            }
+        } catch (...) {
+        }
+        _exit(status);
+    }
+
+    product.multiplyAddRowBand(left, right, 0, 2);
+    product.finishRowBand();
+
+    int status = -1;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    ASSERT_TRUE(product.waitRowBands(2, std::chrono::seconds(5)));
+    EXPECT_EQ(product.toBlockMatrix().toMatrix(), a * b);
+    EXPECT_EQ(product.getValue(n - 1, 0), (a * b)(n - 1, 0));
+
+    product.resetRowBands();
+    EXPECT_EQ(product.getFinishedRowBands(), 0u);
+    EXPECT_EQ(product.getRowBandRound(), 1u);
+    EXPECT_FALSE(product.waitRowBands(1, std::chrono::milliseconds(5)));
+    product.failRowBand();
+    EXPECT_THROW(product.waitRowBands(1, std::chrono::seconds(5)), std::runtime_error);
+
+    SharedBlockMatrix<double> readOnly(prefix + "_product");
+    EXPECT_THROW(readOnly.finishRowBand(), std::invalid_argument);
+    EXPECT_THROW(readOnly.multiplyAddRowBand(left, right, 0, 1), std::invalid_argument);
+    EXPECT_THROW(product.getRowBand(2, 2), std::out_of_range);
+    EXPECT_THROW(SharedBlockMatrix<double>(n, n, 8, 8, prefix + "_left"), std::runtime_error);
+    EXPECT_THROW(SharedBlockMatrix<float>(prefix + "_left"), std::runtime_error);
+    EXPECT_THROW(SharedBlockMatrix<double>(prefix + "_missing"), std::runtime_error);
+    EXPECT_THROW(SharedBlockMatrix<double>("no_slash"), std::invalid_argument);
+
+    const SharedBlockMatrix<double> corrupt(BlockMatrix<double>(a, 8, 8), prefix + "_corrupt");
+    const int fd = shm_open((prefix + "_corrupt").c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void* mapped = mmap(nullptr, sizeof(SharedTileHeader) + sizeof(uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(mapped, MAP_FAILED);
+    SharedTileHeader* header = static_cast<SharedTileHeader*>(mapped);
+    reinterpret_cast<uint64_t*>(header + 1)[0] = header->tileCount;
+    munmap(mapped, sizeof(SharedTileHeader) + sizeof(uint64_t));
+    EXPECT_THROW(SharedBlockMatrix<double>(prefix + "_corrupt"), std::runtime_error);
+}
+
+} // namespace matrix_lib
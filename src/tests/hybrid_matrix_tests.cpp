@@ -0,0 +1,99 @@
+#include "../hybrid_matrix/hybrid_matrix.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace matrix_lib {
+
+TEST(HybridMatrixTest, DenseSparseConversion) {
+    Matrix<int> dense(150, 4);
+    dense(0, 1) = 5;
+    dense(77, 3) = -2;
+    dense(149, 0) = 7;
+
+    SparseMatrix<int> sparse(dense);
+    EXPECT_EQ(sparse.getNonZeroCount(), 3);
+    EXPECT_EQ(sparse.getValue(77, 3), -2);
+    EXPECT_EQ(sparse.getValue(149, 0), 7);
+
+    EXPECT_EQ(sparse.toDenseMatrix(), dense);
+}
+
+TEST(HybridMatrixTest, SelectsRepresentationByDensity) {
+    HybridMatrix<double>::setThresholds({ 0.25, 0.25 });
+
+    Matrix<double> mostlyZero(10, 10);
+    mostlyZero(3, 4) = 1.5;
+    HybridMatrix<double> sparse(mostlyZero);
+    EXPECT_EQ(sparse.getRepresentation(), Representation::Sparse);
+    EXPECT_DOUBLE_EQ(sparse.getValue(3, 4), 1.5);
+
+    SparseMatrix<double> filled(2, 2);
+    filled.addValue(0, 0, 1.0);
+    filled.addValue(0, 1, 2.0);
+    filled.addValue(1, 1, 3.0);
+    HybridMatrix<double> dense(filled);
+    EXPECT_EQ(dense.getRepresentation(), Representation::Dense);
+    EXPECT_DOUBLE_EQ(dense.getValue(0, 1), 2.0);
+}
+
+TEST(HybridMatrixTest, OperationsMatchDense) {
+    HybridMatrix<int>::setThresholds({ 0.25, 0.25 });
+
+    Matrix<int> a(3, 3);
+    a(0, 2) = 2;
+    Matrix<int> b(3, 3);
+    b(2, 1) = 3;
+    b(0, 0) = 1;
+    b(1, 1) = 4;
+    b(2, 2) = 5;
+
+    HybridMatrix<int> ha(a);
+    HybridMatrix<int> hb(b);
+    EXPECT_EQ(ha.getRepresentation(), Representation::Sparse);
+    EXPECT_EQ(hb.getRepresentation(), Representation::Dense);
+
+    EXPECT_EQ((ha * hb).toDenseMatrix(), a * b);
+    EXPECT_EQ((hb * ha).toDenseMatrix(), b * a);
+    EXPECT_EQ((ha + hb).toDenseMatrix(), a + b);
+    EXPECT_EQ(ha * b, a * b);
+
+    EXPECT_THROW(ha + HybridMatrix<int>(Matrix<int>(2, 2)), std::invalid_argument);
+}
+
+TEST(HybridMatrixTest, CalibratedThresholdsInRange) {
+    HybridThresholds thresholds = HybridMatrix<float>::calibrateThresholds();
+    EXPECT_GE(thresholds.multiplyDensity, HYBRID_MIN_THRESHOLD);
+    EXPECT_LE(thresholds.multiplyDensity, HYBRID_MAX_THRESHOLD);
+    EXPECT_GE(thresholds.addDensity, HYBRID_MIN_THRESHOLD);
+    EXPECT_LE(thresholds.addDensity, HYBRID_MAX_THRESHOLD);
+}
+
+TEST(HybridMatrixTest, SelectsDiagonalFormatForStencil) {
+    HybridMatrix<double>::setThresholds({ 0.25, 0.25 });
+
+    const size_t side = 8;
+    const size_t n = side * side;
+    SparseMatrix<double> stencil(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        stencil.addValue(i, i, 4.0);
+        if (i % side != 0) stencil.addValue(i, i - 1, -1.0);
+        if (i % side != side - 1) stencil.addValue(i, i + 1, -1.0);
+        if (i >= side) stencil.addValue(i, i - side, -1.0);
+        if (i + side < n) stencil.addValue(i, i + side, -1.0);
+    }
+
+    HybridMatrix<double> hybrid(stencil);
+    EXPECT_EQ(hybrid.getRepresentation(), Representation::Diagonal);
+    EXPECT_DOUBLE_EQ(hybrid.getValue(9, 1), -1.0);
+
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<double>(i % 5);
+    EXPECT_EQ(hybrid.multiplyVectorHybridMatrix(x), stencil.multiplyVectorSparseMatrix(x));
+    EXPECT_EQ((hybrid * hybrid).toDenseMatrix(), (stencil * stencil).toDenseMatrix());
+
+    hybrid.optimizeFor(HybridOperation::Add);
+    EXPECT_EQ(hybrid.getRepresentation(), Representation::Sparse);
+    EXPECT_EQ(hybrid.toDenseMatrix(), stencil.toDenseMatrix());
+}
+
+}
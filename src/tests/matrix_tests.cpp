@@ -365,4 +365,30 @@ TEST(MatrixTest, IsOrthogonalMatrix) {
     EXPECT_FALSE(ortho.isOrthogonalMatrix());
 }
 
+TEST(MatrixTest, ViewsShareStorage) {
+    Matrix<int> mat(5, 7);
+    for (size_t i = 0; i < 5; ++i)
+        for (size_t j = 0; j < 7; ++j) mat(i, j) = static_cast<int>(i * 7 + j);
+
+    MatrixView<int> view = mat.view();
+    EXPECT_EQ(view.getStride(), 7u);
+    EXPECT_EQ(view.getRowData(2), mat.getRowData(2));
+
+    MatrixView<int> edge = view.tile(1, 2, 3, 3);
+    EXPECT_EQ(edge.getRows(), 2u);
+    EXPECT_EQ(edge.getCols(), 1u);
+    EXPECT_EQ(edge(1, 0), 34);
+
+    edge(0, 0) = -1;
+    EXPECT_EQ(mat(3, 6), -1);
+
+    const MatrixView<const int> readOnly = view.subView(1, 1, 2, 3);
+    const Matrix<int> copy(readOnly);
+    EXPECT_EQ(copy(1, 2), 17);
+    EXPECT_THROW(readOnly(2, 0), std::out_of_range);
+    EXPECT_THROW(view.subView(4, 0, 2, 1), std::out_of_range);
+    EXPECT_THROW(view.tile(2, 0, 3, 3), std::out_of_range);
+    EXPECT_THROW(MatrixView<int>(mat.getRowData(0), 2, 7, 6), std::invalid_argument);
+}
+
 }
@@ -0,0 +1,102 @@
+#include "../parallel/prefetch_pipeline.hpp"
+#include "../parallel/task_graph.hpp"
+#include "../parallel/task_pool.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace matrix_lib {
+
+// Задачи, добавленные из задач пула, выполняются до возврата из wait()
+TEST(TaskPoolTest, NestedSubmit) {
+    std::atomic<int> counter{ 0 };
+    TaskPool pool(3);
+    for (int t = 0; t < 100; ++t) pool.submit([&counter, &pool] {
+        pool.submit([&counter] { ++counter; });
+        ++counter;
+    });
+    pool.wait();
+    EXPECT_EQ(counter.load(), 200);
+}
+
+// Ожидание группы не ждет чужих задач и не получает чужих исключений
+TEST(TaskPoolTest, GroupsAreIndependent) {
+    TaskPool pool(2);
+    TaskGroup failing, working;
+    std::atomic<bool> release{ false };
+    std::atomic<int> counter{ 0 };
+
+    pool.submit(failing, [&release] {
+        while (!release) std::this_thread::yield();
+        throw std::runtime_error("failing group");
+    });
+    for (int t = 0; t < 20; ++t) pool.submit(working, [&counter] { ++counter; });
+
+    EXPECT_NO_THROW(pool.wait(working));
+    EXPECT_EQ(counter.load(), 20);
+    EXPECT_FALSE(release.load());
+
+    release = true;
+    EXPECT_THROW(pool.wait(failing), std::runtime_error);
+    EXPECT_NO_THROW(pool.wait(failing));
+}
+
+// Ребра графа выводятся из наборов чтения и записи: RAW, WAR и WAW
+TEST(TaskGraphTest, EdgesFromAccessSets) {
+    TaskGraph graph;
+    graph.addTask([] {}, {}, { 0 });
+    graph.addTask([] {}, { 0 }, { 1 });
+    graph.addTask([] {}, { 0 }, { 2 });
+    graph.addTask([] {}, { 1, 2 }, { 0 });
+    EXPECT_EQ(graph.getEdgeCount(), 5u);
+}
+
+// Загрузка элемента k + 1 начинается до конца счета над элементом k
+TEST(PrefetchPipelineTest, LoadOverlapsCompute) {
+    const size_t count = 12;
+    std::vector<std::atomic<bool>> started(count + 1);
+    std::vector<size_t> order;
+    size_t overlapped = 0;
+
+    runPrefetchPipeline(count, [&](size_t k) {
+        started[k] = true;
+        return std::vector<size_t>(3, k);
+    }, [&](size_t k, std::vector<size_t>& item) {
+        EXPECT_EQ(item, std::vector<size_t>(3, k));
+        order.push_back(k);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (k + 1 < count && !started[k + 1] && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        if (k + 1 < count && started[k + 1]) ++overlapped;
+    }, 1, 2);
+
+    EXPECT_EQ(overlapped, count - 1);
+    EXPECT_EQ(order.size(), count);
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+}
+
+// Замеры прогона: количество элементов и доля скрытой загрузки
+TEST(PrefetchPipelineTest, Stats) {
+    const PipelineStats stats = runPrefetchPipeline(12, [](size_t k) { return k; }, [](size_t, size_t&) {}, 2, 3);
+    EXPECT_EQ(stats.items, 12u);
+    EXPECT_GE(stats.getOverlapRatio(), 0.0);
+    EXPECT_LE(stats.getOverlapRatio(), 1.0);
+    EXPECT_EQ(PipelineStats{}.getOverlapRatio(), 1.0);
+}
+
+// Первое исключение загрузки или счета останавливает конвейер и пробрасывается
+TEST(PrefetchPipelineTest, PropagatesErrors) {
+    EXPECT_THROW(runPrefetchPipeline(8, [](size_t k) {
+        if (k == 5) throw std::runtime_error("load failed");
+        return k;
+    }, [](size_t, size_t&) {}), std::runtime_error);
+    EXPECT_THROW(runPrefetchPipeline(8, [](size_t k) { return k; }, [](size_t k, size_t&) {
+        if (k == 2) throw std::logic_error("compute failed");
+    }), std::logic_error);
+}
+
+} // namespace matrix_lib
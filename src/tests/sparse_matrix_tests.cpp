@@ -1,4 +1,10 @@
 #include "../sparse_matrix/sparse_matrix.hpp"
+#include "../sparse_matrix/spgemm_plan.hpp"
+#include "../sparse_matrix/eigen_solver.hpp"
+#include "../sparse_matrix/dynamic_sparse_matrix.hpp"
+#include "../sparse_matrix/diagonal_matrix.hpp"
+#include "../sparse_matrix/matrix_market.hpp"
+#include "../sparse_matrix/pattern_matrix.hpp"
 #include <gtest/gtest.h>
 #include <stdexcept>
 
@@ -180,5 +186,508 @@ TEST(SparseMatrixTest, TraceZeroSizeSparseMatrix) {
     EXPECT_THROW(mat.traceSparseMatrix(), std::invalid_argument);
 }
 
+// Тест для умножения разреженной матрицы на плотную
+TEST(SparseMatrixTest, SparseDenseMultiplication) {
+    SparseMatrix<int> sparse(2, 3);
+    sparse.addValue(1, 2, 2);
+    sparse.addValue(0, 0, 1);
+    sparse.addValue(0, 2, 3);
+
+    Matrix<int> dense(3, 10);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 10; ++j) dense(i, j) = static_cast<int>(i * 10 + j);
+
+    Matrix<int> result = sparse * dense;
+    ASSERT_EQ(result.getRows(), 2);
+    ASSERT_EQ(result.getCols(), 10);
+    for (size_t j = 0; j < 10; ++j) {
+        EXPECT_EQ(result(0, j), dense(0, j) + 3 * dense(2, j));
+        EXPECT_EQ(result(1, j), 2 * dense(2, j));
+    }
+
+    EXPECT_THROW(sparse * Matrix<int>(2, 4), std::invalid_argument);
 }
 
+// Тест для умножения на плотную матрицу по частям строк и по нескольким полосам столбцов
+TEST(SparseMatrixTest, SparseDenseMultiplicationParallel) {
+    const size_t rows = 4 * PARALLEL_MIN_GRAIN + 3, depth = 37, width = 2 * SPMM_COLUMN_BLOCK + 3;
+    SparseMatrix<int> sparse(rows, depth);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t k = i % 5; k < depth; k += 7) sparse.addValue(i, k, static_cast<int>((i + 2 * k) % 9) - 4);
+
+    Matrix<int> dense(depth, width);
+    for (size_t k = 0; k < depth; ++k)
+        for (size_t j = 0; j < width; ++j) dense(k, j) = static_cast<int>((3 * k + j) % 11) - 5;
+
+    Matrix<int> result = sparse * dense;
+    ASSERT_EQ(result.getRows(), rows);
+    ASSERT_EQ(result.getCols(), width);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < width; ++j) {
+            int expected = 0;
+            for (size_t k = 0; k < depth; ++k) expected += sparse.getValue(i, k) * dense(k, j);
+            EXPECT_EQ(result(i, j), expected);
+        }
+}
+
+// Тест для умножения плотной матрицы на разреженную
+TEST(SparseMatrixTest, DenseSparseMultiplication) {
+    Matrix<double> dense(200, 3);
+    for (size_t i = 0; i < 200; ++i)
+        for (size_t j = 0; j < 3; ++j) dense(i, j) = static_cast<double>(i + j);
+
+    SparseMatrix<double> sparse(3, 2);
+    sparse.addValue(0, 1, 2.0);
+    sparse.addValue(2, 0, -1.0);
+
+    Matrix<double> result = dense * sparse;
+    ASSERT_EQ(result.getRows(), 200);
+    ASSERT_EQ(result.getCols(), 2);
+    for (size_t i = 0; i < 200; ++i) {
+        EXPECT_DOUBLE_EQ(result(i, 0), -dense(i, 2));
+        EXPECT_DOUBLE_EQ(result(i, 1), 2.0 * dense(i, 0));
+    }
+}
+
+// Тест для маскированного умножения (подсчет треугольников)
+TEST(SparseMatrixTest, MaskedMultiplicationSparseMatrix) {
+    SparseMatrix<int> graph(4, 4);
+    const size_t edges[][2] = { { 0, 1 }, { 1, 2 }, { 0, 2 }, { 2, 3 } };
+    for (const auto& edge : edges) {
+        graph.addValue(edge[0], edge[1], 1);
+        graph.addValue(edge[1], edge[0], 1);
+    }
+
+    SparseMatrix<int> paths = graph.maskedMultiplySparseMatrix(graph, graph);
+    EXPECT_EQ(paths.totalSumSparseMatrix() / 6, 1);
+    EXPECT_EQ(paths.getValue(0, 1), 1);
+    EXPECT_EQ(paths.getValue(2, 3), 0);
+
+    EXPECT_EQ(paths.getNonZeroCount(), 6);
+    EXPECT_EQ(paths.getValue(3, 2), 0);
+
+    EXPECT_THROW(graph.maskedMultiplySparseMatrix(graph, SparseMatrix<int>(3, 4)), std::invalid_argument);
+}
+
+// Тест для выборочного произведения плотных матриц (SDDMM)
+TEST(SparseMatrixTest, SampledDenseProductSparseMatrix) {
+    Matrix<double> left(3, 2);
+    Matrix<double> right(2, 4);
+    for (size_t k = 0; k < 2; ++k) {
+        for (size_t i = 0; i < 3; ++i) left(i, k) = static_cast<double>(i + k + 1);
+        for (size_t j = 0; j < 4; ++j) right(k, j) = static_cast<double>(j) - static_cast<double>(k);
+    }
+
+    SparseMatrix<double> mask(3, 4);
+    mask.addValue(2, 3, 0.5);
+    mask.addValue(0, 1, 1.0);
+
+    SparseMatrix<double> result = mask.sampledDenseProductSparseMatrix(left, right);
+    Matrix<double> product = left * right;
+
+    EXPECT_EQ(result.getNonZeroCount(), 2);
+    EXPECT_DOUBLE_EQ(result.getValue(0, 1), product(0, 1));
+    EXPECT_DOUBLE_EQ(result.getValue(2, 3), 0.5 * product(2, 3));
+    EXPECT_DOUBLE_EQ(result.getValue(1, 1), 0.0);
+}
+
+// Тест для SpMV и SpGEMM над различными полукольцами
+TEST(SparseMatrixTest, SemiringKernelsSparseMatrix) {
+    SparseMatrix<double> weights(3, 3);
+    weights.addValue(0, 1, 4.0);
+    weights.addValue(1, 2, 1.0);
+    weights.addValue(0, 2, 7.0);
+
+    std::vector<double> distances = { 0.0, MinPlus<double>::zero(), MinPlus<double>::zero() };
+    std::vector<double> relaxed = weights.transposeSparseMatrix().multiplyVectorSparseMatrix<MinPlus<double>>(distances);
+    EXPECT_DOUBLE_EQ(relaxed[1], 4.0);
+    EXPECT_DOUBLE_EQ(relaxed[2], 7.0);
+
+    SparseMatrix<double> twoHops = weights.multiplySparseMatrix<MinPlus<double>>(weights);
+    EXPECT_DOUBLE_EQ(twoHops.getValue(0, 2), 5.0);
+    EXPECT_EQ(twoHops.getNonZeroCount(), 1);
+
+    SparseMatrix<int> graph(3, 3);
+    graph.addValue(0, 1, 1);
+    graph.addValue(1, 2, 1);
+    std::vector<int> frontier = graph.transposeSparseMatrix().multiplyVectorSparseMatrix<OrAnd<int>>({ 1, 0, 0 });
+    EXPECT_EQ(frontier, std::vector<int>({ 0, 1, 0 }));
+
+    SparseMatrix<double> reliability = weights.multiplySparseMatrix<MaxTimes<double>>(weights);
+    EXPECT_DOUBLE_EQ(reliability.getValue(0, 2), 4.0);
+
+    SparseMatrix<double> forward(2, 2), backward(2, 2);
+    forward.addValue(0, 1, 2.0);
+    backward.addValue(1, 0, -2.0);
+    SparseMatrix<double> cycle = forward.multiplySparseMatrix<MinPlus<double>>(backward);
+    EXPECT_EQ(cycle.getNonZeroCount(), 1);
+    EXPECT_DOUBLE_EQ(cycle.getValue(0, 0), 0.0);
+    EXPECT_EQ(cycle.multiplySparseMatrix<MinPlus<double>>(cycle).getNonZeroCount(), 1);
+}
+
+// Тест для умножения с пользовательским полукольцом и повторяющимися путями
+TEST(SparseMatrixTest, CustomSemiringSparseMatrix) {
+    struct CountPaths {
+        static constexpr int zero() noexcept { return 0; }
+        static constexpr int add(const int a, const int b) noexcept { return a + b; }
+        static constexpr int multiply(const int, const int) noexcept { return 1; }
+    };
+
+    SparseMatrix<int> graph(3, 3);
+    graph.addValue(0, 1, 5);
+    graph.addValue(0, 2, 6);
+    graph.addValue(1, 0, 7);
+    graph.addValue(2, 0, 8);
+
+    SparseMatrix<int> paths = graph.multiplySparseMatrix<CountPaths>(graph);
+    EXPECT_EQ(paths.getValue(0, 0), 2);
+    EXPECT_EQ(paths.getValue(1, 2), 1);
+
+    SparseMatrix<int> product = graph * graph;
+    EXPECT_EQ(product.getValue(0, 0), 5 * 7 + 6 * 8);
+    EXPECT_EQ(product.getNonZeroCount(), 5);
+    EXPECT_THROW(graph.multiplyVectorSparseMatrix({ 1, 2 }), std::invalid_argument);
+}
+
+// Тест для повторного численного умножения по готовому плану
+TEST(SparseMatrixTest, SpGemmPlanNumericReuse) {
+    SparseMatrix<double> a(2, 3);
+    a.addValue(1, 2, 2.0);
+    a.addValue(0, 0, 1.0);
+    a.addValue(0, 1, 3.0);
+
+    SparseMatrix<double> b(3, 2);
+    b.addValue(0, 1, 4.0);
+    b.addValue(1, 1, 5.0);
+    b.addValue(2, 0, 6.0);
+
+    SpGemmPlan<double> plan(a, b);
+    SparseMatrix<double> result = plan.createResultSparseMatrix();
+    EXPECT_EQ(plan.getNonZeroCount(), 2);
+    EXPECT_EQ(plan.getFlopCount(), 3);
+
+    for (double scale : { 1.0, -2.0, 0.5 }) {
+        a.scaleSparseMatrix(scale);
+        plan.multiplyNumeric(a, b, result);
+        EXPECT_EQ(result, a * b);
+    }
+
+    SparseMatrix<double> other(2, 3);
+    EXPECT_THROW(plan.multiplyNumeric(other, b, result), std::invalid_argument);
+}
+
+// Тест для метода Ланцоша на матрице одномерного лапласиана
+TEST(SparseMatrixTest, LanczosEigenSparseMatrix) {
+    const size_t n = 200;
+    SparseMatrix<double> laplacian(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        laplacian.addValue(i, i, 2.0);
+        if (i + 1 < n) {
+            laplacian.addValue(i, i + 1, -1.0);
+            laplacian.addValue(i + 1, i, -1.0);
+        }
+    }
+
+    KrylovEigenSolver<double> solver(laplacian, 3, EigenTarget::LargestAlgebraic);
+    SymmetricEigenResult<double> result = solver.solveSymmetric();
+    ASSERT_TRUE(result.converged);
+    ASSERT_EQ(result.values.size(), 3);
+    EXPECT_EQ(result.vectors.getRows(), n);
+    EXPECT_EQ(result.vectors.getCols(), 3);
+
+    const double pi = std::acos(-1.0);
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_NEAR(result.values[k], 2.0 - 2.0 * std::cos((n - k) * pi / (n + 1)), 1e-8);
+
+        std::vector<double> x(n);
+        for (size_t i = 0; i < n; ++i) x[i] = result.vectors(i, k);
+        std::vector<double> ax = laplacian.multiplyVectorSparseMatrix(x);
+        for (size_t i = 0; i < n; ++i) EXPECT_NEAR(ax[i], result.values[k] * x[i], 1e-6);
+    }
+
+    KrylovEigenSolver<double> smallest(laplacian, 1, EigenTarget::SmallestAlgebraic, 40);
+    EXPECT_NEAR(smallest.solveSymmetric().values[0], 2.0 - 2.0 * std::cos(pi / (n + 1)), 1e-6);
+
+    EXPECT_THROW(KrylovEigenSolver<double>(SparseMatrix<double>(2, 3), 1), std::invalid_argument);
+    EXPECT_THROW(KrylovEigenSolver<double>(laplacian, 0), std::invalid_argument);
+}
+
+// Тест для метода Арнольди на несимметричной матрице с комплексной парой
+TEST(SparseMatrixTest, ArnoldiEigenSparseMatrix) {
+    const size_t n = 100;
+    SparseMatrix<double> matrix(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        matrix.addValue(i, i, 1.0 + i);
+        if (i + 2 < n) matrix.addValue(i, i + 1, 0.5);
+    }
+    matrix.addValue(n - 2, n - 1, 3.0);
+    matrix.addValue(n - 1, n - 2, -3.0);
+
+    KrylovEigenSolver<double> solver(matrix, 3, EigenTarget::LargestMagnitude);
+    EigenResult<double> result = solver.solveGeneral();
+    ASSERT_TRUE(result.converged);
+    ASSERT_EQ(result.values.size(), 3);
+
+    const double a = n - 1.0;
+    const double d = n;
+    const double re = 0.5 * (a + d);
+    const double im = std::sqrt(9.0 - 0.25 * (a - d) * (a - d));
+    EXPECT_NEAR(std::abs(result.values[0].real() - re), 0.0, 1e-8);
+    EXPECT_NEAR(std::abs(result.values[0].imag()), im, 1e-8);
+    EXPECT_NEAR(std::abs(result.values[1] - std::conj(result.values[0])), 0.0, 1e-8);
+    EXPECT_NEAR(result.values[2].real(), n - 2.0, 1e-8);
+
+    for (size_t k = 0; k < 3; ++k) {
+        const std::vector<std::complex<double>>& x = result.vectors[k];
+        std::vector<double> re(n), im(n);
+        for (size_t i = 0; i < n; ++i) {
+            re[i] = x[i].real();
+            im[i] = x[i].imag();
+        }
+        std::vector<double> axRe = matrix.multiplyVectorSparseMatrix(re);
+        std::vector<double> axIm = matrix.multiplyVectorSparseMatrix(im);
+        for (size_t i = 0; i < n; ++i)
+            EXPECT_NEAR(std::abs(std::complex<double>(axRe[i], axIm[i]) - result.values[k] * x[i]), 0.0, 1e-6);
+    }
+}
+
+// Тест для динамической матрицы: перезапись, удаление и объединенное чтение
+TEST(SparseMatrixTest, DynamicSparseMatrixUpdates) {
+    SparseMatrix<int> initial(3, 4);
+    initial.addValue(0, 1, 5);
+    initial.addValue(2, 3, 7);
+
+    DynamicSparseMatrix<int> matrix(initial);
+    matrix.setValue(0, 1, 6);
+    matrix.setValue(1, 2, 4);
+    matrix.removeValue(2, 3);
+    matrix.setValue(1, 2, 9);
+
+    EXPECT_EQ(matrix.getValue(0, 1), 6);
+    EXPECT_EQ(matrix.getValue(1, 2), 9);
+    EXPECT_EQ(matrix.getValue(2, 3), 0);
+    EXPECT_EQ(matrix.getNonZeroCount(), 2);
+    EXPECT_EQ(matrix.multiplyVectorDynamicSparseMatrix({ 1, 2, 3, 4 }), std::vector<int>({ 12, 27, 0 }));
+
+    matrix.flushDynamicSparseMatrix();
+    matrix.setValue(0, 1, 1);
+    EXPECT_EQ(matrix.getValue(0, 1), 1);
+
+    matrix.compactDynamicSparseMatrix();
+    EXPECT_EQ(matrix.getPendingCount(), 0);
+    EXPECT_EQ(matrix.getValue(0, 1), 1);
+    EXPECT_EQ(matrix.getValue(1, 2), 9);
+    EXPECT_EQ(matrix.getNonZeroCount(), 2);
+
+    EXPECT_THROW(matrix.setValue(3, 0, 1), std::out_of_range);
+    EXPECT_THROW(matrix.setValues({ 0 }, { 0, 1 }, { 1 }), std::invalid_argument);
+}
+
+// Тест для пакетной вставки с автоматическим уплотнением
+TEST(SparseMatrixTest, DynamicSparseMatrixBatchCompaction) {
+    const size_t n = 300;
+    DynamicSparseMatrix<double> matrix(n, n);
+    matrix.setCompactionPolicy(64, 0.1);
+
+    Matrix<double> expected(n, n);
+    for (size_t round = 0; round < 5; ++round) {
+        std::vector<size_t> rows, cols;
+        std::vector<double> values;
+        for (size_t i = 0; i < n; ++i) {
+            const size_t col = (i * 7 + round * 13) % n;
+            rows.push_back(i);
+            cols.push_back(col);
+            values.push_back(round % 2 == 0 ? 1.0 + round : 0.0);
+            expected(i, col) = values.back();
+        }
+        matrix.setValues(rows, cols, values);
+        EXPECT_LT(matrix.getPendingCount(), n);
+    }
+
+    EXPECT_EQ(matrix.toSparseMatrix().toDenseMatrix(), expected);
+    EXPECT_EQ(matrix.getNonZeroCount(), SparseMatrix<double>(expected).getNonZeroCount());
+
+    std::vector<double> x(n, 1.0);
+    EXPECT_EQ(matrix.multiplyVectorDynamicSparseMatrix(x), SparseMatrix<double>(expected).multiplyVectorSparseMatrix(x));
+}
+
+// Тест для формата DIA: SpMV и транспонированное SpMV на прямоугольной ленточной матрице
+TEST(SparseMatrixTest, DiagonalMatrixMultiplication) {
+    const size_t rows = 50;
+    const size_t cols = 40;
+    SparseMatrix<double> band(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        if (i < cols) band.addValue(i, i, 4.0 + i);
+        if (i >= 3 && i - 3 < cols) band.addValue(i, i - 3, -1.0);
+        if (i + 2 < cols) band.addValue(i, i + 2, 0.5 * i);
+    }
+
+    EXPECT_EQ(DiagonalMatrix<double>::countDiagonals(band), 3);
+    EXPECT_TRUE(DiagonalMatrix<double>::isSuitable(band));
+
+    DiagonalMatrix<double> dia(band);
+    EXPECT_EQ(dia.getDiagonalCount(), 3);
+    EXPECT_EQ(dia.getOffsets(), std::vector<std::ptrdiff_t>({ -3, 0, 2 }));
+    EXPECT_DOUBLE_EQ(dia.getValue(10, 12), 5.0);
+    EXPECT_DOUBLE_EQ(dia.getValue(10, 11), 0.0);
+
+    std::vector<double> x(cols), z(rows);
+    for (size_t j = 0; j < cols; ++j) x[j] = 1.0 + static_cast<double>(j % 5);
+    for (size_t i = 0; i < rows; ++i) z[i] = 2.0 - static_cast<double>(i % 7);
+
+    EXPECT_EQ(dia.multiplyVectorDiagonalMatrix(x), band.multiplyVectorSparseMatrix(x));
+    EXPECT_EQ(dia.multiplyTransposedVectorDiagonalMatrix(z), band.transposeSparseMatrix().multiplyVectorSparseMatrix(z));
+    EXPECT_EQ(dia.toSparseMatrix().toDenseMatrix(), band.toDenseMatrix());
+
+    Matrix<double> dense(cols, 3);
+    for (size_t j = 0; j < cols; ++j) dense(j, j % 3) = 1.0 + j;
+    EXPECT_EQ(dia * dense, band * dense);
+
+    dia.setValue(10, 12, 7.0);
+    EXPECT_DOUBLE_EQ(dia.getValue(10, 12), 7.0);
+    EXPECT_THROW(dia.setValue(10, 11, 1.0), std::invalid_argument);
+    EXPECT_THROW(dia.multiplyVectorDiagonalMatrix(z), std::invalid_argument);
+    EXPECT_THROW(DiagonalMatrix<double>(3, 3, { 0, 0 }), std::invalid_argument);
+    EXPECT_THROW(DiagonalMatrix<double>(3, 3, { 5 }), std::invalid_argument);
+}
+
+// Тест для симметричного хранения: однопроходное SpMV и проверка симметричности
+TEST(SparseMatrixTest, SymmetricSparseMatrixMultiplication) {
+    const size_t n = 5000;
+    SparseMatrix<double> full(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        full.addValue(i, i, 2.0 + static_cast<double>(i % 3));
+        for (size_t step : { 1, 17, 900 }) {
+            if (i + step >= n) continue;
+            const double value = -1.0 - static_cast<double>((i + step) % 4);
+            full.addValue(i, i + step, value);
+            full.addValue(i + step, i, value);
+        }
+    }
+
+    SymmetricSparseMatrix<double> symmetric(full);
+    EXPECT_EQ(symmetric.getNonZeroCount(), full.getNonZeroCount());
+    EXPECT_LT(symmetric.getStoredCount(), full.getNonZeroCount() / 2 + n);
+    EXPECT_DOUBLE_EQ(symmetric.getValue(917, 17), full.getValue(917, 17));
+
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<double>(i % 11) - 5.0;
+    EXPECT_EQ(symmetric.multiplyVectorSymmetricSparseMatrix(x), full.multiplyVectorSparseMatrix(x));
+    EXPECT_EQ(symmetric.toSparseMatrix().toCompressedRows().colIdx, full.toCompressedRows().colIdx);
+
+    SparseMatrix<double> skewed(3, 3);
+    skewed.addValue(0, 1, 1.0);
+    skewed.addValue(1, 0, 2.0);
+    EXPECT_THROW(SymmetricSparseMatrix<double>{ skewed }, std::invalid_argument);
+    EXPECT_THROW(SymmetricSparseMatrix<double>(SparseMatrix<double>(2, 3)), std::invalid_argument);
+}
+
+// Тест для загрузки файлов Matrix Market в общем и симметричном режимах
+TEST(SparseMatrixTest, MatrixMarketLoading) {
+    const std::string symmetricFile =
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "% comment\n"
+        "3 3 4\n"
+        "1 1 4.0\n"
+        "2 1 -1.5\n"
+        "3 2 2.0\n"
+        "3 3 1.0\n";
+
+    std::istringstream first(symmetricFile);
+    SymmetricSparseMatrix<double> symmetric = readMatrixMarketSymmetricSparseMatrix<double>(first);
+    EXPECT_EQ(symmetric.getStoredCount(), 4);
+    EXPECT_DOUBLE_EQ(symmetric.getValue(0, 1), -1.5);
+    EXPECT_DOUBLE_EQ(symmetric.getValue(1, 2), 2.0);
+
+    std::istringstream second(symmetricFile);
+    SparseMatrix<double> expanded = readMatrixMarketSparseMatrix<double>(second);
+    EXPECT_EQ(expanded.getNonZeroCount(), 6);
+    EXPECT_EQ(symmetric.multiplyVectorSymmetricSparseMatrix({ 1.0, 2.0, 3.0 }),
+              expanded.multiplyVectorSparseMatrix({ 1.0, 2.0, 3.0 }));
+
+    std::istringstream pattern("%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 1\n");
+    SparseMatrix<int> graph = readMatrixMarketSparseMatrix<int>(pattern);
+    EXPECT_EQ(graph.getValue(0, 2), 1);
+    EXPECT_EQ(graph.getValue(1, 0), 1);
+
+    std::istringstream general("%%MatrixMarket matrix coordinate real general\n2 2 1\n1 2 3.0\n");
+    EXPECT_THROW(readMatrixMarketSymmetricSparseMatrix<double>(general), std::invalid_argument);
+    std::istringstream broken("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n");
+    EXPECT_THROW(readMatrixMarketSparseMatrix<double>(broken), std::invalid_argument);
+    EXPECT_THROW(readMatrixMarketSparseMatrix<double>(std::string("/nonexistent/matrix.mtx")), std::runtime_error);
+}
+
+// Тест для структуры без значений: степени, булевы SpMV и SpGEMM
+TEST(SparseMatrixTest, PatternMatrixOperations) {
+    PatternMatrix graph(4, 4, { 0, 0, 1, 2, 0, 3 }, { 1, 2, 2, 3, 1, 0 });
+    EXPECT_EQ(graph.getNonZeroCount(), 5);
+    EXPECT_TRUE(graph.hasValue(0, 2));
+    EXPECT_FALSE(graph.hasValue(2, 0));
+    EXPECT_EQ(graph.getOutDegree(0), 2);
+    EXPECT_EQ(graph.outDegreesPatternMatrix(), std::vector<size_t>({ 2, 1, 1, 1 }));
+    EXPECT_EQ(graph.inDegreesPatternMatrix(), std::vector<size_t>({ 1, 1, 2, 1 }));
+
+    EXPECT_EQ(graph.multiplyVectorPatternMatrix({ 0, 0, 1, 0 }), std::vector<char>({ 1, 1, 0, 0 }));
+    EXPECT_EQ(graph.multiplyVectorPatternMatrix({ 0, 0, 1, 0 }, { 1, 0, 0, 0 }), std::vector<char>({ 0, 1, 0, 0 }));
+
+    SparseMatrix<int> weighted = graph.toSparseMatrix<int>();
+    PatternMatrix square = graph.multiplyPatternMatrix(graph);
+    EXPECT_EQ(square.toSparseMatrix<int>(), PatternMatrix(weighted.multiplySparseMatrix<OrAnd<int>>(weighted)).toSparseMatrix<int>());
+    EXPECT_TRUE(square.hasValue(0, 3));
+    EXPECT_TRUE(square.hasValue(3, 2));
+
+    EXPECT_EQ(PatternMatrix(weighted).transposePatternMatrix().toSparseMatrix<int>().toDenseMatrix(),
+              weighted.transposeSparseMatrix().toDenseMatrix());
+    EXPECT_THROW(graph.multiplyPatternMatrix(PatternMatrix(3, 3)), std::invalid_argument);
+    EXPECT_THROW(PatternMatrix(2, 2, { 0 }, { 2 }), std::out_of_range);
+}
+
+// Тест для поиска в ширину на структуре без значений
+TEST(SparseMatrixTest, PatternMatrixBreadthFirstSearch) {
+    const size_t n = 1000;
+    std::vector<size_t> from, to;
+    for (size_t v = 0; v + 1 < n / 2; ++v) {
+        from.push_back(v);
+        to.push_back(v + 1);
+    }
+    from.push_back(0);
+    to.push_back(n / 4);
+
+    PatternMatrix chain(n, n, from, to);
+    std::vector<size_t> levels = chain.breadthFirstSearchPatternMatrix(0);
+    EXPECT_EQ(levels[0], 0);
+    EXPECT_EQ(levels[1], 1);
+    EXPECT_EQ(levels[n / 4], 1);
+    EXPECT_EQ(levels[n / 4 + 3], 4);
+    EXPECT_EQ(levels[n / 2 - 1], n / 2 - 1 - n / 4 + 1);
+    EXPECT_EQ(levels[n / 2], std::numeric_limits<size_t>::max());
+    EXPECT_THROW(chain.breadthFirstSearchPatternMatrix(n), std::out_of_range);
+}
+
+// Тест для поиска в ширину с большим фронтом (уровни через маскированное SpMV)
+TEST(SparseMatrixTest, PatternMatrixBreadthFirstSearchWideFrontier) {
+    const size_t n = 1000, width = 200;
+    std::vector<size_t> from, to;
+    for (size_t v = 1; v <= width; ++v) {
+        from.push_back(0);
+        to.push_back(v);
+        from.push_back(v);
+        to.push_back(v + width);
+        from.push_back(v + width);
+        to.push_back(1);
+    }
+    from.push_back(2 * width);
+    to.push_back(2 * width + 1);
+
+    PatternMatrix star(n, n, from, to);
+    std::vector<size_t> levels = star.breadthFirstSearchPatternMatrix(0);
+    EXPECT_EQ(levels[0], 0);
+    EXPECT_EQ(levels[1], 1);
+    EXPECT_EQ(levels[width], 1);
+    EXPECT_EQ(levels[width + 1], 2);
+    EXPECT_EQ(levels[2 * width], 2);
+    EXPECT_EQ(levels[2 * width + 1], 3);
+    EXPECT_EQ(levels[2 * width + 2], std::numeric_limits<size_t>::max());
+}
+
+}
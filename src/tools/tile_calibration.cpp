@@ -0,0 +1,36 @@
+/**
+ * @file tile_calibration.cpp
+ * @brief Замер размеров плиток для всех поддерживаемых типов и запись профиля.
+ *
+ * Использование: tile_calibration [путь к профилю]
+ */
+
+#include <iostream>
+
+#include "../block_matrix/tile_autotuner.hpp"
+
+namespace {
+
+template <typename T>
+void calibrateType(const char* name) {
+    using matrix_lib::TileAutotuner;
+    using matrix_lib::TileOperation;
+
+    const matrix_lib::TileShape multiply = TileAutotuner::instance().calibrate<T>(TileOperation::Multiply);
+
+    std::cout << name << ": multiply " << multiply.rows << "x" << multiply.cols << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) matrix_lib::TileAutotuner::instance().setProfilePath(argv[1]);
+
+    calibrateType<float>("float");
+    calibrateType<double>("double");
+    calibrateType<int>("int");
+    calibrateType<long long>("long long");
+
+    std::cout << "Profile: " << matrix_lib::TileAutotuner::instance().getProfilePath() << "\n";
+    return 0;
+}